@@ -16,6 +16,7 @@
 #include <toymaker/builtins/interface_pointer_callback.hpp>
 
 #include "game_of_ur_data/house.hpp"
+#include "game_of_ur_data/ruleset.hpp"
 
 
 /**
@@ -107,7 +108,7 @@ private:
      * @brief The lengths of the 3 rows of the game board representing the number of valid houses on it.
      * 
      */
-    std::array<uint8_t, 3> mRowLengths {4, 12, 4};
+    std::array<uint8_t, 3> mRowLengths { kUrRuleset.mRowLengths };
 };
 
 #endif
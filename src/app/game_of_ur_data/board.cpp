@@ -1,53 +1,95 @@
-#include "piece_type.hpp"
+#include <utility>
+
+#include "ruleset.hpp"
 #include "board.hpp"
 
-std::weak_ptr<Piece> Board::move(RoleID player, std::weak_ptr<Piece> gamePiece, glm::u8vec2 toLocation, uint8_t roll) {
-    assert(!gamePiece.expired() && "game piece pointer must point to an existing object");
-    assert(canMove(player, *gamePiece.lock(), toLocation, roll) && "this move is invalid and should not have been attempted");
+const std::array<House, Board::kNHouses>& Board::getInitialGrid() {
+    static const std::array<House, kNHouses> initialGrid {
+        []<std::size_t... houseIndices>(std::index_sequence<houseIndices...>) {
+            const auto makeHouse = [](uint8_t houseIndex) {
+                // find the row and column of this house
+                const uint8_t x { static_cast<uint8_t>(houseIndex < kRowOffsets[1]? 0: houseIndex < kRowOffsets[2]? 1: 2) };
+                const glm::u8vec2 location { x, houseIndex - kRowOffsets[x] };
+
+                // the battlefield is shared, so either role's route describes it
+                const RoleID role { x == 2? RoleID::WHITE: RoleID::BLACK };
+                const RouteTable& route { kRouteTables[role] };
+                const uint8_t position { route.getRoutePosition(location) };
+                const glm::u8vec2 nextLocation { route.getLocation(position + 1) };
+
+                return House {
+                    glm::i8vec2 { nextLocation.x - location.x, nextLocation.y - location.y },
+                    RouteTable::isRosettePosition(position)? House::ROSETTE: House::REGULAR,
+                    x == 1? House::BATTLEFIELD: static_cast<House::Region>(role),
+                };
+            };
+            return std::array<House, kNHouses> { makeHouse(houseIndices)... };
+        }(std::make_index_sequence<kNHouses> {})
+    };
+    return initialGrid;
+}
 
-    std::shared_ptr<Piece> lockedGamePiece { gamePiece.lock() };
+PieceIdentity Board::move(RoleID player, Piece& gamePiece, glm::u8vec2 toLocation, uint8_t roll) {
+    assert(canMove(player, gamePiece, toLocation, roll) && "this move is invalid and should not have been attempted");
 
-    if(lockedGamePiece->getState() == Piece::State::ON_BOARD) {
+    if(gamePiece.getState() == Piece::State::ON_BOARD) {
         // disconnect this piece from its previous location
-        const glm::u8vec2 pieceLocation { lockedGamePiece->getLocation() };
-        mGrid[pieceLocation.x][pieceLocation.y].move(nullptr);
+        getHouse(gamePiece.getLocation()).vacate();
+        mOccupancy[gamePiece.getOwner()] &= ~(1u << getHouseIndex(gamePiece.getLocation()));
     }
 
     // associate the piece with its new location ...
-    lockedGamePiece->setLocation(toLocation);
+    gamePiece.setLocation(toLocation);
     if(isValidHouse(toLocation)) {
 
-        // ... taking care to remove the opponents piece previously occupying this house
-        std::weak_ptr<Piece> knockedOut { mGrid[toLocation.x][toLocation.y].getOccupantReference() };
-        if(std::shared_ptr opponentPiece = knockedOut.lock()) {
-            opponentPiece->setLocation(glm::u8vec2{0,0});
-        }
-
-        mGrid[toLocation.x][toLocation.y].move(lockedGamePiece);
+        // ... taking note of the opponent's piece previously occupying this house
+        House& destination { getHouse(toLocation) };
+        const PieceIdentity knockedOut { destination.getOccupant() };
+        destination.move(gamePiece);
+        mOccupancy[knockedOut.mOwner] &= ~(1u << getHouseIndex(toLocation));
+        mOccupancy[gamePiece.getOwner()] |= (1u << getHouseIndex(toLocation));
 
         return knockedOut;
     }
 
     // otherwise, this piece has successfully moved to the end of the route
-    return std::weak_ptr<Piece>{};
+    return PieceIdentity { .mType { PieceTypeID::SWALLOW }, .mOwner { RoleID::NA } };
 }
 
-std::weak_ptr<Piece> Board::getOccupantReference(glm::u8vec2 location) {
-    assert(isValidHouse(location) && "no house exists at the specified location");
-    return mGrid[location.x][location.y].getOccupantReference();
+void Board::undoMove(Piece& gamePiece, Piece::State fromState, glm::u8vec2 fromLocation, PieceIdentity displacedPiece) {
+    const glm::u8vec2 toLocation { gamePiece.getLocation() };
+
+    // return the destination house to its previous occupant, if it had one, ...
+    if(isValidHouse(toLocation)) {
+        assert(getHouse(toLocation).getOccupant() == gamePiece.getIdentity() && "The moved piece must still be at its destination");
+        House& destination { getHouse(toLocation) };
+        destination.vacate();
+        mOccupancy[gamePiece.getOwner()] &= ~(1u << getHouseIndex(toLocation));
+        if(displacedPiece.mOwner != RoleID::NA) {
+            destination.restoreOccupant(displacedPiece);
+            mOccupancy[displacedPiece.mOwner] |= (1u << getHouseIndex(toLocation));
+        }
+    }
+
+    // ... and the moved piece to its previous house, if it was on the board
+    gamePiece.setLocation(fromLocation);
+    if(fromState == Piece::State::ON_BOARD) {
+        getHouse(fromLocation).restoreOccupant(gamePiece.getIdentity());
+        mOccupancy[gamePiece.getOwner()] |= (1u << getHouseIndex(fromLocation));
+    }
 }
 
 bool Board::isValidHouse(glm::u8vec2 location) const {
     return (
-        location.x < mGrid.size() 
-        && location.y < mGrid[location.x].size()
+        location.x < kRowLengths.size() 
+        && location.y < kRowLengths[location.x]
     );
 }
 bool Board::isRosette(glm::u8vec2 location) const {
-    return isValidHouse(location) && mGrid[location.x][location.y].isRosette();
+    return isValidHouse(location) && getHouse(location).isRosette();
 }
 bool Board::isRouteEnd(glm::u8vec2 location) const {
-    return location.x == 1 && location.y == mGrid[1].size();
+    return location.x == 1 && location.y == kRowLengths[1];
 }
 
 bool Board::canMove(RoleID role, const Piece& gamePiece, glm::u8vec2 toLocation, uint8_t roll) const {
@@ -58,9 +100,8 @@ bool Board::canMove(RoleID role, const Piece& gamePiece, glm::u8vec2 toLocation,
     if(!gamePieceCanMove || !(isValidHouse(toLocation) || isRouteEnd(toLocation))) return false;
 
     const bool destinationAvailable {
-        (
-            isValidHouse(toLocation) && mGrid[toLocation.x][toLocation.y].canMove(gamePiece)
-        ) || (isRouteEnd(toLocation))
+        isRouteEnd(toLocation)
+        || ((getDestinationMask(gamePiece.getOwner()) >> getHouseIndex(toLocation)) & 1u)
     };
 
     const bool moveCorrespondsToDice {
@@ -79,131 +120,96 @@ bool Board::canMove(RoleID role, const Piece& gamePiece, glm::u8vec2 toLocation,
 
 bool Board::movePassesRosette(const Piece& gamePiece, glm::u8vec2 toLocation) const {
     if(gamePiece.getState() != Piece::State::ON_BOARD) return false;
-    glm::u8vec2 currentLocation { gamePiece.getLocation() };
-    assert(isValidHouse(currentLocation));
-
-    currentLocation += mGrid[currentLocation.x][currentLocation.y].getNextCellDirection();
-    while(isValidHouse(currentLocation) && currentLocation != toLocation) {
-        if(
-            currentLocation != toLocation &&
-            mGrid[currentLocation.x][currentLocation.y].isRosette()
-        ) return true;
-
-        currentLocation += mGrid[currentLocation.x][currentLocation.y].getNextCellDirection();
+    const RouteTable& route { kRouteTables[gamePiece.getOwner()] };
+    const uint8_t fromPosition { route.getRoutePosition(gamePiece.getLocation()) };
+    assert(fromPosition < RouteTable::kRouteEnd && "A piece on the board must lie on its own route");
+
+    // a destination that isn't ahead of the piece will never be reached, meaning
+    // every house up to the end of the route is passed over
+    uint8_t toPosition { route.getRoutePosition(toLocation) };
+    if(toPosition == RouteTable::kOffRoute || toPosition <= fromPosition) {
+        toPosition = RouteTable::kRouteEnd;
     }
 
-    return false;
+    return route.getStep(fromPosition, toPosition - fromPosition).mFlags & RouteTable::Step::PASSES_ROSETTE;
 }
 
 bool Board::moveDisplacesOpponent(RoleID role, const Piece& gamePiece, glm::u8vec2 toLocation, uint8_t roll) const {
     return (
         canMove(role, gamePiece, toLocation, roll) 
         && isValidHouse(toLocation)
-        && mGrid[toLocation.x][toLocation.y].isOccupied()
+        && ((getOccupancyMask(RoleID::NA) >> getHouseIndex(toLocation)) & 1u)
     );
 }
 
 glm::u8vec2 Board::computeMoveLocation(const Piece& gamePiece, uint8_t roll) const {
-    assert(gamePiece.getState() == Piece::State::ON_BOARD && "moves may only be computed for pieces that are on the board");
-
-    glm::u8vec2 currentLocation { gamePiece.getLocation() };
-    for(
-        // counter
-        House house{ mGrid[currentLocation.x][currentLocation.y] }; 
-
-        // condition
-        roll > 0 && currentLocation.x < mGrid.size() && currentLocation.y < mGrid[currentLocation.x].size();
-
-        // step
-        roll--, currentLocation += house.getNextCellDirection()
-    ) {
-        house = mGrid[currentLocation.x][currentLocation.y];
-    }
+    const RouteTable::Step& step { getRouteStep(gamePiece, roll) };
 
     // If it's a move that takes the piece off the board, but not exactly, the move
     // fails, and we return the piece's current location
-    if(roll) return gamePiece.getLocation();
+    if(!(step.mFlags & RouteTable::Step::IS_POSSIBLE)) return gamePiece.getLocation();
 
     // otherwise return the computed location
-    return currentLocation;
+    return kRouteTables[gamePiece.getOwner()].getLocation(step.mDestination);
+}
+
+const RouteTable::Step& Board::getRouteStep(const Piece& gamePiece, uint8_t roll) const {
+    assert(gamePiece.getState() == Piece::State::ON_BOARD && "moves may only be computed for pieces that are on the board");
+
+    const RouteTable& route { kRouteTables[gamePiece.getOwner()] };
+    const uint8_t fromPosition { route.getRoutePosition(gamePiece.getLocation()) };
+    assert(fromPosition < RouteTable::kRouteEnd && "A piece on the board must lie on its own route");
+    return route.getStep(fromPosition, roll);
 }
 
 bool Board::isValidLaunchHouse(glm::u8vec2 location, const Piece& gamePiece) const {
-    const PieceType& pieceType { kGamePieceTypes[gamePiece.getType()] };
-    return (
-        (
-            pieceType.mLaunchType == PieceType::ONE_BEFORE_ROSETTE
-            && (
-                location.x < mGrid.size()
-                && (
-                    (
-                        location.x == 1 
-                        && location.y < mGrid[1].size() 
-                        && location.y % 4 == 2
-                    ) || (
-                        location.y == 1
-                        && mGrid[location.x][0].getRegion() == static_cast<House::Region>(gamePiece.getOwner())
-                    )
-                )
-            )
-        ) || (
-            location 
-            == getLaunchPosition(gamePiece.getIdentity().mType)
-        )
-    );
+    const RouteTable& route { kRouteTables[gamePiece.getOwner()] };
+    return route.isLaunchPosition(route.getRoutePosition(location), gamePiece.getType());
 }
 
 bool Board::houseIsOccupied(glm::u8vec2 location) const {
     return (
         isValidHouse(location)
-        && mGrid[location.x][location.y].isOccupied()
+        && ((getOccupancyMask(RoleID::NA) >> getHouseIndex(location)) & 1u)
     );
 }
 
 House::Type Board::getType(glm::u8vec2 location) const {
     assert(isValidHouse(location) && "This location does not correspond to a valid house on this board");
-    return mGrid[location.x][location.y].getType();
+    return getHouse(location).getType();
 }
 
 House::Region Board::getRegion(glm::u8vec2 location) const {
     assert(isValidHouse(location) && "This location does not correspond to a valid house on this board");
-    return mGrid[location.x][location.y].getRegion();
+    return getHouse(location).getRegion();
 }
 
 PieceIdentity Board::getOccupant(glm::u8vec2 location) const {
     assert(isValidHouse(location) && "This location does not correspond to a valid house on this board");
-    return mGrid[location.x][location.y].getOccupant();
+    return getHouse(location).getOccupant();
 }
 
 std::vector<glm::u8vec2> Board::getLaunchPositions(PieceIdentity pieceIdentity) const {
     assert(pieceIdentity.mOwner != RoleID::NA && "Each piece must have a corresponding player role");
 
+    const RouteTable& route { kRouteTables[pieceIdentity.mOwner] };
     std::vector<glm::u8vec2> results {};
-    switch(kGamePieceTypes[pieceIdentity.mType].mLaunchType) {
-        case PieceType::ONE_BEFORE_ROSETTE:
-            results.push_back({
-                mGrid[0][0].getRegion() == static_cast<House::Region>(pieceIdentity.mOwner)? 0: 2,
-                1
-            });
-            for(uint8_t y { 2 }; y < mGrid[1].size(); y+=4) {
-                results.push_back({1, y});
-            }
-            break;
-
-        default:
-            results.push_back(getLaunchPosition(pieceIdentity.mType));
-            break;
-    };
+    for(uint8_t position { 0 }; position < RouteTable::kRouteEnd; ++position) {
+        if(route.isLaunchPosition(position, pieceIdentity.mType)) {
+            results.push_back(route.getLocation(position));
+        }
+    }
 
     return results;
 }
 
 glm::i8vec2 Board::getNextCellDirection(glm::u8vec2 location) const {
     assert(isValidHouse(location) && "This location does not correspond to a valid house on this board");
-    return mGrid[location.x][location.y].getNextCellDirection();
+    return getHouse(location).getNextCellDirection();
 }
 
-glm::u8vec2 Board::getLaunchPosition(PieceTypeID pieceType) const {
-    assert(kGamePieceTypes[pieceType].mLaunchType == PieceType::LaunchType::SAME_AS_LAUNCH_ROLL && "This must be a piece whose launch roll corresponds to its launch house");
-    return { 1, static_cast<uint8_t>(kGamePieceTypes[pieceType].mLaunchRoll) - 5 };
+void Board::place(const Piece& gamePiece) {
+    assert(isValidHouse(gamePiece.getLocation()) && !houseIsOccupied(gamePiece.getLocation()) && "A piece may only be placed in an empty house");
+    getHouse(gamePiece.getLocation()).restoreOccupant(gamePiece.getIdentity());
+    mOccupancy[gamePiece.getOwner()] |= (1u << getHouseIndex(gamePiece.getLocation()));
 }
@@ -12,12 +12,15 @@
 #ifndef ZOAPPBOARD_H
 #define ZOAPPBOARD_H
 
+#include <cstdint>
 #include <vector>
 #include <array>
+#include <cassert>
 
 #include <glm/glm.hpp>
 
 #include "house.hpp"
+#include "route.hpp"
 
 /**
  * @ingroup UrGameDataModel
@@ -32,24 +35,39 @@ public:
     /**
      * @brief Applies a move after validating it.
      * 
+     * Only the moved piece's location is updated here.  Updating the state of the moved piece, and the state and location of the piece knocked off the board (if any), is left to the caller, who owns both pieces.
+     * 
      * @param role The role (black or white) initiating the move.
      * @param gamePiece The game piece to be moved.
      * @param toLocation The target location for the game piece.
      * @param roll The dice score.
      * 
-     * @return std::weak_ptr<Piece> A reference to the piece moved.
+     * @return PieceIdentity The identity of the opponent piece knocked off the board by this move, with an owner of RoleID::NA if there wasn't one.
      * 
      * @see canMove()
      */
-    std::weak_ptr<Piece> move(RoleID role, std::weak_ptr<Piece> gamePiece, glm::u8vec2 toLocation, uint8_t roll);
+    PieceIdentity move(RoleID role, Piece& gamePiece, glm::u8vec2 toLocation, uint8_t roll);
+
+    /**
+     * @brief Reverts a move previously applied with move(), returning the moved piece to its former location and any displaced piece to the moved piece's destination.
+     * 
+     * As with move(), updating the states of the pieces involved is left to the caller.
+     * 
+     * @param gamePiece The piece that was moved, which must still be at its destination.
+     * @param fromState The state of the moved piece before it was moved.
+     * @param fromLocation The location of the moved piece before it was moved.
+     * @param displacedPiece The identity of the piece move() reported as knocked off the board, if any.
+     */
+    void undoMove(Piece& gamePiece, Piece::State fromState, glm::u8vec2 fromLocation, PieceIdentity displacedPiece);
 
     /**
-     * @brief Fetches a reference to the piece currently occupying a house pointed to by `location`.
+     * @brief Puts a piece on the board at the location it already holds, without it having been moved there by a roll, as when a saved game is being restored.
+     * 
+     * @warning The piece's house must be a valid, unoccupied one.
      * 
-     * @param location The location of the house whose occupant we want to get.
-     * @return std::weak_ptr<Piece> A reference to the occupying game piece, if any.
+     * @param gamePiece The piece to be placed, whose state and location have already been set.
      */
-    std::weak_ptr<Piece> getOccupantReference(glm::u8vec2 location);
+    void place(const Piece& gamePiece);
 
     /**
      * @brief Tests whether a given move is possible, per the state of the board.
@@ -78,7 +96,7 @@ public:
      * It determines this by:
      * 
      * - Checking the status of the piece.  Pieces not on the board fail the test.
-     * - Stepping through the houses the piece will pass over.  If one is a rosette house and NOT the destination house, the condition succeeds.
+     * - Looking up the move in the piece owner's RouteTable, which records whether a rosette lies between the piece and the destination house.  A destination that doesn't lie ahead of the piece on its route is treated as the end of the route.
      * 
      * @param gamePiece The piece being moved.
      * @param toLocation The location of the destination house.
@@ -202,51 +220,173 @@ public:
      * 
      * @param gamePiece The piece present on the board potentially being made to move.
      * @param roll The roll with which to make the piece move.
-     * @return glm::u8vec2 The destination location corresponding to the roll.
+     * @return glm::u8vec2 The destination location corresponding to the roll, or the piece's current location if the roll would overshoot the end of the route.
      */
     glm::u8vec2 computeMoveLocation(const Piece& gamePiece, uint8_t roll) const;
+
+    /**
+     * @brief Gets the precomputed outcome of moving a game piece present on the board forward by a dice roll.
+     * 
+     * @param gamePiece The piece present on the board potentially being made to move.
+     * @param roll The roll with which to make the piece move.
+     * @return const RouteTable::Step& The destination and flags describing the move.
+     */
+    const RouteTable::Step& getRouteStep(const Piece& gamePiece, uint8_t roll) const;
+
+    /**
+     * @brief The number of houses on the board.
+     * 
+     */
+    static constexpr uint8_t kNHouses { kUrRuleset.getNHouses() };
+
+    /**
+     * @brief Gets the index of the house at a (valid) board location, numbering houses row after row from 0 to kNHouses - 1.
+     * 
+     * @param location The location of the house.
+     * @return uint8_t The index of the house.
+     */
+    static constexpr uint8_t getHouseIndex(glm::u8vec2 location) {
+        assert(location.x < kRowLengths.size() && location.y < kRowLengths[location.x] && "This location does not correspond to a valid house on this board");
+        return kRowOffsets[location.x] + location.y;
+    }
+
+    /**
+     * @brief Gets the mask of houses occupied by the pieces of a role, where bit N corresponds to the house with index N.
+     * 
+     * @param role The role whose pieces are considered, or RoleID::NA for the pieces of either role.
+     * @return uint32_t The occupancy mask for this role.
+     * 
+     * @see getHouseIndex()
+     */
+    uint32_t getOccupancyMask(RoleID role) const {
+        return role == RoleID::NA? (mOccupancy[RoleID::BLACK] | mOccupancy[RoleID::WHITE]): mOccupancy[role];
+    }
+
+    /**
+     * @brief Gets the mask of houses a piece belonging to a role may presently move into, i.e., those it can reach that aren't held by another of its own pieces or guarded by an opponent on a rosette.
+     * 
+     * @param role The role of the piece being moved.
+     * @return uint32_t The mask of available destination houses.
+     */
+    uint32_t getDestinationMask(RoleID role) const {
+        assert(role != RoleID::NA && "Only pieces belonging to a role may be moved");
+        const RoleID opponent { role == RoleID::BLACK? RoleID::WHITE: RoleID::BLACK };
+        return (
+            (kRegionMasks[House::Region::BATTLEFIELD] | kRegionMasks[role])
+            & ~mOccupancy[role]
+            & ~(mOccupancy[opponent] & kRosetteMask)
+        );
+    }
+
+    /**
+     * @brief Gets the mask of houses belonging to a region of the board.
+     * 
+     * @param region The region of the board.
+     * @return uint32_t The mask of houses in that region.
+     */
+    static constexpr uint32_t getRegionMask(House::Region region) { return kRegionMasks[region]; }
+
+    /**
+     * @brief Gets the mask of every rosette house on the board.
+     * 
+     * @return uint32_t The mask of rosette houses.
+     */
+    static constexpr uint32_t getRosetteMask() { return kRosetteMask; }
 private:
+    /**
+     * @brief The number of houses present in each row (i.e., each value of a location's x component) of the board.
+     * 
+     */
+    static constexpr std::array<uint8_t, 3> kRowLengths { kUrRuleset.mRowLengths };
 
     /**
-     * @brief A list of vectors, where each element in a vector corresponds to one house on the board.
-     * 
-     */
-    std::array<std::vector<House>, 3> mGrid {{
-        {
-            House{{1, 0}, House::ROSETTE, House::BLACK},
-            House{{0, -1}, House::REGULAR, House::BLACK},
-            House{{0, -1}, House::REGULAR, House::BLACK},
-            House{{0, -1}, House::REGULAR, House::BLACK},
-        },
-        {
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::ROSETTE, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::ROSETTE, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::REGULAR, House::BATTLEFIELD},
-            House{{0, 1}, House::ROSETTE, House::BATTLEFIELD},
-        },
-        {
-            House{{-1, 0}, House::ROSETTE, House::WHITE},
-            House{{0, -1}, House::REGULAR, House::WHITE},
-            House{{0, -1}, House::REGULAR, House::WHITE},
-            House{{0, -1}, House::REGULAR, House::WHITE},
-        },
+     * @brief The index in mGrid of the first house of each row of the board.
+     * 
+     */
+    static constexpr std::array<uint8_t, 3> kRowOffsets {{
+        0,
+        kRowLengths[0],
+        static_cast<uint8_t>(kRowLengths[0] + kRowLengths[1]),
     }};
 
     /**
-     * @brief Given a (non-swallow) piece type, gets the location of its launch house.
+     * @brief The mask of every rosette house on the board, built from the routes both roles follow.
+     * 
+     */
+    static constexpr uint32_t kRosetteMask {
+        [] {
+            uint32_t mask { 0 };
+            for(const RoleID role: { RoleID::BLACK, RoleID::WHITE }) {
+                for(uint8_t position { 0 }; position < RouteTable::kRouteEnd; ++position) {
+                    if(!RouteTable::isRosettePosition(position)) continue;
+                    const glm::u8vec2 location { kRouteTables[role].getLocation(position) };
+                    mask |= 1u << (kRowOffsets[location.x] + location.y);
+                }
+            }
+            return mask;
+        }()
+    };
+
+    /**
+     * @brief The mask of houses in each region of the board, indexed by House::Region, built from the routes both roles follow.
+     * 
+     * Each role's first few route positions lie in its own region, and the rest lie on the battlefield.
+     * 
+     */
+    static constexpr std::array<uint32_t, 3> kRegionMasks {
+        [] {
+            std::array<uint32_t, 3> masks {};
+            for(const RoleID role: { RoleID::BLACK, RoleID::WHITE }) {
+                for(uint8_t position { 0 }; position < RouteTable::kRouteEnd; ++position) {
+                    const glm::u8vec2 location { kRouteTables[role].getLocation(position) };
+                    masks[position < kUrRuleset.getRegionLength()? static_cast<House::Region>(role): House::Region::BATTLEFIELD] |= (
+                        1u << (kRowOffsets[location.x] + location.y)
+                    );
+                }
+            }
+            return masks;
+        }()
+    };
+
+    /**
+     * @brief Masks of the houses occupied by each role's pieces, indexed by RoleID, kept in step with the occupants of mGrid.
+     * 
+     */
+    std::array<uint32_t, 3> mOccupancy {};
+
+    /**
+     * @brief Every house on the board, stored row after row, where a house's index is given by its location through getHouseIndex().
+     * 
+     * Houses are held in a fixed-size array so that a Board (and the GameOfUrModel containing it) may be copied trivially.
+     * 
+     * @see getInitialGrid()
+     */
+    std::array<House, kNHouses> mGrid { getInitialGrid() };
+
+    /**
+     * @brief Gets the houses of an empty board, laid out along the routes described by kRouteTables.
+     * 
+     * Every house takes its type from its position along the routes passing through it, its region from its row, and the direction to its next house from the route's next position.
+     * 
+     * @return const std::array<House, kNHouses>& The houses of an empty board, stored row after row.
+     */
+    static const std::array<House, kNHouses>& getInitialGrid();
+
+    /**
+     * @brief Gets the house at a (valid) board location.
      * 
-     * @param pieceType The type of the piece whose launch position is being retrieved.
-     * @return glm::u8vec2 The piece's launch position.
+     * @param location The location of the house.
+     * @return const House& The house at that location.
+     */
+    const House& getHouse(glm::u8vec2 location) const { return mGrid[getHouseIndex(location)]; }
+
+    /**
+     * @brief Gets the house at a (valid) board location.
+     * 
+     * @param location The location of the house.
+     * @return House& The house at that location.
      */
-    glm::u8vec2 getLaunchPosition(PieceTypeID pieceType) const;
+    House& getHouse(glm::u8vec2 location) { return mGrid[getHouseIndex(location)]; }
 };
 
 #endif
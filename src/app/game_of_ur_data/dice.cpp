@@ -5,19 +5,23 @@
 void Dice::reset() { mState = State::UNROLLED; }
 
 uint8_t Dice::getResult(GamePhase currentPhase) const {
+    return getResult(mState, mPrimaryRoll, mSecondaryRoll, currentPhase);
+}
+
+uint8_t Dice::getResult(State state, uint8_t primaryRoll, bool secondaryRoll, GamePhase currentPhase) {
     switch(currentPhase) {
         case GamePhase::INITIATIVE:
-            if(mState == State::SECONDARY_ROLLED) {
-                return mSecondaryRoll? upgradedRoll(): mPrimaryRoll;
+            if(state == State::SECONDARY_ROLLED) {
+                return secondaryRoll? upgradedRoll(primaryRoll): primaryRoll;
             }
-            return mPrimaryRoll;
+            return primaryRoll;
 
         case GamePhase::PLAY:
-            if(mState == State::UNROLLED) return 0;
-            if(mState == State::SECONDARY_ROLLED) {
-                return mSecondaryRoll? upgradedRoll(): 0;
+            if(state == State::UNROLLED) return 0;
+            if(state == State::SECONDARY_ROLLED) {
+                return secondaryRoll? upgradedRoll(primaryRoll): 0;
             }
-            return mPrimaryRoll;
+            return primaryRoll;
 
         case GamePhase::END:
             return 0;
@@ -29,11 +33,11 @@ uint8_t Dice::getResult(GamePhase currentPhase) const {
 void Dice::roll() {
     switch(mState) {
         case State::UNROLLED:
-            mPrimaryRoll = mPrimaryDieDistribution(mRandomEngine);
+            mPrimaryRoll = 1 + static_cast<uint8_t>(mRandomEngine() >> 62);
             mState = State::PRIMARY_ROLLED;
             break;
         case State::PRIMARY_ROLLED:
-            mSecondaryRoll = mYesNoDieDistribution(mRandomEngine);
+            mSecondaryRoll = (mRandomEngine() >> 63) != 0;
             mState = State::SECONDARY_ROLLED;
             break;
         case State::SECONDARY_ROLLED:
@@ -41,7 +45,58 @@ void Dice::roll() {
     }
 }
 
-uint8_t Dice::upgradedRoll() const {
-    if(mPrimaryRoll == 4) return 10;
-    return mPrimaryRoll + 4;
+Dice::OutcomeList Dice::getOutcomes(GamePhase currentPhase) const {
+    OutcomeList outcomes {};
+    switch(mState) {
+        case State::UNROLLED:
+            // the secondary die is left showing whatever it was before
+            for(uint8_t primaryRoll { 1 }; primaryRoll <= 4; ++primaryRoll) {
+                outcomes.push_back({
+                    .mState { State::PRIMARY_ROLLED },
+                    .mPrimaryRoll { primaryRoll },
+                    .mSecondaryRoll { mSecondaryRoll },
+                    .mResultScore { getResult(State::PRIMARY_ROLLED, primaryRoll, mSecondaryRoll, currentPhase) },
+                    .mProbability { 0.25 },
+                });
+            }
+            break;
+
+        case State::PRIMARY_ROLLED:
+            for(const bool secondaryRoll: { false, true }) {
+                outcomes.push_back({
+                    .mState { State::SECONDARY_ROLLED },
+                    .mPrimaryRoll { mPrimaryRoll },
+                    .mSecondaryRoll { secondaryRoll },
+                    .mResultScore { getResult(State::SECONDARY_ROLLED, mPrimaryRoll, secondaryRoll, currentPhase) },
+                    .mProbability { 0.5 },
+                });
+            }
+            break;
+
+        case State::SECONDARY_ROLLED:
+            break;
+    }
+    return outcomes;
+}
+
+void Dice::force(const Outcome& outcome) {
+    assert(
+        (
+            (mState == State::UNROLLED && outcome.mState == State::PRIMARY_ROLLED && outcome.mSecondaryRoll == mSecondaryRoll)
+            || (mState == State::PRIMARY_ROLLED && outcome.mState == State::SECONDARY_ROLLED && outcome.mPrimaryRoll == mPrimaryRoll)
+        ) && "This outcome cannot be reached by rolling the dice from their current state"
+    );
+    restore(outcome.mState, outcome.mPrimaryRoll, outcome.mSecondaryRoll);
+}
+
+void Dice::restore(State state, uint8_t primaryRoll, bool secondaryRoll) {
+    assert(primaryRoll >= 1 && primaryRoll <= 4 && "The primary die only has faces 1 through 4");
+    mState = state;
+    mPrimaryRoll = primaryRoll;
+    mSecondaryRoll = secondaryRoll;
+}
+
+uint8_t Dice::upgradedRoll(uint8_t primaryRoll) {
+    if(primaryRoll == 4) return 10;
+    return primaryRoll + 4;
 }
@@ -13,9 +13,11 @@
 #define ZOAPPDICE_H
 
 #include <cstdint>
-#include <random>
+#include <cassert>
+#include <array>
 
 #include "phase.hpp"
+#include "random_engine.hpp"
 
 /**
  * @ingroup UrGameDataModel
@@ -30,12 +32,152 @@ public:
      * @brief Values representing all possible states for this pair of dice.
      * 
      */
-    enum State {
+    enum State: uint8_t {
         UNROLLED, //< The dice have not yet been rolled.
         PRIMARY_ROLLED, //< Only the first of the dice, the one producing its primary roll, has been rolled.
         SECONDARY_ROLLED, //< Both dice have been rolled (and no further rolls are permitted)
     };
 
+    /**
+     * @brief One of the ways the next roll of the dice may turn out, along with its probability.
+     * 
+     */
+    struct Outcome {
+        /**
+         * @brief The state the dice are in after the roll.
+         * 
+         */
+        State mState;
+
+        /**
+         * @brief The value shown by the primary die after the roll.
+         * 
+         */
+        uint8_t mPrimaryRoll;
+
+        /**
+         * @brief The value shown by the secondary die after the roll.
+         * 
+         */
+        bool mSecondaryRoll;
+
+        /**
+         * @brief The result score the dice produce after the roll, in the game phase the outcome was listed for.
+         * 
+         * @see getResult()
+         */
+        uint8_t mResultScore;
+
+        /**
+         * @brief The probability of the roll turning out this way, which is exact, being a power of one half.
+         * 
+         */
+        double mProbability;
+    };
+
+    /**
+     * @brief A list of every outcome of a single roll of the dice, whose probabilities sum to 1.
+     * 
+     */
+    class OutcomeList {
+    public:
+        /**
+         * @brief The largest number of outcomes a single roll may have, the number of faces on the primary die.
+         * 
+         */
+        static constexpr uint8_t kCapacity { 4 };
+
+        /**
+         * @brief Adds an outcome to the end of this list.
+         * 
+         * @param outcome The outcome being added.
+         */
+        void push_back(const Outcome& outcome) {
+            assert(mSize < kCapacity && "A single roll has no more than 4 outcomes");
+            mOutcomes[mSize++] = outcome;
+        }
+
+        /**
+         * @brief Gets the number of outcomes in this list.
+         * 
+         * @return std::size_t The number of outcomes in this list.
+         */
+        std::size_t size() const { return mSize; }
+
+        /**
+         * @brief Tests whether this list holds no outcomes, as when the dice can't be rolled.
+         * 
+         * @retval true There are no outcomes in this list.
+         * @retval false There is at least one outcome in this list.
+         */
+        bool empty() const { return mSize == 0; }
+
+        /**
+         * @brief Gets an outcome in this list.
+         * 
+         * @param index The position of the outcome in this list.
+         * @return const Outcome& The outcome at that position.
+         */
+        const Outcome& operator[](std::size_t index) const {
+            assert(index < mSize && "Outcome index out of range");
+            return mOutcomes[index];
+        }
+
+        /**
+         * @brief Gets an iterator to the first outcome in this list.
+         * 
+         * @return const Outcome* The first outcome in this list.
+         */
+        const Outcome* begin() const { return mOutcomes.data(); }
+
+        /**
+         * @brief Gets an iterator to one past the last outcome in this list.
+         * 
+         * @return const Outcome* One past the last outcome in this list.
+         */
+        const Outcome* end() const { return mOutcomes.data() + mSize; }
+
+    private:
+        /**
+         * @brief Storage for the outcomes in this list, of which only the first mSize are meaningful.
+         * 
+         */
+        std::array<Outcome, kCapacity> mOutcomes {};
+
+        /**
+         * @brief The number of outcomes in this list.
+         * 
+         */
+        uint8_t mSize { 0 };
+    };
+
+    /**
+     * @brief Constructs a pair of dice drawing on a fresh stream of the process-wide random engine.
+     * 
+     */
+    Dice(): Dice{ RandomEngine::fromProcessSeed() } {}
+
+    /**
+     * @brief Constructs a pair of dice drawing on a given random engine, so that its rolls may be reproduced.
+     * 
+     * @param randomEngine The engine from which the dice draw their rolls.
+     */
+    explicit Dice(RandomEngine randomEngine): mRandomEngine { randomEngine } {}
+
+    /**
+     * @brief Replaces the engine from which the dice draw their rolls.
+     * 
+     * @param randomEngine The new random engine.
+     */
+    inline void setRandomEngine(RandomEngine randomEngine) { mRandomEngine = randomEngine; }
+
+    /**
+     * @brief Gets the engine from which the dice draw their rolls, in its current state.
+     * 
+     * @return const RandomEngine& The dice's random engine.
+     */
+    inline const RandomEngine& getRandomEngine() const { return mRandomEngine; }
+
     /**
      * @brief Resets the state of the dice to State::UNROLLED.
      * 
@@ -50,6 +192,36 @@ public:
      */
     void roll();
 
+    /**
+     * @brief Lists every way the next roll of the dice may turn out, without rolling them.
+     * 
+     * Rolling from State::UNROLLED turns up one of the primary die's 4 faces, and rolling from State::PRIMARY_ROLLED turns up either side of the secondary die, each with equal probability.
+     * 
+     * @param currentPhase The game phase in which the outcomes' result scores are computed.
+     * @return OutcomeList Every outcome of the next roll, or none if the dice can't be rolled.
+     */
+    OutcomeList getOutcomes(GamePhase currentPhase) const;
+
+    /**
+     * @brief Rolls one of the dice, as roll() does, but with a chosen outcome instead of a random one.
+     * 
+     * The random engine is left untouched.
+     * 
+     * @param outcome One of the outcomes listed by getOutcomes() for the dice's current state.
+     */
+    void force(const Outcome& outcome);
+
+    /**
+     * @brief Returns the dice to a state they were in previously, without rolling them.
+     * 
+     * Only the dice's faces and state are restored; the random engine carries on from wherever it is.
+     * 
+     * @param state The state the dice were in.
+     * @param primaryRoll The value shown by the primary die, between 1 and 4.
+     * @param secondaryRoll The value shown by the secondary die, where true -> Double, false -> Quits.
+     */
+    void restore(State state, uint8_t primaryRoll, bool secondaryRoll);
+
     /**
      * @brief Tests whether rolling the dice is presently possible.
      * 
@@ -115,14 +287,28 @@ public:
     uint8_t getResult(GamePhase currentPhase) const;
 
 private:
+    /**
+     * @brief Gets the score represented by dice in some state showing some faces, for the current phase of the game.
+     * 
+     * @param state The state of the dice.
+     * @param primaryRoll The value shown by the primary die.
+     * @param secondaryRoll The value shown by the secondary die.
+     * @param currentPhase The current phase of the game.
+     * @return uint8_t The dice score based on game and dice state.
+     * 
+     * @see getResult(GamePhase) const
+     */
+    static uint8_t getResult(State state, uint8_t primaryRoll, bool secondaryRoll, GamePhase currentPhase);
+
     /**
      * @brief Maps the score of the primary die to its result score if one rolled Double with the secondary die.
      * 
-     * @return uint8_t The upgraded value of the current primary die roll.
+     * @param primaryRoll The value shown by the primary die.
+     * @return uint8_t The upgraded value of the primary die roll.
      * 
      * @see getResult()
      */
-    uint8_t upgradedRoll() const;
+    static uint8_t upgradedRoll(uint8_t primaryRoll);
 
     /**
      * @brief The score on the primary die, a value between 1 and 4.
@@ -143,28 +329,12 @@ private:
     State mState { UNROLLED };
 
     /**
-     * @brief The device used as the source of random values.
+     * @brief The engine used to produce random values.
      * 
-     */
-    std::random_device mRandomDevice {};
-
-    /**
-     * @brief The engine used to produce random values (I don't really know).
-     * 
-     */
-    std::default_random_engine mRandomEngine { mRandomDevice() };
-
-    /**
-     * @brief A meaningful range of integer values used by the primary die, where each value has an even chance of being drawn.
-     * 
-     */
-    std::uniform_int_distribution<int> mPrimaryDieDistribution { 1, 4 };
-
-    /**
-     * @brief The range of integer values possible for the secondary die, where each integer has an even chance of being drawn.
+     * Each roll takes the top bits of a single draw, which are equally likely to take any value, so that rolls don't depend on any standard library's distributions.
      * 
      */
-    std::uniform_int_distribution<int> mYesNoDieDistribution { 0, 1 };
+    RandomEngine mRandomEngine;
 };
 
 
@@ -0,0 +1,275 @@
+#include "ruleset.hpp"
+#include "differential_check.hpp"
+
+DifferentialReport DifferentialCheck::runBatch(uint64_t nGames, uint64_t firstSeed, GameBatch::Kernel kernel) {
+    // the reference reaches the start of the play phase, where every game of
+    // a batch starts, with player A outrolling player B for initiative
+    GameOfUrModel start {};
+    std::vector<GameEvent> startActions {};
+    for(const auto& [primaryRoll, secondaryRoll]: { std::pair { 4, true }, std::pair { 1, false } }) {
+        const PlayerID player { start.getCurrentPhase().mTurn };
+        for(const uint8_t outcome: { static_cast<uint8_t>(primaryRoll - 1), static_cast<uint8_t>(secondaryRoll) }) {
+            startActions.push_back(makeRollAction(player, start.getDiceRollOutcomes()[outcome]));
+            apply(start, startActions.back());
+        }
+        if(start.canAdvanceOneTurn(player)) {
+            startActions.push_back(makeTurnAction(player));
+            apply(start, startActions.back());
+        }
+    }
+    startActions.push_back(makeTurnAction(start.getCurrentPhase().mTurn));
+    apply(start, startActions.back());
+
+    GameBatch batch { nGames, RandomEngine { firstSeed } };
+    std::vector<GameOfUrModel> references(nGames, start);
+    std::vector<std::vector<GameEvent>> actions(nGames, startActions);
+    std::vector<bool> isFinished(nGames, false);
+    DifferentialReport report { .mNGames { 0 }, .mNActions { 0 }, .mDivergence {} };
+
+    // games after the earliest one found to diverge no longer matter, and are
+    // left to play on unchecked
+    uint64_t divergentGame { nGames };
+    const auto diverge = [&](uint64_t game, std::string description) {
+        divergentGame = game;
+        report.mDivergence = GameDivergence { .mSeed { game }, .mActions { actions[game] }, .mDescription { std::move(description) } };
+    };
+
+    for(uint32_t turn { 0 }; turn < kMaxActions; ++turn) {
+        bool isInProgress { false };
+        for(uint64_t game { 0 }; game < divergentGame; ++game) {
+            if(isFinished[game]) continue;
+            std::string difference { findBatchDifference(references[game], batch, game) };
+            if(!difference.empty()) {
+                diverge(game, std::move(difference));
+                break;
+            }
+            isFinished[game] = references[game].getCurrentPhase().mGamePhase == GamePhase::END;
+            isInProgress = isInProgress || !isFinished[game];
+        }
+        if(!isInProgress) break;
+
+        batch.playTurns(1, kernel);
+        for(uint64_t game { 0 }; game < divergentGame; ++game) {
+            if(isFinished[game]) continue;
+            std::vector<GameEvent> turnActions {};
+            if(!findBatchTurn(references[game], batch, game, turnActions)) {
+                diverge(game, "No turn open to the reference arrives where the batch's turn did");
+                break;
+            }
+            for(const GameEvent& action: turnActions) {
+                apply(references[game], action);
+                actions[game].push_back(action);
+            }
+            report.mNActions += turnActions.size();
+        }
+    }
+
+    report.mNGames = std::count(isFinished.begin(), isFinished.begin() + divergentGame, true) + (report.mDivergence? 1: 0);
+    return report;
+}
+
+std::string DifferentialCheck::findBatchDifference(const GameOfUrModel& reference, const GameBatch& batch, std::size_t game) {
+    const GamePhaseData phase { reference.getCurrentPhase() };
+    const GamePosition referencePosition { reference.getPosition() };
+    const GamePosition batchPosition { batch.getPosition(game) };
+    if(phase.mWinner != batch.getWinner(game)) return "The winners differ";
+    if(phase.mGamePhase != GamePhase::END && referencePosition.mTurn != batchPosition.mTurn) return "The roles whose turn it is differ";
+    if(referencePosition.mPieces != batchPosition.mPieces) return "The pieces differ";
+    if(reference.getPlayerData(RoleID::BLACK).mCounters != batch.getCounters(game, RoleID::BLACK)) return "The counters of black differ";
+    if(reference.getPlayerData(RoleID::WHITE).mCounters != batch.getCounters(game, RoleID::WHITE)) return "The counters of white differ";
+    if(reference.getScore().mCommonPoolCounters != batch.getPoolCounters(game)) return "The counters of the common pool differ";
+    return "";
+}
+
+bool DifferentialCheck::findBatchTurn(const GameOfUrModel& reference, const GameBatch& batch, std::size_t game, std::vector<GameEvent>& actions) {
+    if(reference.getCurrentPhase().mGamePhase == GamePhase::END) return findBatchDifference(reference, batch, game).empty();
+
+    const PlayerID player { reference.getCurrentPhase().mTurn };
+    const bool canRoll { reference.canRollDice(player) };
+    const MoveResultList moves { reference.getAllPossibleMoveData() };
+    if(!canRoll && moves.empty()) {
+        if(!reference.canAdvanceOneTurn(player)) return false;
+        GameOfUrModel next { reference };
+        const GameEvent action { makeTurnAction(player) };
+        apply(next, action);
+        if(!findBatchDifference(next, batch, game).empty()) return false;
+        actions.push_back(action);
+        return true;
+    }
+
+    const auto tryAction = [&](const GameEvent& action) {
+        GameOfUrModel next { reference };
+        apply(next, action);
+        actions.push_back(action);
+        if(findBatchTurn(next, batch, game, actions)) return true;
+        actions.pop_back();
+        return false;
+    };
+    for(const MoveResultData& move: moves) {
+        if(tryAction(makeMoveAction(reference, move))) return true;
+    }
+    if(canRoll) {
+        for(const Dice::Outcome& outcome: reference.getDiceRollOutcomes()) {
+            if(tryAction(makeRollAction(player, outcome))) return true;
+        }
+    }
+    return false;
+}
+
+bool DifferentialCheck::isLegal(const GameOfUrModel& reference, const GameEvent& action) {
+    const GamePhaseData phase { reference.getCurrentPhase() };
+    if(phase.mGamePhase == GamePhase::END || action.mPlayer != phase.mTurn) return false;
+
+    switch(action.mType) {
+        case GameEvent::Type::DICE_ROLL: {
+            if(!reference.canRollDice(action.mPlayer)) return false;
+            const Dice::OutcomeList outcomes { reference.getDiceRollOutcomes() };
+            return std::any_of(outcomes.begin(), outcomes.end(), [&action](const Dice::Outcome& outcome) {
+                return (
+                    outcome.mState == action.mDiceState
+                    && outcome.mPrimaryRoll == action.mPrimaryRoll
+                    && outcome.mSecondaryRoll == action.mSecondaryRoll
+                    && outcome.mResultScore == action.mResultScore
+                );
+            });
+        }
+
+        case GameEvent::Type::LAUNCH:
+        case GameEvent::Type::BOARD_MOVE: {
+            const MoveResultList moves { reference.getAllPossibleMoveData() };
+            return std::any_of(moves.begin(), moves.end(), [&action](const MoveResultData& move) {
+                return move.mMovedPiece.mIdentity == action.mPiece && move.mMovedPiece.mLocation == action.mLocation;
+            });
+        }
+
+        case GameEvent::Type::NEXT_TURN:
+            return reference.canAdvanceOneTurn(action.mPlayer) || reference.canStartPhasePlay();
+    }
+    return false;
+}
+
+GameEvent DifferentialCheck::makeRollAction(PlayerID player, const Dice::Outcome& outcome) {
+    return {
+        .mType { GameEvent::Type::DICE_ROLL }, .mPlayer { player }, .mPiece {}, .mLocation {},
+        .mDiceState { outcome.mState }, .mPrimaryRoll { outcome.mPrimaryRoll }, .mSecondaryRoll { outcome.mSecondaryRoll }, .mResultScore { outcome.mResultScore },
+    };
+}
+
+GameEvent DifferentialCheck::makeMoveAction(const GameOfUrModel& reference, const MoveResultData& move) {
+    return {
+        .mType {
+            reference.getPieceData(move.mMovedPiece.mIdentity).mState == Piece::State::UNLAUNCHED?
+                GameEvent::Type::LAUNCH: GameEvent::Type::BOARD_MOVE
+        },
+        .mPlayer { reference.getCurrentPhase().mTurn }, .mPiece { move.mMovedPiece.mIdentity }, .mLocation { move.mMovedPiece.mLocation },
+        .mDiceState {}, .mPrimaryRoll {}, .mSecondaryRoll {}, .mResultScore {},
+    };
+}
+
+GameEvent DifferentialCheck::makeTurnAction(PlayerID player) {
+    return { .mType { GameEvent::Type::NEXT_TURN }, .mPlayer { player }, .mPiece {}, .mLocation {}, .mDiceState {}, .mPrimaryRoll {}, .mSecondaryRoll {}, .mResultScore {} };
+}
+
+std::string DifferentialCheck::compareMoves(const MoveResultList& reference, const MoveResultList& candidate) {
+    if(reference.size() != candidate.size()) {
+        return "The reference offers " + std::to_string(reference.size()) + " moves, and the candidate " + std::to_string(candidate.size());
+    }
+
+    // the engines may list the same moves in different orders
+    const auto sortMoves = [](const MoveResultList& moves) {
+        std::vector<MoveResultData> sortedMoves { moves.begin(), moves.end() };
+        std::sort(sortedMoves.begin(), sortedMoves.end(), [](const MoveResultData& one, const MoveResultData& two) {
+            const GamePieceData& first { one.mMovedPiece };
+            const GamePieceData& second { two.mMovedPiece };
+            if(first.mIdentity.mType != second.mIdentity.mType) return first.mIdentity.mType < second.mIdentity.mType;
+            if(first.mLocation.x != second.mLocation.x) return first.mLocation.x < second.mLocation.x;
+            return first.mLocation.y < second.mLocation.y;
+        });
+        return sortedMoves;
+    };
+    const std::vector<MoveResultData> referenceMoves { sortMoves(reference) };
+    const std::vector<MoveResultData> candidateMoves { sortMoves(candidate) };
+
+    // pieces with no owner are compared by their owner alone, as PieceIdentity
+    // does not compare them
+    const auto samePiece = [](const GamePieceData& one, const GamePieceData& two) {
+        return (
+            one.mIdentity.mOwner == two.mIdentity.mOwner
+            && (one.mIdentity.mOwner == RoleID::NA || (
+                one.mIdentity.mType == two.mIdentity.mType
+                && one.mState == two.mState
+                && one.mLocation == two.mLocation
+            ))
+        );
+    };
+    for(std::size_t move { 0 }; move < referenceMoves.size(); ++move) {
+        const MoveResultData& referenceMove { referenceMoves[move] };
+        const MoveResultData& candidateMove { candidateMoves[move] };
+        const std::string moveName {
+            std::string { kGamePieceTypes[referenceMove.mMovedPiece.mIdentity.mType].mName }
+            + " to (" + std::to_string(referenceMove.mMovedPiece.mLocation.x)
+            + ", " + std::to_string(referenceMove.mMovedPiece.mLocation.y) + ")"
+        };
+
+        if(!samePiece(referenceMove.mMovedPiece, candidateMove.mMovedPiece)) return "The engines offer different moves, starting with the " + moveName;
+        if(referenceMove.mFlags != candidateMove.mFlags) return "The flags of moving the " + moveName + " differ";
+        if(!samePiece(referenceMove.mDisplacedPiece, candidateMove.mDisplacedPiece)) return "The piece displaced by moving the " + moveName + " differs";
+        if(referenceMove.mCountersWon != candidateMove.mCountersWon) return "The counters won by moving the " + moveName + " differ";
+        if(referenceMove.mCountersLost != candidateMove.mCountersLost) return "The counters lost by moving the " + moveName + " differ";
+    }
+
+    return "";
+}
+
+std::string DifferentialCheck::compareData(const EngineData& reference, const EngineData& candidate) {
+    if(reference.mPhase.mGamePhase != candidate.mPhase.mGamePhase) return "The game phases differ";
+    if(reference.mPhase.mRoundPhase != candidate.mPhase.mRoundPhase) return "The round phases differ";
+    if(reference.mPhase.mTurnPhase != candidate.mPhase.mTurnPhase) return "The turn phases differ";
+    if(reference.mPhase.mTurn != candidate.mPhase.mTurn) return "The players whose turn it is differ";
+    if(reference.mPhase.mWinner != candidate.mPhase.mWinner) return "The winners differ";
+
+    if(
+        reference.mDice.mState != candidate.mDice.mState
+        || reference.mDice.mPrimaryRoll != candidate.mDice.mPrimaryRoll
+        || reference.mDice.mSecondaryRoll != candidate.mDice.mSecondaryRoll
+    ) return "The dice differ";
+    if(reference.mDice.mResultScore != candidate.mDice.mResultScore) return "The dice results differ";
+    if(reference.mDice.mPreviousResult != candidate.mDice.mPreviousResult) return "The previous turns' dice results differ";
+
+    if(
+        reference.mScore.mCommonPoolCounters != candidate.mScore.mCommonPoolCounters
+        || reference.mScore.mPlayerOneCounters != candidate.mScore.mPlayerOneCounters
+        || reference.mScore.mPlayerTwoCounters != candidate.mScore.mPlayerTwoCounters
+    ) return "The counters differ";
+    if(
+        reference.mScore.mPlayerOneVictoryPieces != candidate.mScore.mPlayerOneVictoryPieces
+        || reference.mScore.mPlayerTwoVictoryPieces != candidate.mScore.mPlayerTwoVictoryPieces
+    ) return "The pieces that have completed their route differ";
+
+    for(uint8_t player { PlayerID::PLAYER_A }; player <= PlayerID::PLAYER_B; ++player) {
+        const PlayerData& referencePlayer { reference.mPlayers[player] };
+        const PlayerData& candidatePlayer { candidate.mPlayers[player] };
+        const std::string playerName { player == PlayerID::PLAYER_A? "player A": "player B" };
+        if(referencePlayer.mRole != candidatePlayer.mRole) return "The roles of " + playerName + " differ";
+        if(referencePlayer.mIsWinner != candidatePlayer.mIsWinner) return "Whether " + playerName + " has won differs";
+        if(referencePlayer.mCounters != candidatePlayer.mCounters) return "The counters of " + playerName + " differ";
+        if(
+            referencePlayer.mNUnlaunchedPieces != candidatePlayer.mNUnlaunchedPieces
+            || referencePlayer.mNBoardPieces != candidatePlayer.mNBoardPieces
+            || referencePlayer.mNVictoryPieces != candidatePlayer.mNVictoryPieces
+        ) return "The pieces of " + playerName + " differ";
+    }
+
+    return "";
+}
+
+bool DifferentialCheck::countersBalance(const EngineData& engineData) {
+    // the score leaves out the players' counters until roles are assigned, so
+    // they are taken from the players themselves
+    return (
+        engineData.mScore.mCommonPoolCounters
+        + engineData.mPlayers[PlayerID::PLAYER_A].mCounters
+        + engineData.mPlayers[PlayerID::PLAYER_B].mCounters
+        == kUrRuleset.getTotalCounters()
+    );
+}
@@ -0,0 +1,519 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/differential_check.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a harness which plays seeded random games through GameOfUrModel and another engine in lockstep, reporting the first point at which they disagree.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPDIFFERENTIALCHECK_H
+#define ZOAPPDIFFERENTIALCHECK_H
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "model.hpp"
+#include "game_batch.hpp"
+#include "game_log.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The first point at which an engine was found to disagree with GameOfUrModel.
+ * 
+ */
+struct GameDivergence {
+    /**
+     * @brief The seed of the game in which the engines disagreed, or for DifferentialCheck::runBatch(), the index of the game within the batch.
+     * 
+     */
+    uint64_t mSeed;
+
+    /**
+     * @brief The actions which, applied to both engines from the start of a game, lead to a state in which they disagree.
+     * 
+     */
+    std::vector<GameEvent> mActions;
+
+    /**
+     * @brief A description of how the engines disagree.
+     * 
+     */
+    std::string mDescription;
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The outcome of a run of DifferentialCheck.
+ * 
+ */
+struct DifferentialReport {
+    /**
+     * @brief The number of games played to completion, or to the point where the engines disagreed.
+     * 
+     */
+    uint64_t mNGames;
+
+    /**
+     * @brief The number of actions applied to each engine across every game.
+     * 
+     */
+    uint64_t mNActions;
+
+    /**
+     * @brief The disagreement in the game with the lowest seed, if there was any.
+     * 
+     */
+    std::optional<GameDivergence> mDivergence;
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief Plays seeded random games through GameOfUrModel, the reference, and some candidate engine in lockstep, comparing the two before every action.
+ * 
+ * Compared are the phases of the game, the dice, the score, each player's data, the counters (which must always total kUrRuleset.getTotalCounters() in each engine), which of rolling, ending the turn and starting the play phase are allowed, and the set of legal moves along with every field of their MoveResultData.
+ * 
+ * Each game's actions are chosen the way PlayerCPURandom chooses them, uniformly between rolling and every legal move, from a RandomEngine keyed by the game's seed, and dice outcomes are forced rather than rolled.  Every game is therefore reproduced exactly by its seed, whatever the number of threads.  The divergence reported is shrunk by shrink(), so that no action may be dropped from it without the engines coming to agree, though a shorter sequence of different actions might still reproduce it.
+ * 
+ * GameBatch only plays whole turns of its own choosing, and so is checked by runBatch() instead.
+ * 
+ * A candidate engine must be default constructible and provide, with the same meaning as GameOfUrModel's, getCurrentPhase(), getDiceData(), getScore(), getPlayerData(PlayerID), getAllPossibleMoveData(), getDiceRollOutcomes(), canRollDice(), canAdvanceOneTurn(), canStartPhasePlay(), applyDiceOutcome(), applyMove(PieceIdentity, glm::u8vec2), applyTurnAdvance(), and startPhasePlay().
+ * 
+ */
+class DifferentialCheck {
+public:
+    /**
+     * @brief The most actions taken in a single game before it is abandoned.
+     * 
+     */
+    static constexpr uint32_t kMaxActions { 100000 };
+
+    /**
+     * @brief Plays a number of games through both engines, spread across several threads.
+     * 
+     * @tparam TCandidate The engine checked against GameOfUrModel.
+     * @param nGames The number of games played, unless the engines disagree.
+     * @param firstSeed The seed of the first game, with each following game using the next seed.
+     * @param nThreads The number of threads the games are spread across.
+     * @return DifferentialReport The number of games and actions played, and the first disagreement found.
+     */
+    template <typename TCandidate>
+    static DifferentialReport run(uint64_t nGames, uint64_t firstSeed=0, unsigned nThreads=std::thread::hardware_concurrency());
+
+    /**
+     * @brief Plays a single game through both engines.
+     * 
+     * @tparam TCandidate The engine checked against GameOfUrModel.
+     * @param seed The seed from which the game's actions are chosen.
+     * @param nActions Incremented for every action taken.
+     * @return std::optional<GameDivergence> The point at which the engines first disagreed, if they did.
+     */
+    template <typename TCandidate>
+    static std::optional<GameDivergence> playGame(uint64_t seed, uint64_t& nActions);
+
+    /**
+     * @brief Shrinks the actions of a divergence, dropping runs of whole turns, halving in length, and then single actions, for as long as what remains is legal and still ends in a disagreement.
+     * 
+     * @tparam TCandidate The engine checked against GameOfUrModel.
+     * @param divergence A divergence found by playGame().
+     * @return GameDivergence The divergence, with actions from which no single action may be dropped, and the description of the disagreement they now end in.
+     */
+    template <typename TCandidate>
+    static GameDivergence shrink(GameDivergence divergence);
+
+    /**
+     * @brief Applies a sequence of actions to both engines, stopping at the first disagreement.
+     * 
+     * @tparam TCandidate The engine checked against GameOfUrModel.
+     * @param seed The seed recorded with any divergence found.
+     * @param actions The actions applied, from the start of a game.
+     * @return std::optional<GameDivergence> The actions up to the first disagreement, if there was one and every action before it was legal.
+     */
+    template <typename TCandidate>
+    static std::optional<GameDivergence> replay(uint64_t seed, const std::vector<GameEvent>& actions);
+
+    /**
+     * @brief Plays a batch of random games through GameBatch a turn at a time, checking after every turn that the reference could have played the same turn.
+     * 
+     * The batch chooses its own actions, and only reports the state of its games between turns.  Each turn it plays is therefore matched against every turn open to the reference from the same state, i.e., every sequence of dice outcomes and moves up to the end of the turn, and the reference follows the first that arrives where the batch did.  The games are compared before every turn as for findBatchDifference(), and diverge as soon as they differ or no turn of the reference matches the batch's.
+     * 
+     * @param nGames The number of games played, unless the engines disagree.
+     * @param firstSeed The seed of the engine from which the key of every game in the batch is derived.
+     * @param kernel The instruction set the batch is played with.
+     * @return DifferentialReport The number of games and of the reference's actions played, and the disagreement in the game with the lowest index, the reference's actions leading up to the turn it happened on.
+     */
+    static DifferentialReport runBatch(uint64_t nGames, uint64_t firstSeed=0, GameBatch::Kernel kernel=GameBatch::getBestKernel());
+
+    /**
+     * @brief Applies a recorded action to an engine, such as when reproducing a divergence.
+     * 
+     * @tparam TEngine GameOfUrModel, or a candidate engine.
+     * @param engine The engine the action is applied to.
+     * @param action The action being applied.
+     */
+    template <typename TEngine>
+    static void apply(TEngine& engine, const GameEvent& action);
+
+    /**
+     * @brief Compares the state of a candidate engine with that of the reference.
+     * 
+     * @tparam TCandidate The engine checked against GameOfUrModel.
+     * @param reference The reference engine.
+     * @param candidate The candidate engine.
+     * @return std::string A description of the first difference found, or an empty string if there was none.
+     */
+    template <typename TCandidate>
+    static std::string findDifference(const GameOfUrModel& reference, const TCandidate& candidate);
+
+    /**
+     * @brief Compares the state of a game of a batch with that of the reference: whose turn it is, every piece, the counters, and the winner.
+     * 
+     * @param reference The reference engine, at the start of a turn or at the end of the game.
+     * @param batch The batch.
+     * @param game The index of the game within the batch.
+     * @return std::string A description of the first difference found, or an empty string if there was none.
+     */
+    static std::string findBatchDifference(const GameOfUrModel& reference, const GameBatch& batch, std::size_t game);
+
+    /**
+     * @brief Tests whether an action may be taken in the reference's current state.
+     * 
+     * @param reference The reference engine.
+     * @param action The action tested.
+     * @retval true The action belongs to the player whose turn it is, and is one the reference allows.
+     * @retval false The action can't be applied.
+     */
+    static bool isLegal(const GameOfUrModel& reference, const GameEvent& action);
+
+private:
+    /**
+     * @brief Describes the roll of the dice to an outcome as an action.
+     * 
+     * @param player The player rolling.
+     * @param outcome The outcome rolled.
+     * @return GameEvent The roll.
+     */
+    static GameEvent makeRollAction(PlayerID player, const Dice::Outcome& outcome);
+
+    /**
+     * @brief Describes a move offered by the reference as an action.
+     * 
+     * @param reference The reference engine, before the move.
+     * @param move The move.
+     * @return GameEvent The launch or board move.
+     */
+    static GameEvent makeMoveAction(const GameOfUrModel& reference, const MoveResultData& move);
+
+    /**
+     * @brief Describes the end of a turn, or the start of the play phase, as an action.
+     * 
+     * @param player The player whose turn it is.
+     * @return GameEvent The end of the turn.
+     */
+    static GameEvent makeTurnAction(PlayerID player);
+
+    /**
+     * @brief Searches the turns open to the reference for one that arrives where a game of a batch did.
+     * 
+     * Actions are chosen as the random players choose them, between rolling and every legal move, with the turn ended only when neither is possible.
+     * 
+     * @param reference The reference engine, partway through the turn searched.
+     * @param batch The batch, after the turn.
+     * @param game The index of the game within the batch.
+     * @param actions The actions of the turn so far, to which those completing a matching turn are appended.
+     * @retval true A matching turn was found, and its actions appended.
+     * @retval false No turn from here matches, and the actions are as they were.
+     */
+    static bool findBatchTurn(const GameOfUrModel& reference, const GameBatch& batch, std::size_t game, std::vector<GameEvent>& actions);
+
+    /**
+     * @brief Compares the sets of moves offered by both engines, in whatever order each lists them.
+     * 
+     * @param reference The results of every move offered by the reference.
+     * @param candidate The results of every move offered by the candidate.
+     * @return std::string A description of the first difference found, or an empty string if there was none.
+     */
+    static std::string compareMoves(const MoveResultList& reference, const MoveResultList& candidate);
+
+    /**
+     * @brief The data reported by an engine about the state of its game, outside of its moves.
+     * 
+     */
+    struct EngineData {
+        /**
+         * @brief The phases of the game.
+         * 
+         */
+        GamePhaseData mPhase;
+
+        /**
+         * @brief The state of the dice.
+         * 
+         */
+        DiceData mDice;
+
+        /**
+         * @brief The score of the game.
+         * 
+         */
+        GameScoreData mScore;
+
+        /**
+         * @brief The data of each player, indexed by PlayerID.
+         * 
+         */
+        std::array<PlayerData, 2> mPlayers;
+    };
+
+    /**
+     * @brief Gathers the data an engine reports about the state of its game.
+     * 
+     * @tparam TEngine GameOfUrModel, or a candidate engine.
+     * @param engine The engine queried.
+     * @return EngineData The engine's data.
+     */
+    template <typename TEngine>
+    static EngineData getEngineData(const TEngine& engine) {
+        return {
+            .mPhase { engine.getCurrentPhase() },
+            .mDice { engine.getDiceData() },
+            .mScore { engine.getScore() },
+            .mPlayers {{ engine.getPlayerData(PlayerID::PLAYER_A), engine.getPlayerData(PlayerID::PLAYER_B) }},
+        };
+    }
+
+    /**
+     * @brief Compares the phases, dice, score and players reported by both engines.
+     * 
+     * @param reference The data reported by the reference.
+     * @param candidate The data reported by the candidate.
+     * @return std::string A description of the first difference found, or an empty string if there was none.
+     */
+    static std::string compareData(const EngineData& reference, const EngineData& candidate);
+
+    /**
+     * @brief Tests whether every counter of a game is accounted for between the common pool and the players.
+     * 
+     * @param engineData The data reported by an engine.
+     * @retval true The counters total kUrRuleset.getTotalCounters().
+     * @retval false Counters have been lost or made up.
+     */
+    static bool countersBalance(const EngineData& engineData);
+};
+
+template <typename TCandidate>
+DifferentialReport DifferentialCheck::run(uint64_t nGames, uint64_t firstSeed, unsigned nThreads) {
+    DifferentialReport report { .mNGames { 0 }, .mNActions { 0 }, .mDivergence {} };
+    std::mutex reportMutex {};
+    std::atomic<uint64_t> nextGame { 0 };
+
+    // games after the earliest one found to diverge are skipped, while those
+    // before it still run, so that the divergence reported is the same however
+    // the games happen to be scheduled
+    std::atomic<uint64_t> divergentGame { nGames };
+
+    const auto playGames = [&]() {
+        uint64_t nGamesPlayed { 0 };
+        uint64_t nActions { 0 };
+        for(uint64_t game { nextGame++ }; game < divergentGame.load(); game = nextGame++) {
+            std::optional<GameDivergence> divergence { playGame<TCandidate>(firstSeed + game, nActions) };
+            ++nGamesPlayed;
+            if(!divergence) continue;
+
+            const std::lock_guard<std::mutex> lock { reportMutex };
+            if(game < divergentGame.load()) {
+                divergentGame = game;
+                report.mDivergence = std::move(divergence);
+            }
+        }
+
+        const std::lock_guard<std::mutex> lock { reportMutex };
+        report.mNGames += nGamesPlayed;
+        report.mNActions += nActions;
+    };
+
+    std::vector<std::thread> threads {};
+    for(unsigned thread { 1 }; thread < std::max(nThreads, 1u); ++thread) {
+        threads.emplace_back(playGames);
+    }
+    playGames();
+    for(std::thread& thread: threads) {
+        thread.join();
+    }
+
+    if(report.mDivergence) {
+        report.mDivergence = shrink<TCandidate>(std::move(*report.mDivergence));
+    }
+    return report;
+}
+
+template <typename TCandidate>
+std::optional<GameDivergence> DifferentialCheck::playGame(uint64_t seed, uint64_t& nActions) {
+    GameOfUrModel reference {};
+    TCandidate candidate {};
+    RandomEngine randomEngine { seed };
+    std::vector<GameEvent> actions {};
+
+    for(uint32_t action { 0 }; action < kMaxActions; ++action) {
+        std::string difference { findDifference(reference, candidate) };
+        if(!difference.empty()) {
+            return GameDivergence { .mSeed { seed }, .mActions { std::move(actions) }, .mDescription { std::move(difference) } };
+        }
+        if(reference.getCurrentPhase().mGamePhase == GamePhase::END) break;
+
+        // choose between rolling and each move, as PlayerCPURandom does,
+        // falling back on ending the turn when neither is possible
+        const PlayerID player { reference.getCurrentPhase().mTurn };
+        const bool canRoll { reference.canRollDice(player) };
+        const MoveResultList moves { reference.getAllPossibleMoveData() };
+        const uint64_t nChoices { moves.size() + canRoll };
+        const uint64_t choice { nChoices? randomEngine() % nChoices: 0 };
+
+        GameEvent event { makeTurnAction(player) };
+        if(canRoll && choice == moves.size()) {
+            const Dice::OutcomeList outcomes { reference.getDiceRollOutcomes() };
+            event = makeRollAction(player, outcomes[randomEngine() % outcomes.size()]);
+
+        } else if(choice < moves.size()) {
+            event = makeMoveAction(reference, moves[choice]);
+        }
+
+        apply(reference, event);
+        apply(candidate, event);
+        actions.push_back(event);
+        ++nActions;
+    }
+
+    return std::nullopt;
+}
+
+template <typename TCandidate>
+GameDivergence DifferentialCheck::shrink(GameDivergence divergence) {
+    const auto dropRun = [&divergence](std::size_t begin, std::size_t end) {
+        std::vector<GameEvent> actions { divergence.mActions.begin(), divergence.mActions.begin() + begin };
+        actions.insert(actions.end(), divergence.mActions.begin() + end, divergence.mActions.end());
+        std::optional<GameDivergence> shrunk { replay<TCandidate>(divergence.mSeed, actions) };
+        if(!shrunk) return false;
+        divergence = std::move(*shrunk);
+        return true;
+    };
+
+    // what remains of a turn whose actions are dropped is rarely legal, and so
+    // whole turns are dropped first, each run tried from every turn
+    const auto getTurnStarts = [&divergence]() {
+        std::vector<std::size_t> turnStarts { 0 };
+        for(std::size_t action { 0 }; action < divergence.mActions.size(); ++action) {
+            if(divergence.mActions[action].mType == GameEvent::Type::NEXT_TURN) turnStarts.push_back(action + 1);
+        }
+        if(turnStarts.back() != divergence.mActions.size()) turnStarts.push_back(divergence.mActions.size());
+        return turnStarts;
+    };
+    for(std::size_t runTurns { std::max<std::size_t>((getTurnStarts().size() - 1) / 2, 1) }; runTurns > 0; runTurns /= 2) {
+        for(std::size_t beginTurn { 0 };; ) {
+            const std::vector<std::size_t> turnStarts { getTurnStarts() };
+            if(beginTurn + runTurns >= turnStarts.size()) break;
+            if(!dropRun(turnStarts[beginTurn], turnStarts[beginTurn + runTurns])) ++beginTurn;
+        }
+    }
+
+    for(std::size_t begin { 0 }; begin < divergence.mActions.size();) {
+        if(!dropRun(begin, begin + 1)) ++begin;
+    }
+    return divergence;
+}
+
+template <typename TCandidate>
+std::optional<GameDivergence> DifferentialCheck::replay(uint64_t seed, const std::vector<GameEvent>& actions) {
+    GameOfUrModel reference {};
+    TCandidate candidate {};
+    for(std::size_t action { 0 }; action <= actions.size(); ++action) {
+        std::string difference { findDifference(reference, candidate) };
+        if(!difference.empty()) {
+            return GameDivergence {
+                .mSeed { seed },
+                .mActions { actions.begin(), actions.begin() + action },
+                .mDescription { std::move(difference) },
+            };
+        }
+        if(action == actions.size() || !isLegal(reference, actions[action])) break;
+
+        apply(reference, actions[action]);
+        apply(candidate, actions[action]);
+    }
+
+    return std::nullopt;
+}
+
+template <typename TEngine>
+void DifferentialCheck::apply(TEngine& engine, const GameEvent& action) {
+    switch(action.mType) {
+        case GameEvent::Type::DICE_ROLL:
+            engine.applyDiceOutcome(
+                Dice::Outcome {
+                    .mState { action.mDiceState },
+                    .mPrimaryRoll { action.mPrimaryRoll },
+                    .mSecondaryRoll { action.mSecondaryRoll },
+                    .mResultScore { action.mResultScore },
+                    .mProbability { 1.0 },
+                }
+            );
+            break;
+
+        case GameEvent::Type::LAUNCH:
+        case GameEvent::Type::BOARD_MOVE:
+            engine.applyMove(action.mPiece, action.mLocation);
+            break;
+
+        case GameEvent::Type::NEXT_TURN:
+            if(engine.canAdvanceOneTurn(action.mPlayer)) {
+                engine.applyTurnAdvance();
+            } else {
+                engine.startPhasePlay();
+            }
+            break;
+    }
+}
+
+template <typename TCandidate>
+std::string DifferentialCheck::findDifference(const GameOfUrModel& reference, const TCandidate& candidate) {
+    const EngineData referenceData { getEngineData(reference) };
+    const EngineData candidateData { getEngineData(candidate) };
+
+    // each engine's counters are checked on their own, so that a rules change
+    // breaking the invariant in both engines alike is still caught
+    if(!countersBalance(referenceData)) return "The reference's counters do not add up";
+    if(!countersBalance(candidateData)) return "The candidate's counters do not add up";
+
+    std::string difference { compareData(referenceData, candidateData) };
+    if(!difference.empty()) return difference;
+
+    const PlayerID player { reference.getCurrentPhase().mTurn };
+    if(reference.canRollDice(player) != candidate.canRollDice(player)) return "The engines disagree on whether the dice may be rolled";
+    if(reference.canAdvanceOneTurn(player) != candidate.canAdvanceOneTurn(player)) return "The engines disagree on whether the turn may be ended";
+    if(reference.canStartPhasePlay() != candidate.canStartPhasePlay()) return "The engines disagree on whether the play phase may start";
+
+    const Dice::OutcomeList referenceOutcomes { reference.getDiceRollOutcomes() };
+    const Dice::OutcomeList candidateOutcomes { candidate.getDiceRollOutcomes() };
+    if(referenceOutcomes.size() != candidateOutcomes.size()) return "The engines disagree on the outcomes of rolling the dice";
+    for(std::size_t outcome { 0 }; outcome < referenceOutcomes.size(); ++outcome) {
+        if(
+            referenceOutcomes[outcome].mState != candidateOutcomes[outcome].mState
+            || referenceOutcomes[outcome].mPrimaryRoll != candidateOutcomes[outcome].mPrimaryRoll
+            || referenceOutcomes[outcome].mSecondaryRoll != candidateOutcomes[outcome].mSecondaryRoll
+            || referenceOutcomes[outcome].mResultScore != candidateOutcomes[outcome].mResultScore
+        ) return "The engines disagree on the outcomes of rolling the dice";
+    }
+
+    return compareMoves(reference.getAllPossibleMoveData(), candidate.getAllPossibleMoveData());
+}
+
+#endif
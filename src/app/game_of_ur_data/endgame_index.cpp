@@ -0,0 +1,237 @@
+#include <cassert>
+#include <algorithm>
+#include <bit>
+
+#include "endgame_index.hpp"
+
+uint8_t EndgameIndex::getFreeHouseRank(uint8_t house, uint16_t takenHouses) {
+    return house - std::popcount(static_cast<uint16_t>(takenHouses & ((1u << house) - 1u)));
+}
+
+uint8_t EndgameIndex::getFreeHouse(uint8_t rank, uint16_t takenHouses) {
+    uint8_t house { 0 };
+    for(;; ++house) {
+        if(takenHouses & (1u << house)) continue;
+        if(rank-- == 0) break;
+    }
+    return house;
+}
+
+EndgameIndex::EndgameIndex(uint8_t maxPiecesLeft):
+    mMaxPiecesLeft { maxPiecesLeft }
+{
+    assert(maxPiecesLeft >= 1 && maxPiecesLeft <= PieceTypeID::TOTAL && "Each role has between 1 and 5 pieces left while a game is in progress");
+
+    std::array<uint8_t, PositionIndex::kNClassAssignments> piecesLeft {};
+    for(uint16_t assignment { 0 }; assignment < PositionIndex::kNClassAssignments; ++assignment) {
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const uint8_t placementClass { static_cast<uint8_t>((assignment >> (2 * type)) & 0x3u) };
+            if(placementClass != FINISHED) ++piecesLeft[assignment];
+            if(placementClass == REGION) ++mBoardCounts[assignment][0];
+            if(placementClass == BATTLEFIELD) ++mBoardCounts[assignment][1];
+        }
+
+        mAssignmentIDs[assignment] = kNoAssignmentID;
+        if(piecesLeft[assignment] >= 1 && piecesLeft[assignment] <= maxPiecesLeft) {
+            mAssignmentIDs[assignment] = static_cast<uint16_t>(mAssignments.size());
+            mAssignments.push_back(assignment);
+        }
+    }
+
+    // blocks are laid out group by group, so that every group is contiguous
+    const std::size_t nAssignments { mAssignments.size() };
+    mBlockOffsets.resize(nAssignments * nAssignments);
+    mBlocks.reserve(nAssignments * nAssignments);
+    uint64_t offset { 0 };
+    for(uint8_t ownPiecesLeft { 1 }; ownPiecesLeft <= maxPiecesLeft; ++ownPiecesLeft) {
+        for(uint8_t otherPiecesLeft { 1 }; otherPiecesLeft <= maxPiecesLeft; ++otherPiecesLeft) {
+            mGroupOffsets.push_back(offset);
+            for(const uint16_t own: mAssignments) {
+                if(piecesLeft[own] != ownPiecesLeft) continue;
+                for(const uint16_t other: mAssignments) {
+                    if(piecesLeft[other] != otherPiecesLeft) continue;
+
+                    mBlockOffsets[mAssignmentIDs[own] * nAssignments + mAssignmentIDs[other]] = offset;
+                    mBlocks.push_back({ .mOffset { offset }, .mOwnAssignment { own }, .mOtherAssignment { other } });
+                    offset += (
+                        static_cast<uint64_t>(countPlacements(kRegionLength, mBoardCounts[own][0]))
+                        * countPlacements(kRegionLength, mBoardCounts[other][0])
+                        * countPlacements(kBattlefieldLength, mBoardCounts[own][1] + mBoardCounts[other][1])
+                    );
+                }
+            }
+        }
+    }
+    mGroupOffsets.push_back(offset);
+}
+
+std::size_t EndgameIndex::getMemoryBytes() const {
+    return (
+        sizeof(EndgameIndex)
+        + mAssignments.capacity() * sizeof(uint16_t)
+        + mBlockOffsets.capacity() * sizeof(uint64_t)
+        + mBlocks.capacity() * sizeof(Block)
+        + mGroupOffsets.capacity() * sizeof(uint64_t)
+    );
+}
+
+EndgameIndex::Slots EndgameIndex::getSlots(const GamePosition& position) {
+    const bool isWhiteToMove { position.mTurn == RoleID::WHITE };
+    Slots slots {};
+    for(uint8_t side { 0 }; side < 2; ++side) {
+        const auto& pieces { position.mPieces[side == 0? isWhiteToMove: !isWhiteToMove] };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const GamePosition::PiecePlacement& piece { pieces[type] };
+            slots[side][type] = (
+                piece.mState == Piece::State::UNLAUNCHED? kUnlaunchedSlot:
+                piece.mState == Piece::State::FINISHED? kFinishedSlot:
+                piece.mRoutePosition + 1u
+            );
+        }
+    }
+    return slots;
+}
+
+uint8_t EndgameIndex::countPiecesLeft(const std::array<uint8_t, PieceTypeID::TOTAL>& pieces) {
+    return static_cast<uint8_t>(std::count_if(pieces.begin(), pieces.end(), [](uint8_t slot) { return slot != kFinishedSlot; }));
+}
+
+bool EndgameIndex::contains(const Slots& slots) const {
+    uint16_t battlefieldHouses { 0 };
+    for(const auto& pieces: slots) {
+        const uint8_t piecesLeft { countPiecesLeft(pieces) };
+        if(piecesLeft < 1 || piecesLeft > mMaxPiecesLeft) return false;
+
+        uint16_t regionHouses { 0 };
+        for(const uint8_t slot: pieces) {
+            if(slot > kFinishedSlot) return false;
+            if(slot == kUnlaunchedSlot || slot == kFinishedSlot) continue;
+
+            const uint8_t routePosition { static_cast<uint8_t>(slot - 1u) };
+            uint16_t& takenHouses { routePosition < kRegionLength? regionHouses: battlefieldHouses };
+            const uint16_t house { static_cast<uint16_t>(1u << (routePosition < kRegionLength? routePosition: routePosition - kRegionLength)) };
+            if(takenHouses & house) return false;
+            takenHouses |= house;
+        }
+    }
+    return true;
+}
+
+uint64_t EndgameIndex::rank(const Slots& slots) const {
+    assert(contains(slots) && "Only positions within the endgame have an index");
+
+    // digits of each role's region placement, and of the battlefield placement
+    // shared by both, accumulated as partial permutations in piece order
+    std::array<uint32_t, 2> regionRanks {};
+    std::array<uint16_t, 2> assignments {};
+    uint32_t battlefieldRank { 0 };
+    uint16_t battlefieldHouses { 0 };
+    uint8_t nBattlefieldPieces { 0 };
+    for(uint8_t side { 0 }; side < 2; ++side) {
+        uint16_t regionHouses { 0 };
+        uint8_t nRegionPieces { 0 };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const uint8_t slot { slots[side][type] };
+            uint16_t placementClass { UNLAUNCHED };
+            if(slot == kFinishedSlot) {
+                placementClass = FINISHED;
+
+            } else if(slot != kUnlaunchedSlot && slot <= kRegionLength) {
+                placementClass = REGION;
+                const uint8_t house { static_cast<uint8_t>(slot - 1u) };
+                regionRanks[side] = regionRanks[side] * (kRegionLength - nRegionPieces) + getFreeHouseRank(house, regionHouses);
+                regionHouses |= (1u << house);
+                ++nRegionPieces;
+
+            } else if(slot != kUnlaunchedSlot) {
+                placementClass = BATTLEFIELD;
+                const uint8_t house { static_cast<uint8_t>(slot - 1u - kRegionLength) };
+                battlefieldRank = battlefieldRank * (kBattlefieldLength - nBattlefieldPieces) + getFreeHouseRank(house, battlefieldHouses);
+                battlefieldHouses |= (1u << house);
+                ++nBattlefieldPieces;
+            }
+            assignments[side] |= placementClass << (2 * type);
+        }
+    }
+
+    const uint64_t blockOffset { mBlockOffsets[mAssignmentIDs[assignments[0]] * mAssignments.size() + mAssignmentIDs[assignments[1]]] };
+    return (
+        blockOffset
+        + (
+            static_cast<uint64_t>(regionRanks[0]) * countPlacements(kRegionLength, mBoardCounts[assignments[1]][0])
+            + regionRanks[1]
+        ) * countPlacements(kBattlefieldLength, nBattlefieldPieces)
+        + battlefieldRank
+    );
+}
+
+EndgameIndex::Slots EndgameIndex::unrank(uint64_t index) const {
+    assert(index < getSize() && "Index must lie within the endgame");
+
+    const auto block {
+        std::prev(std::upper_bound(mBlocks.begin(), mBlocks.end(), index, [](uint64_t value, const Block& one) { return value < one.mOffset; }))
+    };
+    const std::array<uint16_t, 2> assignments { block->mOwnAssignment, block->mOtherAssignment };
+    index -= block->mOffset;
+
+    const uint8_t nBattlefieldPieces { static_cast<uint8_t>(mBoardCounts[assignments[0]][1] + mBoardCounts[assignments[1]][1]) };
+    const uint32_t nBattlefieldPlacements { countPlacements(kBattlefieldLength, nBattlefieldPieces) };
+    const uint32_t nOtherRegionPlacements { countPlacements(kRegionLength, mBoardCounts[assignments[1]][0]) };
+    uint32_t battlefieldRank { static_cast<uint32_t>(index % nBattlefieldPlacements) };
+    index /= nBattlefieldPlacements;
+    std::array<uint32_t, 2> regionRanks {
+        static_cast<uint32_t>(index / nOtherRegionPlacements),
+        static_cast<uint32_t>(index % nOtherRegionPlacements),
+    };
+
+    // peel off the digits of each partial permutation, last piece first
+    std::array<uint8_t, 2 * PieceTypeID::TOTAL> battlefieldDigits {};
+    for(uint8_t piece { nBattlefieldPieces }; piece-- > 0;) {
+        const uint8_t radix { static_cast<uint8_t>(kBattlefieldLength - piece) };
+        battlefieldDigits[piece] = battlefieldRank % radix;
+        battlefieldRank /= radix;
+    }
+    std::array<std::array<uint8_t, PieceTypeID::TOTAL>, 2> regionDigits {};
+    for(uint8_t side { 0 }; side < 2; ++side) {
+        for(uint8_t piece { mBoardCounts[assignments[side]][0] }; piece-- > 0;) {
+            const uint8_t radix { static_cast<uint8_t>(kRegionLength - piece) };
+            regionDigits[side][piece] = regionRanks[side] % radix;
+            regionRanks[side] /= radix;
+        }
+    }
+
+    Slots slots {};
+    uint16_t battlefieldHouses { 0 };
+    uint8_t nPlacedBattlefieldPieces { 0 };
+    for(uint8_t side { 0 }; side < 2; ++side) {
+        uint16_t regionHouses { 0 };
+        uint8_t nPlacedRegionPieces { 0 };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            uint8_t& slot { slots[side][type] };
+            switch((assignments[side] >> (2 * type)) & 0x3u) {
+                case UNLAUNCHED:
+                    slot = kUnlaunchedSlot;
+                    break;
+
+                case FINISHED:
+                    slot = kFinishedSlot;
+                    break;
+
+                case REGION: {
+                    const uint8_t house { getFreeHouse(regionDigits[side][nPlacedRegionPieces++], regionHouses) };
+                    regionHouses |= (1u << house);
+                    slot = house + 1u;
+                    break;
+                }
+
+                case BATTLEFIELD: {
+                    const uint8_t house { getFreeHouse(battlefieldDigits[nPlacedBattlefieldPieces++], battlefieldHouses) };
+                    battlefieldHouses |= (1u << house);
+                    slot = kRegionLength + house + 1u;
+                    break;
+                }
+            }
+        }
+    }
+    return slots;
+}
@@ -0,0 +1,279 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/endgame_index.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a dense index over the positions at the start of a turn in which neither role has more than some number of pieces left to bring home.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPENDGAMEINDEX_H
+#define ZOAPPENDGAMEINDEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+#include "piece_type_id.hpp"
+#include "position_index.hpp"
+#include "route.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A dense, bijective numbering of the positions at the start of a turn, seen from the side of the player about to roll, in which each role has between 1 and some maximum number of pieces that have not yet completed their route.
+ * 
+ * Positions are numbered in the manner of PositionIndex: each role's pieces are first sorted into classes, and the region and battlefield houses of the pieces on the board are then numbered as partial permutations.  Unlike PositionIndex, the roles are named by whose turn it is rather than by colour, which leaves out the turn, and only the class assignments with few enough pieces left are numbered.
+ * 
+ * Since a move never returns a piece that has completed its route, the positions with at most some number of pieces left on each side are closed under play, and may be solved without reference to any other.  Positions are ordered by the number of pieces the player to move has left and then by the number their opponent has left, and each such group occupies a contiguous range of indices.
+ * 
+ */
+class EndgameIndex {
+public:
+    /**
+     * @brief The placement of every piece of both roles, each as a slot: kUnlaunchedSlot, one more than the piece's route position, or kFinishedSlot.
+     * 
+     * The pieces of the player about to roll come first, followed by those of their opponent.
+     * 
+     */
+    using Slots = std::array<std::array<uint8_t, PieceTypeID::TOTAL>, 2>;
+
+    /**
+     * @brief The slot of a piece that hasn't been launched.
+     * 
+     */
+    static constexpr uint8_t kUnlaunchedSlot { 0 };
+
+    /**
+     * @brief The slot of a piece that has completed its route.
+     * 
+     */
+    static constexpr uint8_t kFinishedSlot { RouteTable::kRouteEnd + 1 };
+
+    /**
+     * @brief Creates the index of the positions with at most some number of pieces left on each side.
+     * 
+     * @param maxPiecesLeft The largest number of pieces either role may have left, between 1 and PieceTypeID::TOTAL.
+     */
+    explicit EndgameIndex(uint8_t maxPiecesLeft);
+
+    /**
+     * @brief Gets the largest number of pieces either role may have left in an indexed position.
+     * 
+     * @return uint8_t The largest number of pieces left.
+     */
+    uint8_t getMaxPiecesLeft() const { return mMaxPiecesLeft; }
+
+    /**
+     * @brief Gets the number of positions indexed.
+     * 
+     * @return uint64_t One more than the largest index.
+     */
+    uint64_t getSize() const { return mGroupOffsets.back(); }
+
+    /**
+     * @brief Gets the first index of the positions in which each role has some number of pieces left.
+     * 
+     * @param ownPiecesLeft The number of pieces the player about to roll has left.
+     * @param otherPiecesLeft The number of pieces their opponent has left.
+     * @return uint64_t The index of the first position of the group.
+     */
+    uint64_t getGroupBegin(uint8_t ownPiecesLeft, uint8_t otherPiecesLeft) const { return mGroupOffsets[getGroup(ownPiecesLeft, otherPiecesLeft)]; }
+
+    /**
+     * @brief Gets one past the last index of the positions in which each role has some number of pieces left.
+     * 
+     * @param ownPiecesLeft The number of pieces the player about to roll has left.
+     * @param otherPiecesLeft The number of pieces their opponent has left.
+     * @return uint64_t One past the index of the last position of the group.
+     */
+    uint64_t getGroupEnd(uint8_t ownPiecesLeft, uint8_t otherPiecesLeft) const { return mGroupOffsets[getGroup(ownPiecesLeft, otherPiecesLeft) + 1]; }
+
+    /**
+     * @brief Gets the number of bytes held by this index's tables.
+     * 
+     * @return std::size_t The memory used by this index.
+     */
+    std::size_t getMemoryBytes() const;
+
+    /**
+     * @brief Gets the slots of the pieces of a position, seen from the side of the player whose turn it is.
+     * 
+     * @param position The position, whose turn phase is ignored.
+     * @return Slots The slots of the position's pieces.
+     */
+    static Slots getSlots(const GamePosition& position);
+
+    /**
+     * @brief Counts the pieces of one role that haven't completed their route.
+     * 
+     * @param pieces The slots of the role's pieces.
+     * @return uint8_t The number of pieces left.
+     */
+    static uint8_t countPiecesLeft(const std::array<uint8_t, PieceTypeID::TOTAL>& pieces);
+
+    /**
+     * @brief Tests whether a position is numbered by this index.
+     * 
+     * @param slots The slots of the position's pieces.
+     * @retval true The position is valid, and both roles have between 1 and getMaxPiecesLeft() pieces left.
+     * @retval false The position has no index.
+     */
+    bool contains(const Slots& slots) const;
+
+    /**
+     * @brief Gets the index of a position.
+     * 
+     * @param slots The slots of the position's pieces, for which contains() holds.
+     * @return uint64_t The index of the position.
+     */
+    uint64_t rank(const Slots& slots) const;
+
+    /**
+     * @brief Gets the position with an index.
+     * 
+     * @param index An index less than getSize().
+     * @return Slots The slots of the position's pieces.
+     */
+    Slots unrank(uint64_t index) const;
+
+private:
+    /**
+     * @brief The classes a piece may be sorted into, as in PositionIndex.
+     * 
+     */
+    enum PlacementClass: uint8_t {
+        UNLAUNCHED, //< The piece hasn't been launched yet.
+        FINISHED, //< The piece has completed its route.
+        REGION, //< The piece is on a house of its role's own region.
+        BATTLEFIELD, //< The piece is on a house of the battlefield.
+    };
+
+    /**
+     * @brief The positions of one pair of class assignments, which occupy a contiguous range of indices.
+     * 
+     */
+    struct Block {
+        /**
+         * @brief The index of the first position of the block.
+         * 
+         */
+        uint64_t mOffset;
+
+        /**
+         * @brief The class assignment of the player about to roll.
+         * 
+         */
+        uint16_t mOwnAssignment;
+
+        /**
+         * @brief The class assignment of their opponent.
+         * 
+         */
+        uint16_t mOtherAssignment;
+    };
+
+    /**
+     * @brief The number of houses in each role's region.
+     * 
+     */
+    static constexpr uint8_t kRegionLength { PositionIndex::kRegionLength };
+
+    /**
+     * @brief The number of houses on the battlefield.
+     * 
+     */
+    static constexpr uint8_t kBattlefieldLength { PositionIndex::kBattlefieldLength };
+
+    /**
+     * @brief Marks a class assignment with too many or too few pieces left to be indexed.
+     * 
+     */
+    static constexpr uint16_t kNoAssignmentID { 0xFFFF };
+
+    /**
+     * @brief Gets the number of ways some number of pieces may be placed on distinct houses.
+     * 
+     * @param nHouses The number of houses available.
+     * @param nPieces The number of pieces placed.
+     * @return uint32_t The number of partial permutations.
+     */
+    static constexpr uint32_t countPlacements(uint8_t nHouses, uint8_t nPieces) {
+        uint32_t count { 1 };
+        for(uint8_t piece { 0 }; piece < nPieces; ++piece) count *= nHouses - piece;
+        return count;
+    }
+
+    /**
+     * @brief Gets the number of free houses that come before a house.
+     * 
+     * @param house The house, counting from the first house of its row.
+     * @param takenHouses A mask of the houses of its row already taken.
+     * @return uint8_t The rank of the house among the free houses.
+     */
+    static uint8_t getFreeHouseRank(uint8_t house, uint16_t takenHouses);
+
+    /**
+     * @brief Gets the free house with some rank among the free houses.
+     * 
+     * @param rank The rank of the house among the free houses.
+     * @param takenHouses A mask of the houses of its row already taken.
+     * @return uint8_t The house, counting from the first house of its row.
+     */
+    static uint8_t getFreeHouse(uint8_t rank, uint16_t takenHouses);
+
+    /**
+     * @brief Gets the position of a pair of piece counts among the groups of this index.
+     * 
+     * @param ownPiecesLeft The number of pieces the player about to roll has left.
+     * @param otherPiecesLeft The number of pieces their opponent has left.
+     * @return std::size_t The group's position in mGroupOffsets.
+     */
+    std::size_t getGroup(uint8_t ownPiecesLeft, uint8_t otherPiecesLeft) const { return (ownPiecesLeft - 1u) * mMaxPiecesLeft + otherPiecesLeft - 1u; }
+
+    /**
+     * @brief The largest number of pieces either role may have left.
+     * 
+     */
+    uint8_t mMaxPiecesLeft;
+
+    /**
+     * @brief For each class assignment, its position in mAssignments, or kNoAssignmentID if it isn't indexed.
+     * 
+     */
+    std::array<uint16_t, PositionIndex::kNClassAssignments> mAssignmentIDs {};
+
+    /**
+     * @brief The number of pieces in the region and on the battlefield for each class assignment.
+     * 
+     */
+    std::array<std::array<uint8_t, 2>, PositionIndex::kNClassAssignments> mBoardCounts {};
+
+    /**
+     * @brief The class assignments indexed.
+     * 
+     */
+    std::vector<uint16_t> mAssignments {};
+
+    /**
+     * @brief The offset of the block of every pair of indexed assignments, by the IDs of the assignment of the player to move and of their opponent.
+     * 
+     */
+    std::vector<uint64_t> mBlockOffsets {};
+
+    /**
+     * @brief Every block, in the order of their offsets.
+     * 
+     */
+    std::vector<Block> mBlocks {};
+
+    /**
+     * @brief The first index of each group, followed by the size of the index.
+     * 
+     */
+    std::vector<uint64_t> mGroupOffsets {};
+};
+
+#endif
@@ -0,0 +1,306 @@
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+
+#include "expectiminimax.hpp"
+#include "dice.hpp"
+#include "route.hpp"
+#include "ruleset.hpp"
+
+Expectiminimax::Expectiminimax(double winWeight, Pruning pruning):
+    mWinWeight { winWeight },
+    mPruning { pruning }
+{
+    assert(winWeight >= 0.0 && winWeight <= 1.0 && "The win weight is a share of a game's value");
+}
+
+ExpectiminimaxResult Expectiminimax::search(const GameOfUrModel& model, uint8_t depth, std::chrono::steady_clock::time_point deadline) {
+    assert(model.getCurrentPhase().mGamePhase != GamePhase::INITIATIVE && "Only games whose roles are assigned are searched");
+
+    mResult = {};
+    mResult.mDepth = depth;
+    mDeadline = deadline;
+    mAbandoned = false;
+    const auto start { std::chrono::steady_clock::now() };
+
+    GameOfUrModel searched { model };
+    mRootPlayer = searched.getCurrentPhase().mTurn;
+    ++mResult.mNodes;
+
+    const ActionList actions {
+        searched.getCurrentPhase().mGamePhase == GamePhase::END? ActionList {}: getOrderedActions(searched)
+    };
+    // the action ordered first stands in for the best until some action is
+    // searched in full
+    mResult.mAction = actions.mSize > 0? actions.mActions[0]: SearchAction {};
+    mResult.mValue = actions.mSize > 0? actions.mScores[0]: evaluate(searched, mRootPlayer);
+
+    // the root player maximises, and every action after the first need only
+    // be shown to be no better than the best found so far
+    double alpha { kMinValue };
+    for(uint8_t action { 0 }; action < actions.mSize; ++action) {
+        const double value { searchAction(searched, actions.mActions[action], alpha, kMaxValue, depth) };
+        if(mAbandoned) break;
+        if(action == 0 || value > alpha) {
+            mResult.mAction = actions.mActions[action];
+            mResult.mValue = value;
+            alpha = std::max(alpha, value);
+        }
+    }
+
+    mResult.mCompleted = !mAbandoned;
+    mResult.mSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return mResult;
+}
+
+double Expectiminimax::evaluate(const GameOfUrModel& model, PlayerID player) const {
+    constexpr double kTotalCounters { kUrRuleset.getTotalCounters() };
+    const PlayerID opponent { player == PlayerID::PLAYER_A? PlayerID::PLAYER_B: PlayerID::PLAYER_A };
+    const PlayerData playerData { model.getPlayerData(player) };
+    if(model.getCurrentPhase().mGamePhase == GamePhase::END) {
+        return mWinWeight * (playerData.mIsWinner? 1.0: 0.0) + (1.0 - mWinWeight) * playerData.mCounters / kTotalCounters;
+    }
+
+    // a finished piece counts for one step more than the end of its route, so
+    // that bearing a piece off is worth making
+    const GamePosition position { model.getPosition() };
+    const auto getProgress = [&position](RoleID role) {
+        uint32_t progress { 0 };
+        for(const GamePosition::PiecePlacement& piece: position.mPieces[role - 1]) {
+            if(piece.mState == Piece::State::FINISHED) progress += RouteTable::kRouteEnd + 1u;
+            else if(piece.mState == Piece::State::ON_BOARD) progress += piece.mRoutePosition + 1u;
+        }
+        return static_cast<double>(progress);
+    };
+    constexpr double kMaxProgress { PieceTypeID::TOTAL * (RouteTable::kRouteEnd + 1u) };
+
+    const double winEstimate {
+        0.5 + 0.5 * (getProgress(playerData.mRole) - getProgress(model.getPlayerData(opponent).mRole)) / kMaxProgress
+    };
+    return mWinWeight * winEstimate + (1.0 - mWinWeight) * (playerData.mCounters + winEstimate * model.getNCounters()) / kTotalCounters;
+}
+
+bool Expectiminimax::visitNode() {
+    if(++mResult.mNodes % kDeadlineCheckInterval == 0 && std::chrono::steady_clock::now() >= mDeadline) {
+        mAbandoned = true;
+    }
+    return !mAbandoned;
+}
+
+Expectiminimax::ActionList Expectiminimax::getOrderedActions(GameOfUrModel& model) const {
+    ActionList actions {};
+    const PlayerID player { model.getCurrentPhase().mTurn };
+
+    for(const auto& [piece, toLocation]: model.getAllPossibleMoves()) {
+        const bool isLaunch { model.getPieceData(piece).mState == Piece::State::UNLAUNCHED };
+        const UndoRecord undoRecord { model.applyMove(piece, toLocation) };
+        actions.mScores[actions.mSize] = evaluate(model, mRootPlayer);
+        model.undoMove(undoRecord);
+        actions.mActions[actions.mSize++] = {
+            .mType { isLaunch? SearchAction::Type::LAUNCH: SearchAction::Type::BOARD_MOVE },
+            .mPiece { piece },
+            .mLocation { toLocation },
+        };
+    }
+    if(model.canRollDice(player)) {
+        // the roll's outcome is unknown, so it is scored as the state it's made from
+        actions.mScores[actions.mSize] = evaluate(model, mRootPlayer);
+        actions.mActions[actions.mSize++] = { .mType { SearchAction::Type::DICE_ROLL } };
+    }
+    if(model.canAdvanceOneTurn(player)) {
+        const UndoRecord undoRecord { model.applyTurnAdvance() };
+        actions.mScores[actions.mSize] = evaluate(model, mRootPlayer);
+        model.undoTurnAdvance(undoRecord);
+        actions.mActions[actions.mSize++] = { .mType { SearchAction::Type::NEXT_TURN } };
+    }
+
+    // the lists are short enough that an insertion sort, which keeps ties in
+    // the order the model lists them, is the quickest
+    const bool maximising { player == mRootPlayer };
+    for(uint8_t action { 1 }; action < actions.mSize; ++action) {
+        const SearchAction sortedAction { actions.mActions[action] };
+        const double score { actions.mScores[action] };
+        uint8_t slot { action };
+        for(; slot > 0 && (maximising? actions.mScores[slot - 1] < score: actions.mScores[slot - 1] > score); --slot) {
+            actions.mActions[slot] = actions.mActions[slot - 1];
+            actions.mScores[slot] = actions.mScores[slot - 1];
+        }
+        actions.mActions[slot] = sortedAction;
+        actions.mScores[slot] = score;
+    }
+    return actions;
+}
+
+double Expectiminimax::searchNode(GameOfUrModel& model, double alpha, double beta, uint8_t depth) {
+    if(!visitNode()) return kMinValue;
+    const GamePhaseData phase { model.getCurrentPhase() };
+    if(phase.mGamePhase == GamePhase::END) return evaluate(model, mRootPlayer);
+
+    const ActionList actions { getOrderedActions(model) };
+    if(actions.mSize == 0) return evaluate(model, mRootPlayer);
+    if(actions.mSize == 1) return searchAction(model, actions.mActions[0], alpha, beta, depth);
+    return searchActions(model, actions, 0, phase.mTurn == mRootPlayer? kMinValue: kMaxValue, alpha, beta, depth);
+}
+
+double Expectiminimax::searchActions(
+    GameOfUrModel& model, const ActionList& actions, uint8_t firstAction, double best, double alpha, double beta, uint8_t depth
+) {
+    const bool maximising { model.getCurrentPhase().mTurn == mRootPlayer };
+    for(uint8_t action { firstAction }; action < actions.mSize && alpha < beta; ++action) {
+        const double value { searchAction(model, actions.mActions[action], alpha, beta, depth) };
+        if(maximising) {
+            best = std::max(best, value);
+            alpha = std::max(alpha, value);
+        } else {
+            best = std::min(best, value);
+            beta = std::min(beta, value);
+        }
+    }
+    return best;
+}
+
+double Expectiminimax::searchAction(GameOfUrModel& model, const SearchAction& action, double alpha, double beta, uint8_t depth) {
+    switch(action.mType) {
+        case SearchAction::Type::DICE_ROLL:
+            return searchChance(model, alpha, beta, depth);
+
+        case SearchAction::Type::LAUNCH:
+        case SearchAction::Type::BOARD_MOVE: {
+            const UndoRecord undoRecord { model.applyMove(action.mPiece, action.mLocation) };
+            const double value { searchNode(model, alpha, beta, depth) };
+            model.undoMove(undoRecord);
+            return value;
+        }
+
+        case SearchAction::Type::NEXT_TURN: {
+            const UndoRecord undoRecord { model.applyTurnAdvance() };
+            const double value { searchNode(model, alpha, beta, depth) };
+            model.undoTurnAdvance(undoRecord);
+            return value;
+        }
+
+        case SearchAction::Type::NONE:
+            break;
+    }
+    return evaluate(model, mRootPlayer);
+}
+
+double Expectiminimax::searchChance(GameOfUrModel& model, double alpha, double beta, uint8_t depth) {
+    if(!visitNode()) return kMinValue;
+    if(depth == 0) return evaluate(model, mRootPlayer);
+
+    const Dice::OutcomeList outcomes { model.getDiceRollOutcomes() };
+    assert(!outcomes.empty() && "A roll of the dice has at least one outcome");
+
+    if(mPruning == NONE) {
+        double value { 0.0 };
+        for(const Dice::Outcome& outcome: outcomes) {
+            const UndoRecord undoRecord { model.applyDiceOutcome(outcome) };
+            value += outcome.mProbability * searchNode(model, kMinValue, kMaxValue, depth - 1);
+            model.undoDiceRoll(undoRecord);
+        }
+        return value;
+    }
+
+    std::array<double, Dice::OutcomeList::kCapacity> lower {};
+    std::array<double, Dice::OutcomeList::kCapacity> upper {};
+    lower.fill(kMinValue);
+    upper.fill(kMaxValue);
+
+    // the roller decides what follows every outcome, and so the first action
+    // of that decision bounds its value from the roller's side
+    const bool maximising { model.getCurrentPhase().mTurn == mRootPlayer };
+    if(mPruning == STAR2) {
+        double probed { 0.0 };
+        double remaining { 1.0 };
+        for(std::size_t outcome { 0 }; outcome < outcomes.size(); ++outcome) {
+            const double probability { outcomes[outcome].mProbability };
+            remaining -= probability;
+            const UndoRecord undoRecord { model.applyDiceOutcome(outcomes[outcome]) };
+            if(maximising) {
+                const double bound { (beta - probed - remaining * kMinValue) / probability };
+                lower[outcome] = probe(model, kMinValue, std::min(bound, kMaxValue), depth - 1);
+                probed += probability * lower[outcome];
+            } else {
+                const double bound { (alpha - probed - remaining * kMaxValue) / probability };
+                upper[outcome] = probe(model, std::max(bound, kMinValue), kMaxValue, depth - 1);
+                probed += probability * upper[outcome];
+            }
+            model.undoDiceRoll(undoRecord);
+
+            if(maximising && probed + remaining * kMinValue >= beta) {
+                ++mResult.mChanceCutoffs;
+                ++mResult.mProbeCutoffs;
+                return probed + remaining * kMinValue;
+            }
+            if(!maximising && probed + remaining * kMaxValue <= alpha) {
+                ++mResult.mChanceCutoffs;
+                ++mResult.mProbeCutoffs;
+                return probed + remaining * kMaxValue;
+            }
+        }
+    }
+
+    double searched { 0.0 };
+    double lowerRemaining { 0.0 };
+    double upperRemaining { 0.0 };
+    for(std::size_t outcome { 0 }; outcome < outcomes.size(); ++outcome) {
+        lowerRemaining += outcomes[outcome].mProbability * lower[outcome];
+        upperRemaining += outcomes[outcome].mProbability * upper[outcome];
+    }
+    for(std::size_t outcome { 0 }; outcome < outcomes.size(); ++outcome) {
+        const double probability { outcomes[outcome].mProbability };
+        lowerRemaining -= probability * lower[outcome];
+        upperRemaining -= probability * upper[outcome];
+
+        // the window outside which this outcome's value puts the whole roll
+        // outside its own
+        const double outcomeAlpha { (alpha - searched - upperRemaining) / probability };
+        const double outcomeBeta { (beta - searched - lowerRemaining) / probability };
+
+        double value {};
+        if(lower[outcome] >= outcomeBeta) value = lower[outcome];
+        else if(upper[outcome] <= outcomeAlpha) value = upper[outcome];
+        else if(lower[outcome] >= upper[outcome]) value = lower[outcome];
+        else {
+            const double outcomeLower { std::max(outcomeAlpha, lower[outcome]) };
+            const double outcomeUpper { std::min(outcomeBeta, upper[outcome]) };
+            const UndoRecord undoRecord { model.applyDiceOutcome(outcomes[outcome]) };
+            value = mPruning == STAR2?
+                searchProbed(model, maximising? lower[outcome]: upper[outcome], outcomeLower, outcomeUpper, depth - 1):
+                searchNode(model, outcomeLower, outcomeUpper, depth - 1);
+            model.undoDiceRoll(undoRecord);
+        }
+
+        if(value <= outcomeAlpha) {
+            ++mResult.mChanceCutoffs;
+            return searched + probability * value + upperRemaining;
+        }
+        if(value >= outcomeBeta) {
+            ++mResult.mChanceCutoffs;
+            return searched + probability * value + lowerRemaining;
+        }
+        searched += probability * value;
+    }
+    return searched;
+}
+
+double Expectiminimax::probe(GameOfUrModel& model, double alpha, double beta, uint8_t depth) {
+    if(!visitNode()) return kMinValue;
+    if(model.getCurrentPhase().mGamePhase == GamePhase::END) return evaluate(model, mRootPlayer);
+
+    const ActionList actions { getOrderedActions(model) };
+    if(actions.mSize == 0) return evaluate(model, mRootPlayer);
+    return searchAction(model, actions.mActions[0], alpha, beta, depth);
+}
+
+double Expectiminimax::searchProbed(GameOfUrModel& model, double probed, double alpha, double beta, uint8_t depth) {
+    if(!visitNode()) return kMinValue;
+    if(model.getCurrentPhase().mGamePhase == GamePhase::END) return probed;
+
+    // the probe was searched with a window no narrower on the roller's side,
+    // and so values the first action exactly unless it already cut the roll off
+    const ActionList actions { getOrderedActions(model) };
+    if(actions.mSize <= 1) return probed;
+    return searchActions(model, actions, 1, probed, alpha, beta, depth);
+}
@@ -0,0 +1,335 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/expectiminimax.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a depth-limited expectiminimax search over the actions and dice rolls of a game, pruning chance nodes with the Star1 and Star2 algorithms.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPEXPECTIMINIMAX_H
+#define ZOAPPEXPECTIMINIMAX_H
+
+#include <cstdint>
+#include <array>
+#include <chrono>
+
+#include "model.hpp"
+#include "move_list.hpp"
+#include "search_action.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The choice made by a single run of Expectiminimax::search(), along with statistics describing the run.
+ * 
+ */
+struct ExpectiminimaxResult {
+    /**
+     * @brief The best action found for the player whose turn it is.
+     * 
+     */
+    SearchAction mAction;
+
+    /**
+     * @brief The value of the best action to the player, between Expectiminimax::kMinValue and Expectiminimax::kMaxValue.
+     * 
+     */
+    double mValue;
+
+    /**
+     * @brief The number of rolls of the dice looked ahead.
+     * 
+     */
+    uint8_t mDepth;
+
+    /**
+     * @brief The number of states visited, counting decision nodes, chance nodes, and leaves.
+     * 
+     */
+    uint64_t mNodes;
+
+    /**
+     * @brief The number of chance nodes cut off before all their outcomes were searched.
+     * 
+     */
+    uint64_t mChanceCutoffs;
+
+    /**
+     * @brief The number of chance nodes cut off by probing alone, before any outcome was searched in full.
+     * 
+     */
+    uint64_t mProbeCutoffs;
+
+    /**
+     * @brief Whether the search finished before its deadline.  The action and value of a search cut short are only the best guess of the actions searched before it was.
+     * 
+     */
+    bool mCompleted;
+
+    /**
+     * @brief The time taken by the run, in seconds.
+     * 
+     */
+    double mSeconds;
+
+    /**
+     * @brief Gets the rate at which states were visited.
+     * 
+     * @return double The number of states visited per second.
+     */
+    double getNodesPerSecond() const { return mSeconds > 0.0? mNodes / mSeconds: 0.0; }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief Chooses actions by searching the tree of a game's actions and dice rolls to a fixed depth, assuming that both players play to maximise their own value.
+ * 
+ * The player whose turn it is at the root maximises, and their opponent minimises, at every decision node: choosing between the moves available, rolling the secondary die in place of moving, and ending the turn.  Every roll of the dice is a chance node, whose value is the average of its outcomes weighed by their probabilities, as listed by GameOfUrModel::getDiceRollOutcomes().  Depth is counted in rolls of the dice, and a chance node with no depth left is valued by evaluate() instead of being expanded.
+ * 
+ * The value of a game that has ended is getWinWeight() for a win plus the rest of 1 in proportion to the counters the root player holds, as for Solver.  Any other state is valued by estimating the root player's chance of winning from how far along their route each player's pieces are, and by granting them that share of the common pool.  Values thus always lie between kMinValue and kMaxValue.
+ * 
+ * Decision nodes are searched with alpha-beta pruning.  Since values are bounded, the outcomes of a chance node still to be searched bound its value too, and Star1 stops searching its outcomes as soon as those bounds put the node's value outside the window it is searched with.  Star2 first probes every outcome by searching only the first action of the decision that follows it, which bounds the outcome's value from the side of the player deciding, and so may cut the chance node off before any outcome is searched in full, and otherwise tightens the bounds Star1 works with, without the action probed being searched again.  Actions are ordered by the value evaluate() gives the state they lead to, so that the first action probed is likely the best.  Neither algorithm changes the value found at the root.
+ * 
+ * Searches make and unmake actions on a copy of the game, and so leave the game searched untouched.  A search may be given a deadline, past which it is abandoned and returns the best root action among those fully searched so far, as for IterativeDeepening.
+ * 
+ */
+class Expectiminimax {
+public:
+    /**
+     * @brief The chance node pruning algorithms a search may use.
+     * 
+     */
+    enum Pruning: uint8_t {
+        NONE, //< Every outcome of every chance node is searched with the widest window.
+        STAR1, //< Outcomes are searched with windows narrowed by the bounds of the outcomes left, stopping once the node's value is known to lie outside its window.
+        STAR2, //< As STAR1, with every outcome first probed to tighten those bounds.
+    };
+
+    /**
+     * @brief The lowest value of any state, that of a game lost with no counters held.
+     * 
+     */
+    static constexpr double kMinValue { 0.0 };
+
+    /**
+     * @brief The highest value of any state, that of a game won with every counter held.
+     * 
+     */
+    static constexpr double kMaxValue { 1.0 };
+
+    /**
+     * @brief The share of a game's value given to winning it, unless another is asked for.
+     * 
+     */
+    static constexpr double kDefaultWinWeight { 0.5 };
+
+    /**
+     * @brief Creates a search.
+     * 
+     * @param winWeight The share of a game's value given to winning it, between 0 and 1, with the rest given to the counters held at its end.
+     * @param pruning The algorithm used to prune chance nodes.
+     */
+    explicit Expectiminimax(double winWeight=kDefaultWinWeight, Pruning pruning=STAR2);
+
+    /**
+     * @brief Gets the share of a game's value given to winning it.
+     * 
+     * @return double The win weight, between 0 and 1.
+     */
+    double getWinWeight() const { return mWinWeight; }
+
+    /**
+     * @brief Gets the algorithm used to prune chance nodes.
+     * 
+     * @return Pruning The pruning algorithm.
+     */
+    Pruning getPruning() const { return mPruning; }
+
+    /**
+     * @brief Searches a game for the best action of the player whose turn it is.
+     * 
+     * @param model The game searched, which is left unchanged.
+     * @param depth The number of rolls of the dice looked ahead.
+     * @param deadline The time by which the search is abandoned if it hasn't finished.
+     * @return ExpectiminimaxResult The best action found, along with statistics describing the search.
+     */
+    ExpectiminimaxResult search(
+        const GameOfUrModel& model, uint8_t depth,
+        std::chrono::steady_clock::time_point deadline=std::chrono::steady_clock::time_point::max()
+    );
+
+    /**
+     * @brief Estimates the value of a game to one of its players without searching it.
+     * 
+     * @param model The game evaluated.
+     * @param player The player the game is valued for.
+     * @return double The value of the game to the player, between kMinValue and kMaxValue.
+     */
+    double evaluate(const GameOfUrModel& model, PlayerID player) const;
+
+private:
+    /**
+     * @brief The largest number of actions open to a player at once: every move, rolling the dice, and ending the turn.
+     * 
+     */
+    static constexpr uint8_t kMaxActions { MoveList::kCapacity + 2 };
+
+    /**
+     * @brief The number of states visited between readings of the clock, which costs more than visiting a state.
+     * 
+     */
+    static constexpr uint64_t kDeadlineCheckInterval { 256 };
+
+    /**
+     * @brief The actions open to a player, in the order they are searched.
+     * 
+     */
+    struct ActionList {
+        /**
+         * @brief Storage for the actions, of which only the first mSize are meaningful.
+         * 
+         */
+        std::array<SearchAction, kMaxActions> mActions;
+
+        /**
+         * @brief The value evaluate() gives the state each action leads to, by which the actions are ordered.
+         * 
+         */
+        std::array<double, kMaxActions> mScores;
+
+        /**
+         * @brief The number of actions in the list.
+         * 
+         */
+        uint8_t mSize;
+    };
+
+    /**
+     * @brief Lists the actions open to the player whose turn it is, best first by the value evaluate() gives the state each leads to.
+     * 
+     * @param model The game, which is restored before returning.
+     * @return ActionList The actions, in the order they are to be searched.
+     */
+    ActionList getOrderedActions(GameOfUrModel& model) const;
+
+    /**
+     * @brief Counts a visit to a state, and checks now and then whether the deadline of the current search has passed.
+     * 
+     * @retval true The search goes on.
+     * @retval false The search has been abandoned, and every search function returns at once without meaningful values.
+     */
+    bool visitNode();
+
+    /**
+     * @brief Gets the value of a state to the root player, searched within a window.
+     * 
+     * @param model The game at the state, which is restored before returning.
+     * @param alpha The value the root player is already assured of elsewhere.
+     * @param beta The value their opponent is already assured of elsewhere.
+     * @param depth The number of rolls of the dice left to look ahead.
+     * @return double The value of the state if it lies within the window, and otherwise a bound on it lying outside the window.
+     */
+    double searchNode(GameOfUrModel& model, double alpha, double beta, uint8_t depth);
+
+    /**
+     * @brief Searches the actions of a decision with alpha-beta pruning, from some action onwards.
+     * 
+     * @param model The game at the decision, which is restored before returning.
+     * @param actions The actions open to the player deciding, as listed by getOrderedActions().
+     * @param firstAction The first action searched, those before it having been searched already.
+     * @param best The best value found among the actions before the first searched, for the player deciding.
+     * @param alpha The value the root player is already assured of elsewhere.
+     * @param beta The value their opponent is already assured of elsewhere.
+     * @param depth The number of rolls of the dice left to look ahead.
+     * @return double The value of the decision, as for searchNode().
+     */
+    double searchActions(
+        GameOfUrModel& model, const ActionList& actions, uint8_t firstAction, double best, double alpha, double beta, uint8_t depth
+    );
+
+    /**
+     * @brief Gets the value of an action to the root player, searched within a window.
+     * 
+     * @param model The game before the action, which is restored before returning.
+     * @param action An action open to the player whose turn it is.
+     * @param alpha The value the root player is already assured of elsewhere.
+     * @param beta The value their opponent is already assured of elsewhere.
+     * @param depth The number of rolls of the dice left to look ahead.
+     * @return double The value of the state the action leads to, as for searchNode().
+     */
+    double searchAction(GameOfUrModel& model, const SearchAction& action, double alpha, double beta, uint8_t depth);
+
+    /**
+     * @brief Gets the value of a roll of the dice to the root player, searched within a window.
+     * 
+     * @param model The game before the roll, which is restored before returning.
+     * @param alpha The value the root player is already assured of elsewhere.
+     * @param beta The value their opponent is already assured of elsewhere.
+     * @param depth The number of rolls of the dice left to look ahead, including this one.
+     * @return double The value of the roll, as for searchNode().
+     */
+    double searchChance(GameOfUrModel& model, double alpha, double beta, uint8_t depth);
+
+    /**
+     * @brief Gets the value to the root player of the first action of the decision following an outcome of the dice, which bounds the value of the decision from the side of the player deciding.
+     * 
+     * @param model The game after the outcome, which is restored before returning.
+     * @param alpha The value the root player is already assured of elsewhere.
+     * @param beta The value their opponent is already assured of elsewhere.
+     * @param depth The number of rolls of the dice left to look ahead.
+     * @return double The value of the first action, as for searchNode().
+     */
+    double probe(GameOfUrModel& model, double alpha, double beta, uint8_t depth);
+
+    /**
+     * @brief Gets the value to the root player of a decision following an outcome of the dice whose first action has been probed, without searching that action again.
+     * 
+     * @param model The game after the outcome, which is restored before returning.
+     * @param probed The value probe() gave the first action, which is exact within the window searched.
+     * @param alpha The value the root player is already assured of elsewhere.
+     * @param beta The value their opponent is already assured of elsewhere.
+     * @param depth The number of rolls of the dice left to look ahead.
+     * @return double The value of the decision, as for searchNode().
+     */
+    double searchProbed(GameOfUrModel& model, double probed, double alpha, double beta, uint8_t depth);
+
+    /**
+     * @brief The share of a game's value given to winning it.
+     * 
+     */
+    double mWinWeight;
+
+    /**
+     * @brief The algorithm used to prune chance nodes.
+     * 
+     */
+    Pruning mPruning;
+
+    /**
+     * @brief The player whose turn it is at the root of the current search, for whom values are given.
+     * 
+     */
+    PlayerID mRootPlayer { PlayerID::PLAYER_A };
+
+    /**
+     * @brief The statistics of the current search.
+     * 
+     */
+    ExpectiminimaxResult mResult {};
+
+    /**
+     * @brief The time by which the current search is abandoned.
+     * 
+     */
+    std::chrono::steady_clock::time_point mDeadline {};
+
+    /**
+     * @brief Whether the current search has been abandoned.
+     * 
+     */
+    bool mAbandoned { false };
+};
+
+#endif
@@ -0,0 +1,507 @@
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "game_batch.hpp"
+#include "model.hpp"
+#include "ruleset.hpp"
+
+// Kernels are written once, over a type holding one 32-bit value per lane.
+// With GCC-compatible compilers on x86, that type may be a vector, and the
+// kernel is then compiled for SSE4.1 and AVX2 as well, chosen between at
+// runtime.  Every helper must be inlined into those kernels, so that none of
+// it is compiled for the baseline instruction set alone.
+#if defined(__GNUC__)
+    #define ZOAPP_LANE_INLINE [[gnu::always_inline]] inline
+#else
+    #define ZOAPP_LANE_INLINE inline
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define ZOAPP_GAME_BATCH_X86
+    // vectors never cross a call boundary, as every helper is inlined
+    #pragma GCC diagnostic ignored "-Wpsabi"
+    typedef uint32_t SSELanes __attribute__((vector_size(16)));
+    typedef uint32_t AVX2Lanes __attribute__((vector_size(32)));
+#endif
+
+template <typename TLanes>
+struct GameBatch::LaneKernel {
+    /**
+     * @brief The number of lanes processed at once.
+     * 
+     */
+    static constexpr std::size_t kWidth { sizeof(TLanes) / sizeof(uint32_t) };
+
+    ZOAPP_LANE_INLINE static TLanes load(const std::vector<uint32_t>& values, std::size_t lane) {
+        TLanes lanes;
+        std::memcpy(&lanes, values.data() + lane, sizeof(TLanes));
+        return lanes;
+    }
+
+    ZOAPP_LANE_INLINE static void store(std::vector<uint32_t>& values, std::size_t lane, TLanes lanes) {
+        std::memcpy(values.data() + lane, &lanes, sizeof(TLanes));
+    }
+
+    ZOAPP_LANE_INLINE static TLanes broadcast(uint32_t value) { return TLanes {} + value; }
+
+    // comparisons produce bools for scalars and all-ones lanes for vectors;
+    // either becomes an all-ones mask here
+    template <typename TComparison>
+    ZOAPP_LANE_INLINE static TLanes mask(TComparison comparison) {
+        if constexpr(std::is_same_v<TComparison, bool>) {
+            return TLanes { 0 } - static_cast<TLanes>(comparison);
+        } else {
+            return (TLanes)comparison;
+        }
+    }
+
+    ZOAPP_LANE_INLINE static TLanes select(TLanes laneMask, TLanes ifSet, TLanes ifClear) {
+        return (ifSet & laneMask) | (ifClear & ~laneMask);
+    }
+
+    ZOAPP_LANE_INLINE static TLanes minimum(TLanes one, TLanes two) { return select(mask(one < two), one, two); }
+
+    ZOAPP_LANE_INLINE static bool any(TLanes lanes) {
+        if constexpr(std::is_integral_v<TLanes>) {
+            return lanes != 0;
+        } else {
+            TLanes combined { lanes[0] };
+            for(std::size_t lane { 1 }; lane < kWidth; ++lane) combined |= lanes[lane];
+            return combined[0] != 0;
+        }
+    }
+
+    // lowbias32, a well distributed 32-bit integer hash
+    ZOAPP_LANE_INLINE static TLanes mix(TLanes value) {
+        value ^= value >> 16;
+        value *= 0x7FEB352Du;
+        value ^= value >> 15;
+        value *= 0x846CA68Bu;
+        return value ^ (value >> 16);
+    }
+
+    // matches RouteTable::isRosettePosition()
+    ZOAPP_LANE_INLINE static TLanes isRosette(TLanes routePosition) {
+        return (
+            mask(routePosition < RouteTable::kRouteEnd)
+            & mask((routePosition % kUrRuleset.mRosetteSpacing) == kUrRuleset.mRosetteSpacing - 1u)
+        );
+    }
+
+    // the slots of the houses an opponent's piece is safe on, the rosettes of
+    // the battlefield, where route positions mean the same house for both roles
+    static constexpr uint32_t kShelterSlots {
+        [] {
+            uint32_t shelterSlots { 0 };
+            for(uint8_t position { kUrRuleset.getRegionLength() }; position < RouteTable::kRouteEnd; ++position) {
+                if(RouteTable::isRosettePosition(position)) shelterSlots |= 1u << (position + 1u);
+            }
+            return shelterSlots;
+        }()
+    };
+
+    // one bit for each slot no piece of the mover may move to: those occupied
+    // by its own pieces and those sheltering an opponent's piece, as
+    // Board::getDestinationMask() describes.  The end of the route is never
+    // blocked
+    ZOAPP_LANE_INLINE static TLanes getBlockedSlots(
+        const std::array<TLanes, PieceTypeID::TOTAL>& ownSlots,
+        const std::array<TLanes, PieceTypeID::TOTAL>& opponentSlots
+    ) {
+        TLanes ownOccupied { 0 };
+        TLanes opponentOccupied { 0 };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            ownOccupied |= broadcast(1) << ownSlots[type];
+            opponentOccupied |= broadcast(1) << opponentSlots[type];
+        }
+        return (ownOccupied & ~(1u << kFinishedSlot)) | (opponentOccupied & kShelterSlots);
+    }
+
+    /**
+     * @brief The move chosen in each lane, built up one candidate at a time.
+     * 
+     */
+    struct ChosenMove {
+        /**
+         * @brief The number of legal moves yet to be passed over before the chosen one is reached.
+         * 
+         */
+        TLanes mRemainingMoves;
+
+        /**
+         * @brief A mask, set in lanes where a move has been chosen.
+         * 
+         */
+        TLanes mIsMoving { 0 };
+
+        /**
+         * @brief The type of the piece moved.
+         * 
+         */
+        TLanes mType { 0 };
+
+        /**
+         * @brief The slot of the piece before it is moved.
+         * 
+         */
+        TLanes mFromSlot { 0 };
+
+        /**
+         * @brief The route position the piece is moved to.
+         * 
+         */
+        TLanes mDestination { 0 };
+
+        /**
+         * @brief The cost of the piece moved.
+         * 
+         */
+        TLanes mCost { 0 };
+    };
+
+    // whether a move candidate is legal in each lane, along with where it
+    // ends.  Candidates are compile-time constants, leaving no branches here
+    template <std::size_t kCandidateIndex>
+    ZOAPP_LANE_INLINE static TLanes findMove(
+        const std::array<TLanes, PieceTypeID::TOTAL>& ownSlots,
+        TLanes blockedSlots,
+        TLanes roll,
+        TLanes& destination
+    ) {
+        constexpr MoveCandidate kCandidate { kMoveCandidates[kCandidateIndex] };
+        const TLanes slot { ownSlots[kCandidate.mType] };
+        TLanes isPossible {
+            mask(slot == kUnlaunchedSlot)
+            & mask(roll == kGamePieceTypes[kCandidate.mType].mLaunchRoll)
+        };
+
+        destination = broadcast(kCandidate.mLaunchPosition);
+        if constexpr(!kCandidate.mIsLaunchOnly) {
+            // unlaunched pieces wrap around to the largest value here.  A
+            // roll of 0 leaves a piece on its own slot, which is blocked
+            const TLanes isOnBoard { mask((slot - 1u) < RouteTable::kRouteEnd) };
+            const TLanes boardDestination { slot - 1u + roll };
+            destination = select(isOnBoard, boardDestination, destination);
+            isPossible |= isOnBoard & mask(boardDestination <= RouteTable::kRouteEnd);
+        }
+        return isPossible & mask(((blockedSlots >> (destination + 1u)) & 1u) == 0u);
+    }
+
+    template <std::size_t kCandidateIndex>
+    ZOAPP_LANE_INLINE static TLanes countMove(
+        const std::array<TLanes, PieceTypeID::TOTAL>& ownSlots,
+        TLanes blockedSlots,
+        TLanes roll
+    ) {
+        TLanes destination;
+        return findMove<kCandidateIndex>(ownSlots, blockedSlots, roll, destination) & 1u;
+    }
+
+    // moves are found again whenever they are needed rather than stored, as
+    // every candidate's results together would not fit in registers
+    template <std::size_t... kCandidateIndices>
+    ZOAPP_LANE_INLINE static TLanes countMoves(
+        const std::array<TLanes, PieceTypeID::TOTAL>& ownSlots,
+        TLanes blockedSlots,
+        TLanes roll,
+        std::index_sequence<kCandidateIndices...>
+    ) {
+        return (countMove<kCandidateIndices>(ownSlots, blockedSlots, roll) + ...);
+    }
+
+    template <std::size_t kCandidateIndex>
+    ZOAPP_LANE_INLINE static void chooseMove(
+        const std::array<TLanes, PieceTypeID::TOTAL>& ownSlots,
+        TLanes blockedSlots,
+        TLanes roll,
+        ChosenMove& chosenMove
+    ) {
+        constexpr PieceTypeID kType { kMoveCandidates[kCandidateIndex].mType };
+        TLanes destination;
+        const TLanes isPossible { findMove<kCandidateIndex>(ownSlots, blockedSlots, roll, destination) };
+        const TLanes isChosen { isPossible & mask(chosenMove.mRemainingMoves == 0u) };
+        chosenMove.mIsMoving |= isChosen;
+        chosenMove.mType = select(isChosen, broadcast(kType), chosenMove.mType);
+        chosenMove.mFromSlot = select(isChosen, ownSlots[kType], chosenMove.mFromSlot);
+        chosenMove.mDestination = select(isChosen, destination, chosenMove.mDestination);
+        chosenMove.mCost = select(isChosen, broadcast(kGamePieceTypes[kType].mCost), chosenMove.mCost);
+        chosenMove.mRemainingMoves -= isPossible & 1u;
+    }
+
+    template <std::size_t... kCandidateIndices>
+    ZOAPP_LANE_INLINE static void chooseMoves(
+        const std::array<TLanes, PieceTypeID::TOTAL>& ownSlots,
+        TLanes blockedSlots,
+        TLanes roll,
+        ChosenMove& chosenMove,
+        std::index_sequence<kCandidateIndices...>
+    ) {
+        (chooseMove<kCandidateIndices>(ownSlots, blockedSlots, roll, chosenMove), ...);
+    }
+
+    static constexpr std::make_index_sequence<MoveList::kCapacity> kCandidateIndices {};
+
+    static std::size_t playTurns(GameBatch& batch, uint32_t nTurns);
+};
+
+template <typename TLanes>
+ZOAPP_LANE_INLINE std::size_t GameBatch::LaneKernel<TLanes>::playTurns(GameBatch& batch, uint32_t nTurns) {
+    std::size_t nInProgress { 0 };
+    for(std::size_t lane { 0 }; lane < batch.mNLanes; lane += kWidth) {
+        // keep this block of games in registers for as many turns as it lasts
+        std::array<std::array<TLanes, PieceTypeID::TOTAL>, 2> slots;
+        std::array<TLanes, 2> counters;
+        for(uint8_t role { 0 }; role < 2; ++role) {
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                slots[role][type] = load(batch.mPieceSlots[role][type], lane);
+            }
+            counters[role] = load(batch.mCounters[role], lane);
+        }
+        TLanes poolCounters { load(batch.mPoolCounters, lane) };
+        TLanes turns { load(batch.mTurns, lane) };
+        TLanes winners { load(batch.mWinners, lane) };
+        TLanes nTurnsPlayed { load(batch.mNTurns, lane) };
+        const TLanes keys { load(batch.mKeys, lane) };
+
+        for(uint32_t turn { 0 }; turn < nTurns; ++turn) {
+            const TLanes inProgress { mask(winners == static_cast<uint32_t>(RoleID::NA)) };
+            if(!any(inProgress)) break;
+
+            // every lane draws two values a turn, whether or not it uses them
+            const uint32_t drawCounter { batch.mDrawCounter + 2 * turn };
+            const TLanes primaryDraw { mix(keys ^ mix(broadcast(drawCounter))) };
+            const TLanes secondaryDraw { mix(keys ^ mix(broadcast(drawCounter + 1))) };
+
+            const TLanes isWhite { mask(turns != 0u) };
+            std::array<TLanes, PieceTypeID::TOTAL> ownSlots;
+            std::array<TLanes, PieceTypeID::TOTAL> opponentSlots;
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                ownSlots[type] = select(isWhite, slots[1][type], slots[0][type]);
+                opponentSlots[type] = select(isWhite, slots[0][type], slots[1][type]);
+            }
+            TLanes ownCounters { select(isWhite, counters[1], counters[0]) };
+            const TLanes blockedSlots { getBlockedSlots(ownSlots, opponentSlots) };
+
+            // after the primary roll, the player picks between rolling the
+            // secondary die (choice 0) and each of the moves available
+            const TLanes primaryRoll { (primaryDraw >> 30) + 1u };
+            const TLanes primaryChoice { ((primaryDraw & 0xFFFFFFu) * (countMoves(ownSlots, blockedSlots, primaryRoll, kCandidateIndices) + 1u)) >> 24 };
+            const TLanes rollsSecondary { mask(primaryChoice == 0u) };
+
+            // a double upgrades the primary roll as Dice does, while quits
+            // scores nothing
+            const TLanes isDouble { mask(((primaryDraw >> 29) & 1u) != 0u) };
+            const TLanes secondaryRoll { select(isDouble, select(mask(primaryRoll == 4u), broadcast(10), primaryRoll + 4u), broadcast(0)) };
+            const TLanes roll { select(rollsSecondary, secondaryRoll, primaryRoll) };
+            const TLanes secondaryChoice { ((secondaryDraw & 0xFFFFFFu) * countMoves(ownSlots, blockedSlots, roll, kCandidateIndices)) >> 24 };
+
+            // find the chosen move, if any
+            ChosenMove chosenMove { .mRemainingMoves { select(rollsSecondary, secondaryChoice, primaryChoice - 1u) } };
+            chooseMoves(ownSlots, blockedSlots, roll, chosenMove, kCandidateIndices);
+            const TLanes isMoving { chosenMove.mIsMoving & inProgress };
+            const TLanes destination { chosenMove.mDestination };
+            const TLanes movedType { chosenMove.mType };
+            const TLanes fromSlot { chosenMove.mFromSlot };
+            const TLanes cost { chosenMove.mCost };
+
+            TLanes nFinishedPieces { 0 };
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                nFinishedPieces += mask(ownSlots[type] == kFinishedSlot) & 1u;
+            }
+
+            // launches pass no rosettes, and their starting position wraps
+            // around to the largest value, which no rosette lies beyond
+            const TLanes fromPosition { fromSlot - 1u };
+            TLanes passesRosette { 0 };
+            for(uint8_t position { 0 }; position < RouteTable::kRouteEnd; ++position) {
+                if(!RouteTable::isRosettePosition(position)) continue;
+                passesRosette |= mask(fromPosition < position) & mask(position < destination);
+            }
+            const TLanes landsOnRosette { isRosette(destination) };
+            const TLanes completesRoute { mask(destination == RouteTable::kRouteEnd) };
+            const TLanes endsGame { isMoving & completesRoute & mask(nFinishedPieces == PieceTypeID::TOTAL - 1u) };
+
+            // counters change hands as in GameOfUrModel::makeMoveResult()
+            const TLanes countersLost { isMoving & passesRosette & ~landsOnRosette & ~completesRoute & minimum(cost, ownCounters) };
+            const TLanes countersWon {
+                isMoving & select(landsOnRosette, minimum(cost, poolCounters), endsGame & poolCounters)
+            };
+            ownCounters = ownCounters - countersLost + countersWon;
+            poolCounters = poolCounters + countersLost - countersWon;
+
+            // move the piece, sending home any opponent piece it lands on
+            const TLanes destinationSlot { destination + 1u };
+            const TLanes captures {
+                isMoving
+                & mask(destination >= kUrRuleset.getRegionLength())
+                & mask(destination < RouteTable::kRouteEnd)
+            };
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                ownSlots[type] = select(isMoving & mask(movedType == type), destinationSlot, ownSlots[type]);
+                opponentSlots[type] = select(captures & mask(opponentSlots[type] == destinationSlot), broadcast(kUnlaunchedSlot), opponentSlots[type]);
+            }
+
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                slots[0][type] = select(isWhite, opponentSlots[type], ownSlots[type]);
+                slots[1][type] = select(isWhite, ownSlots[type], opponentSlots[type]);
+            }
+            counters[0] = select(isWhite, counters[0], ownCounters);
+            counters[1] = select(isWhite, ownCounters, counters[1]);
+
+            winners = select(endsGame, turns + static_cast<uint32_t>(RoleID::BLACK), winners);
+            nTurnsPlayed += inProgress & 1u;
+            turns ^= inProgress & ~endsGame & 1u;
+        }
+
+        for(uint8_t role { 0 }; role < 2; ++role) {
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                store(batch.mPieceSlots[role][type], lane, slots[role][type]);
+            }
+            store(batch.mCounters[role], lane, counters[role]);
+        }
+        store(batch.mPoolCounters, lane, poolCounters);
+        store(batch.mTurns, lane, turns);
+        store(batch.mWinners, lane, winners);
+        store(batch.mNTurns, lane, nTurnsPlayed);
+    }
+
+    for(std::size_t game { 0 }; game < batch.mNGames; ++game) {
+        nInProgress += batch.mWinners[game] == RoleID::NA;
+    }
+    return nInProgress;
+}
+
+GameBatch::GameBatch(std::size_t nGames, RandomEngine randomEngine):
+    mNGames { nGames },
+    mNLanes { (nGames + kMaxLaneWidth - 1) / kMaxLaneWidth * kMaxLaneWidth }
+{
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        for(auto& typeSlots: mPieceSlots[role]) typeSlots.resize(mNLanes);
+        mCounters[role].resize(mNLanes);
+    }
+    mPoolCounters.resize(mNLanes);
+    mTurns.resize(mNLanes);
+    mWinners.resize(mNLanes);
+    mNTurns.resize(mNLanes);
+
+    // hashing distinct lane indices keeps every lane's key distinct
+    mKeys.resize(mNLanes);
+    const uint32_t baseKey { static_cast<uint32_t>(randomEngine() >> 32) };
+    for(std::size_t lane { 0 }; lane < mNLanes; ++lane) {
+        mKeys[lane] = LaneKernel<uint32_t>::mix(baseKey + static_cast<uint32_t>(lane));
+        resetGame(lane);
+    }
+}
+
+void GameBatch::resetGame(std::size_t game) {
+    assert(game < mNLanes && "Game index out of range");
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        for(auto& typeSlots: mPieceSlots[role]) typeSlots[game] = kUnlaunchedSlot;
+        mCounters[role][game] = kUrRuleset.mStartingCounters - kUrRuleset.mStake;
+    }
+    mPoolCounters[game] = 2 * kUrRuleset.mStake;
+    mTurns[game] = 0;
+    mWinners[game] = RoleID::NA;
+    mNTurns[game] = 0;
+}
+
+void GameBatch::loadGame(std::size_t game, const GameOfUrModel& model) {
+    assert(game < mNGames && "Game index out of range");
+    const GamePhaseData phase { model.getCurrentPhase() };
+    assert(phase.mGamePhase != GamePhase::INITIATIVE && "Only games past the initiative phase can be loaded into a batch");
+    assert(
+        (phase.mGamePhase == GamePhase::END || phase.mTurnPhase != TurnPhase::MOVE_PIECE)
+        && "Games can only be loaded between turns"
+    );
+
+    const GamePosition position { model.getPosition() };
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const GamePosition::PiecePlacement& piece { position.mPieces[role][type] };
+            mPieceSlots[role][type][game] = (
+                piece.mState == Piece::State::UNLAUNCHED? kUnlaunchedSlot:
+                piece.mState == Piece::State::FINISHED? kFinishedSlot:
+                piece.mRoutePosition + 1u
+            );
+        }
+        mCounters[role][game] = model.getPlayerData(static_cast<RoleID>(role + 1)).mCounters;
+    }
+    mPoolCounters[game] = model.getScore().mCommonPoolCounters;
+
+    // a turn that has ended belongs, in effect, to the next player
+    const bool turnEnded { phase.mGamePhase == GamePhase::PLAY && phase.mTurnPhase == TurnPhase::END };
+    mTurns[game] = (position.mTurn == RoleID::WHITE) != turnEnded;
+    mWinners[game] = phase.mWinner;
+    mNTurns[game] = 0;
+}
+
+std::size_t GameBatch::playTurns(uint32_t nTurns, Kernel kernel) {
+    std::size_t nInProgress { 0 };
+    switch(kernel) {
+        case Kernel::AVX2:
+            nInProgress = playTurnsAVX2(nTurns);
+            break;
+        case Kernel::SSE:
+            nInProgress = playTurnsSSE(nTurns);
+            break;
+        case Kernel::SCALAR:
+            nInProgress = LaneKernel<uint32_t>::playTurns(*this, nTurns);
+            break;
+    }
+    mDrawCounter += 2 * nTurns;
+    return nInProgress;
+}
+
+#if defined(ZOAPP_GAME_BATCH_X86)
+
+GameBatch::Kernel GameBatch::getBestKernel() {
+    if(__builtin_cpu_supports("avx2")) return Kernel::AVX2;
+    if(__builtin_cpu_supports("sse4.1")) return Kernel::SSE;
+    return Kernel::SCALAR;
+}
+
+__attribute__((target("sse4.1"))) std::size_t GameBatch::playTurnsSSE(uint32_t nTurns) {
+    return LaneKernel<SSELanes>::playTurns(*this, nTurns);
+}
+
+__attribute__((target("avx2"))) std::size_t GameBatch::playTurnsAVX2(uint32_t nTurns) {
+    return LaneKernel<AVX2Lanes>::playTurns(*this, nTurns);
+}
+
+#else
+
+GameBatch::Kernel GameBatch::getBestKernel() { return Kernel::SCALAR; }
+
+std::size_t GameBatch::playTurnsSSE(uint32_t nTurns) { return LaneKernel<uint32_t>::playTurns(*this, nTurns); }
+
+std::size_t GameBatch::playTurnsAVX2(uint32_t nTurns) { return LaneKernel<uint32_t>::playTurns(*this, nTurns); }
+
+#endif
+
+uint8_t GameBatch::getCounters(std::size_t game, RoleID role) const {
+    assert(role != RoleID::NA && "Only players with roles hold counters");
+    return static_cast<uint8_t>(mCounters[role - 1][game]);
+}
+
+GamePosition GameBatch::getPosition(std::size_t game) const {
+    GamePosition position {
+        .mTurn { mTurns[game]? RoleID::WHITE: RoleID::BLACK },
+        .mTurnPhase { TurnPhase::ROLL_DICE },
+    };
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const uint32_t slot { mPieceSlots[role][type][game] };
+            position.mPieces[role][type] = {
+                .mState {
+                    slot == kUnlaunchedSlot? Piece::State::UNLAUNCHED:
+                    slot == kFinishedSlot? Piece::State::FINISHED:
+                    Piece::State::ON_BOARD
+                },
+                .mRoutePosition { static_cast<uint8_t>(slot == kUnlaunchedSlot || slot == kFinishedSlot? 0: slot - 1) },
+            };
+        }
+    }
+    return position;
+}
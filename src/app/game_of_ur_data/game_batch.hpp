@@ -0,0 +1,293 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/game_batch.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a structure-of-arrays engine which plays out large numbers of random games in lockstep, using SIMD where available.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPGAMEBATCH_H
+#define ZOAPPGAMEBATCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+#include "role_id.hpp"
+#include "piece_type_id.hpp"
+#include "move_list.hpp"
+#include "route.hpp"
+#include "random_engine.hpp"
+#include "position_index.hpp"
+
+class GameOfUrModel;
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A batch of games of the play phase, each played out by two players choosing uniformly at random between every action available to them, stored as parallel arrays so that many games are stepped at once.
+ * 
+ * The rules followed are those of GameOfUrModel, and the random players behave as PlayerCPURandom does: after the primary roll, the player picks uniformly between rolling the secondary die and each legal move; after the secondary roll, between each legal move.  Every game holds only what matters between turns, i.e., the route position of each piece, the counters of each player and the common pool, and whose turn it is.
+ * 
+ * Each game (or lane) draws its randomness from a counter-based generator keyed by its lane, so that every kernel, whatever its width, plays out exactly the same games.
+ * 
+ * @see GameBatch::Kernel
+ */
+class GameBatch {
+public:
+    /**
+     * @brief The instruction sets a batch may be played with.
+     * 
+     */
+    enum class Kernel: uint8_t {
+        SCALAR, //< One lane at a time, in plain C++.
+        SSE, //< Four lanes at a time, with SSE4.1.
+        AVX2, //< Eight lanes at a time, with AVX2.
+    };
+
+    /**
+     * @brief The largest number of lanes processed at once by any kernel, to which the number of lanes is rounded up.
+     * 
+     */
+    static constexpr std::size_t kMaxLaneWidth { 8 };
+
+    /**
+     * @brief Creates a batch of games, each at the start of the play phase with black to move.
+     * 
+     * @param nGames The number of games in the batch.
+     * @param randomEngine The engine from which the key of every lane is derived.
+     */
+    GameBatch(std::size_t nGames, RandomEngine randomEngine);
+
+    /**
+     * @brief Gets the number of games in this batch.
+     * 
+     * @return std::size_t The number of games.
+     */
+    std::size_t size() const { return mNGames; }
+
+    /**
+     * @brief Returns a game to the start of the play phase, with black to move.
+     * 
+     * @param game The index of the game.
+     */
+    void resetGame(std::size_t game);
+
+    /**
+     * @brief Copies the pieces, counters and turn of a game model into a game of this batch.
+     * 
+     * The model must be in the play or end phase, and must not be in the middle of a turn, i.e., its dice must not have been rolled yet, or its turn must have ended.
+     * 
+     * @param game The index of the game.
+     * @param model The game model being copied.
+     */
+    void loadGame(std::size_t game, const GameOfUrModel& model);
+
+    /**
+     * @brief Plays up to some number of turns of every game still in progress.
+     * 
+     * @param nTurns The largest number of turns played by each game.
+     * @param kernel The instruction set the games are played with, which has no bearing on their outcome.
+     * @return std::size_t The number of games still in progress after these turns.
+     */
+    std::size_t playTurns(uint32_t nTurns, Kernel kernel=getBestKernel());
+
+    /**
+     * @brief Gets the widest kernel supported by the processor this is running on.
+     * 
+     * @return Kernel The best kernel available.
+     */
+    static Kernel getBestKernel();
+
+    /**
+     * @brief Gets the winner of a game.
+     * 
+     * @param game The index of the game.
+     * @return RoleID The role of the winner, or RoleID::NA if the game is still in progress.
+     */
+    RoleID getWinner(std::size_t game) const { return static_cast<RoleID>(mWinners[game]); }
+
+    /**
+     * @brief Gets the number of turns a game has been played for in this batch.
+     * 
+     * @param game The index of the game.
+     * @return uint32_t The number of turns played.
+     */
+    uint32_t getNTurns(std::size_t game) const { return mNTurns[game]; }
+
+    /**
+     * @brief Gets the number of counters held by one of the players of a game.
+     * 
+     * @param game The index of the game.
+     * @param role The role of the player.
+     * @return uint8_t The number of counters the player holds.
+     */
+    uint8_t getCounters(std::size_t game, RoleID role) const;
+
+    /**
+     * @brief Gets the number of counters in the common pool of a game.
+     * 
+     * @param game The index of the game.
+     * @return uint8_t The number of counters in the common pool.
+     */
+    uint8_t getPoolCounters(std::size_t game) const { return static_cast<uint8_t>(mPoolCounters[game]); }
+
+    /**
+     * @brief Gets the placement of every piece of a game, along with whose turn it is.
+     * 
+     * @param game The index of the game.
+     * @return GamePosition The position of the game, at the start of the turn.
+     */
+    GamePosition getPosition(std::size_t game) const;
+
+private:
+    /**
+     * @brief One of the moves that may be available on a turn, in the order GameOfUrModel lists them.
+     * 
+     */
+    struct MoveCandidate {
+        /**
+         * @brief The type of the piece moved.
+         * 
+         */
+        PieceTypeID mType;
+
+        /**
+         * @brief Whether this move can only ever be a launch, as opposed to being a launch or a board move depending on where its piece is.
+         * 
+         */
+        bool mIsLaunchOnly;
+
+        /**
+         * @brief The route position the piece is launched to, should this move be a launch.
+         * 
+         */
+        uint8_t mLaunchPosition;
+    };
+
+    /**
+     * @brief The value stored for an unlaunched piece, with pieces on the board stored as their route position plus one.
+     * 
+     */
+    static constexpr uint32_t kUnlaunchedSlot { 0 };
+
+    /**
+     * @brief The value stored for a piece that has completed its route.
+     * 
+     */
+    static constexpr uint32_t kFinishedSlot { RouteTable::kRouteEnd + 1 };
+
+    /**
+     * @brief Every move that may be available on a turn: one for each piece, along with one more for each additional house a piece may be launched to.
+     * 
+     */
+    static constexpr std::array<MoveCandidate, MoveList::kCapacity> kMoveCandidates {
+        [] {
+            std::array<MoveCandidate, MoveList::kCapacity> candidates {};
+            std::size_t nCandidates { 0 };
+            for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+                bool isFirst { true };
+                const uint32_t launchPositions { kRouteTables[RoleID::BLACK].getLaunchPositions(static_cast<PieceTypeID>(type)) };
+                for(uint8_t position { 0 }; position < RouteTable::kRouteEnd; ++position) {
+                    if(!((launchPositions >> position) & 1u)) continue;
+                    candidates[nCandidates++] = {
+                        .mType { static_cast<PieceTypeID>(type) },
+                        .mIsLaunchOnly { !isFirst },
+                        .mLaunchPosition { position },
+                    };
+                    isFirst = false;
+                }
+            }
+            return candidates;
+        }()
+    };
+
+    /**
+     * @brief The operations of a kernel, over some number of lanes at once, along with the kernel itself.
+     * 
+     * @tparam TLanes A 32-bit unsigned integer, or a vector of them, holding one value for each lane processed at once.
+     */
+    template <typename TLanes>
+    struct LaneKernel;
+
+    /**
+     * @brief Plays turns with the SSE kernel.
+     * 
+     * @param nTurns The largest number of turns played by each game.
+     * @return std::size_t The number of games still in progress afterwards.
+     */
+    std::size_t playTurnsSSE(uint32_t nTurns);
+
+    /**
+     * @brief Plays turns with the AVX2 kernel.
+     * 
+     * @param nTurns The largest number of turns played by each game.
+     * @return std::size_t The number of games still in progress afterwards.
+     */
+    std::size_t playTurnsAVX2(uint32_t nTurns);
+
+    /**
+     * @brief The number of games in this batch.
+     * 
+     */
+    std::size_t mNGames;
+
+    /**
+     * @brief The number of lanes in this batch, the number of games rounded up to a multiple of kMaxLaneWidth.
+     * 
+     */
+    std::size_t mNLanes;
+
+    /**
+     * @brief The number of random values drawn by every lane so far.
+     * 
+     */
+    uint32_t mDrawCounter { 0 };
+
+    /**
+     * @brief The slot of every piece of every lane, indexed by its owner's RoleID less one, and then by its PieceTypeID.
+     * 
+     */
+    std::array<std::array<std::vector<uint32_t>, PieceTypeID::TOTAL>, 2> mPieceSlots {};
+
+    /**
+     * @brief The counters held by each player of every lane, indexed by the player's RoleID less one.
+     * 
+     */
+    std::array<std::vector<uint32_t>, 2> mCounters {};
+
+    /**
+     * @brief The counters held by the common pool of every lane.
+     * 
+     */
+    std::vector<uint32_t> mPoolCounters {};
+
+    /**
+     * @brief The RoleID, less one, of the player to move in every lane.
+     * 
+     */
+    std::vector<uint32_t> mTurns {};
+
+    /**
+     * @brief The RoleID of the winner of every lane, RoleID::NA while its game is in progress.
+     * 
+     */
+    std::vector<uint32_t> mWinners {};
+
+    /**
+     * @brief The number of turns played by every lane.
+     * 
+     */
+    std::vector<uint32_t> mNTurns {};
+
+    /**
+     * @brief The key of every lane's random number generator.
+     * 
+     */
+    std::vector<uint32_t> mKeys {};
+};
+
+#endif
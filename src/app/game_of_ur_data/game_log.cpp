@@ -0,0 +1,118 @@
+#include <cassert>
+
+#include "game_log.hpp"
+
+GameLog::GameLog(const GameOfUrModel& model, uint32_t snapshotInterval):
+mSnapshotInterval { snapshotInterval },
+mSnapshots { model.getSnapshot() }
+{
+    assert(snapshotInterval > 0 && "Snapshots must be taken at least once every few events");
+}
+
+void GameLog::recordDiceRoll(PlayerID player, const GameOfUrModel& model) {
+    const DiceData dice { model.getDiceData() };
+    append(
+        GameEvent {
+            .mType { GameEvent::Type::DICE_ROLL },
+            .mPlayer { player },
+            .mPiece { .mType { PieceTypeID::SWALLOW }, .mOwner { RoleID::NA } },
+            .mLocation { 0, 0 },
+            .mDiceState { dice.mState },
+            .mPrimaryRoll { dice.mPrimaryRoll },
+            .mSecondaryRoll { dice.mSecondaryRoll },
+            .mResultScore { dice.mResultScore },
+        },
+        model
+    );
+}
+
+void GameLog::recordMove(GameEvent::Type type, PlayerID player, const MoveResultData& moveResult, const GameOfUrModel& model) {
+    assert((type == GameEvent::Type::LAUNCH || type == GameEvent::Type::BOARD_MOVE) && "Only launches and board moves move pieces");
+    append(
+        GameEvent {
+            .mType { type },
+            .mPlayer { player },
+            .mPiece { moveResult.mMovedPiece.mIdentity },
+            .mLocation { moveResult.mMovedPiece.mLocation },
+            .mDiceState { Dice::State::UNROLLED },
+            .mPrimaryRoll { 0 },
+            .mSecondaryRoll { false },
+            .mResultScore { 0 },
+        },
+        model
+    );
+}
+
+void GameLog::recordNextTurn(PlayerID player, const GameOfUrModel& model) {
+    append(
+        GameEvent {
+            .mType { GameEvent::Type::NEXT_TURN },
+            .mPlayer { player },
+            .mPiece { .mType { PieceTypeID::SWALLOW }, .mOwner { RoleID::NA } },
+            .mLocation { 0, 0 },
+            .mDiceState { Dice::State::UNROLLED },
+            .mPrimaryRoll { 0 },
+            .mSecondaryRoll { false },
+            .mResultScore { 0 },
+        },
+        model
+    );
+}
+
+void GameLog::append(const GameEvent& event, const GameOfUrModel& model) {
+    mEvents.push_back(event);
+    if(mEvents.size() % mSnapshotInterval == 0) {
+        mSnapshots.push_back(model.getSnapshot());
+    }
+}
+
+void GameLog::rebuild(std::size_t nEvents, GameOfUrModel& model) const {
+    assert(nEvents <= mEvents.size() && "Only events that have been recorded can be replayed");
+
+    // start from the last snapshot taken at or before the requested event ...
+    const std::size_t snapshot { nEvents / mSnapshotInterval };
+    [[maybe_unused]] const bool restored { model.restoreSnapshot(mSnapshots[snapshot]) };
+    assert(restored && "Snapshots taken by the log should always be valid");
+
+    // ... and replay whatever events followed it
+    for(std::size_t event { snapshot * mSnapshotInterval }; event < nEvents; ++event) {
+        replay(mEvents[event], model);
+    }
+}
+
+void GameLog::truncate(std::size_t nEvents) {
+    assert(nEvents <= mEvents.size() && "Only events that have been recorded can be forgotten");
+    mEvents.resize(nEvents);
+    mSnapshots.resize(nEvents / mSnapshotInterval + 1);
+}
+
+void GameLog::replay(const GameEvent& event, GameOfUrModel& model) {
+    switch(event.mType) {
+        case GameEvent::Type::DICE_ROLL:
+            model.applyDiceOutcome(
+                Dice::Outcome {
+                    .mState { event.mDiceState },
+                    .mPrimaryRoll { event.mPrimaryRoll },
+                    .mSecondaryRoll { event.mSecondaryRoll },
+                    .mResultScore { event.mResultScore },
+                    .mProbability { 1.0 },
+                }
+            );
+            break;
+
+        case GameEvent::Type::LAUNCH:
+        case GameEvent::Type::BOARD_MOVE:
+            model.applyMove(event.mPiece, event.mLocation);
+            break;
+
+        case GameEvent::Type::NEXT_TURN:
+            // the turn is advanced in preference to the play phase being
+            // started, as UrController does
+            if(model.canAdvanceOneTurn(event.mPlayer)) {
+                model.applyTurnAdvance();
+            } else {
+                model.startPhasePlay();
+            }
+            break;
+    }
+}
@@ -0,0 +1,211 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/game_log.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains an append-only log of the actions taken in a game, from which any earlier state of the game can be rebuilt.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPGAMELOG_H
+#define ZOAPPGAMELOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "model.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A single action accepted by a game, along with everything needed to apply it again without consulting the dice.
+ * 
+ */
+struct GameEvent {
+    /**
+     * @brief The kinds of action a game accepts.
+     * 
+     */
+    enum class Type: uint8_t {
+        DICE_ROLL, //< One of the dice was rolled.
+        LAUNCH, //< An unlaunched piece was launched onto the board.
+        BOARD_MOVE, //< A piece on the board was moved along its route.
+        NEXT_TURN, //< The turn passed to the next player, or the play phase was started.
+    };
+
+    /**
+     * @brief The kind of action taken.
+     * 
+     */
+    Type mType;
+
+    /**
+     * @brief The player who took the action.
+     * 
+     */
+    PlayerID mPlayer;
+
+    /**
+     * @brief The piece moved, meaningful for launches and board moves.
+     * 
+     */
+    PieceIdentity mPiece;
+
+    /**
+     * @brief The location the piece was moved to, meaningful for launches and board moves.
+     * 
+     */
+    glm::u8vec2 mLocation;
+
+    /**
+     * @brief The state of the dice after the roll, meaningful for dice rolls.
+     * 
+     */
+    Dice::State mDiceState;
+
+    /**
+     * @brief The value shown by the primary die after the roll, meaningful for dice rolls.
+     * 
+     */
+    uint8_t mPrimaryRoll;
+
+    /**
+     * @brief The value shown by the secondary die after the roll, meaningful for dice rolls.
+     * 
+     */
+    bool mSecondaryRoll;
+
+    /**
+     * @brief The score produced by the dice after the roll, meaningful for dice rolls.
+     * 
+     */
+    uint8_t mResultScore;
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The append-only record of every action taken in one game, along with a snapshot of the game taken every few events, so that the game may be rebuilt as it was after any number of events.
+ * 
+ * Rebuilding a state restores the nearest snapshot taken at or before it and replays the events since, of which there are always fewer than the snapshot interval.  Dice rolls are replayed with the outcomes recorded, so the random engine of the game being rebuilt is never drawn from.
+ * 
+ */
+class GameLog {
+public:
+    /**
+     * @brief The number of events between snapshots, unless another is asked for.
+     * 
+     */
+    static constexpr uint32_t kDefaultSnapshotInterval { 16 };
+
+    /**
+     * @brief Creates a log starting from the current state of a game.
+     * 
+     * @param model The game being logged, as it is before its first logged event.
+     * @param snapshotInterval The number of events between snapshots.
+     */
+    explicit GameLog(const GameOfUrModel& model, uint32_t snapshotInterval=kDefaultSnapshotInterval);
+
+    /**
+     * @brief Records a roll of the dice which has just been made.
+     * 
+     * @param player The player who rolled the dice.
+     * @param model The game, as it is after the roll.
+     */
+    void recordDiceRoll(PlayerID player, const GameOfUrModel& model);
+
+    /**
+     * @brief Records a launch or a board move which has just been made.
+     * 
+     * @param type Either GameEvent::Type::LAUNCH or GameEvent::Type::BOARD_MOVE.
+     * @param player The player who moved the piece.
+     * @param moveResult The results of the move, as given by the move token it was made with.
+     * @param model The game, as it is after the move.
+     */
+    void recordMove(GameEvent::Type type, PlayerID player, const MoveResultData& moveResult, const GameOfUrModel& model);
+
+    /**
+     * @brief Records the end of a turn, or the start of the play phase, which has just taken place.
+     * 
+     * @param player The player who ended their turn.
+     * @param model The game, as it is after the turn was ended.
+     */
+    void recordNextTurn(PlayerID player, const GameOfUrModel& model);
+
+    /**
+     * @brief Gets the number of events recorded.
+     * 
+     * @return std::size_t The number of events in the log.
+     */
+    std::size_t size() const { return mEvents.size(); }
+
+    /**
+     * @brief Gets an event from the log.
+     * 
+     * @param event The index of the event, counting from the first event recorded.
+     * @return const GameEvent& The event.
+     */
+    const GameEvent& getEvent(std::size_t event) const { return mEvents[event]; }
+
+    /**
+     * @brief Gets the number of events between snapshots.
+     * 
+     * @return uint32_t The snapshot interval of this log.
+     */
+    uint32_t getSnapshotInterval() const { return mSnapshotInterval; }
+
+    /**
+     * @brief Rebuilds the game as it was after some number of events.
+     * 
+     * The model keeps its own random engine, and move tokens it issued earlier are no longer current.
+     * 
+     * @param nEvents The number of events after which the game is rebuilt, at most size().
+     * @param model The model to hold the rebuilt game.
+     */
+    void rebuild(std::size_t nEvents, GameOfUrModel& model) const;
+
+    /**
+     * @brief Forgets every event after some number of events, such as when moves are taken back.
+     * 
+     * @param nEvents The number of events kept, at most size().
+     */
+    void truncate(std::size_t nEvents);
+
+private:
+    /**
+     * @brief Adds an event to the log, taking a snapshot of the game if the event completes an interval.
+     * 
+     * @param event The event being recorded.
+     * @param model The game, as it is after the event.
+     */
+    void append(const GameEvent& event, const GameOfUrModel& model);
+
+    /**
+     * @brief Applies a recorded event to a game, which must be in the state the event was recorded in.
+     * 
+     * @param event The event being replayed.
+     * @param model The game the event is applied to.
+     */
+    static void replay(const GameEvent& event, GameOfUrModel& model);
+
+    /**
+     * @brief The number of events between snapshots.
+     * 
+     */
+    uint32_t mSnapshotInterval;
+
+    /**
+     * @brief Every event recorded, in the order they took place.
+     * 
+     */
+    std::vector<GameEvent> mEvents {};
+
+    /**
+     * @brief The state of the game after every multiple of mSnapshotInterval events, starting with its state before the first event.
+     * 
+     */
+    std::vector<GameSnapshot> mSnapshots {};
+};
+
+#endif
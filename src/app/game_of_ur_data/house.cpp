@@ -12,37 +12,21 @@ bool House::canMove(const Piece& gamePiece) const {
         // ... and ... 
         && (
             // ... must be unoccupied ...
-            mOccupant.expired()
+            !isOccupied()
 
             // ... or if occupied, not ...
             || !(
                 // ... be a rosette ...
                 mType == Type::ROSETTE
                 // ... nor be occupied by another of our own pieces
-                || (gamePiece.getOwner() == mOccupant.lock()->getOwner())
+                || (gamePiece.getOwner() == mOccupant.mOwner)
             )
         )
     );
 }
 
-void House::move(std::shared_ptr<Piece> gamePiece) {
-    if(!gamePiece) {
-        mOccupant.reset();
-        return;
-    }
+void House::move(const Piece& gamePiece) {
+    assert(canMove(gamePiece) && "This piece cannot move to this location");
 
-    assert(canMove(*gamePiece) && "This piece cannot move to this location");
-
-    mOccupant = gamePiece;
-}
-
-PieceIdentity House::getOccupant() const {
-    if(mOccupant.expired()) {
-        return PieceIdentity {
-            .mType { PieceTypeID::SWALLOW },
-            .mOwner { RoleID::NA },
-        };
-    }
-
-    return mOccupant.lock()->getIdentity();
+    mOccupant = gamePiece.getIdentity();
 }
@@ -12,8 +12,6 @@
 #ifndef ZOAPPHOUSE_H
 #define ZOAPPHOUSE_H
 
-#include <memory>
-
 #include <glm/glm.hpp>
 
 #include "piece.hpp"
@@ -23,7 +21,7 @@
  * @ingroup UrGameDataModel
  * @brief The representation of a single house on the Game of Ur Board, in other words a tile.
  * 
- * Also stores a reference to the game piece presently occupying this house.
+ * Also stores the identity of the game piece presently occupying this house, which serves as an index into the pieces owned by GameOfUrModel's players.
  * 
  */
 class House {
@@ -61,29 +59,35 @@ public:
     {}
 
     /**
-     * @brief Validates and applies a move, replacing the reference to the currently occupying piece with a new one.  
-     * 
-     * Passing an empty pointer causes this house to lose its reference to its current occupant.
+     * @brief Validates and applies a move, replacing the identity of the currently occupying piece with that of a new one.
      * 
      * @warning This method assumes that any higher level game logic checks were already performed before it was called.
      * 
-     * @param gamePiece The piece to now occupy this, or a nullptr if the piece here is to be moved.
+     * @param gamePiece The piece to now occupy this house.
+     * 
+     * @see vacate()
+     */
+    void move(const Piece& gamePiece);
+
+    /**
+     * @brief Causes this house to forget its current occupant, if any.
+     * 
      */
-    void move(std::shared_ptr<Piece> gamePiece);
+    void vacate() { mOccupant = kNoOccupant; }
 
     /**
-     * @brief Gets a reference to the piece already occupying this house, if any.
+     * @brief Makes a piece the occupant of this house again, without validating the move, when a move is being reverted.
      * 
-     * @return std::weak_ptr<Piece> A reference to the piece occupying this house.
+     * @param occupant The identity of the piece which occupied this house before the move being reverted.
      */
-    std::weak_ptr<Piece> getOccupantReference() { return mOccupant; }
+    void restoreOccupant(PieceIdentity occupant) { mOccupant = occupant; }
 
     /**
      * @brief Gets the identity of the piece occupying this house.
      * 
      * @return PieceIdentity The ID of the piece occupying this house.
      */
-    PieceIdentity getOccupant() const;
+    PieceIdentity getOccupant() const { return mOccupant; }
 
     /**
      * @brief Tests whether this house is already occupied by a game piece.
@@ -91,7 +95,7 @@ public:
      * @retval true There is a game piece on this house.
      * @retval false There is no game piece on this house.
      */
-    bool isOccupied() const { return !mOccupant.expired(); }
+    bool isOccupied() const { return mOccupant.mOwner != RoleID::NA; }
 
     /**
      * @brief Tests whether this house is a rosette house.
@@ -146,6 +150,15 @@ public:
     bool canMove(const Piece& gamePiece) const;
 
 private:
+    /**
+     * @brief The value of mOccupant when no piece occupies this house.
+     * 
+     */
+    static constexpr PieceIdentity kNoOccupant {
+        .mType { PieceTypeID::SWALLOW },
+        .mOwner { RoleID::NA },
+    };
+
     /**
      * @brief Direction to the location of the next House, relative to this one.
      * 
@@ -165,10 +178,10 @@ private:
     Region mRegion;
 
     /**
-     * @brief The piece occupying this house, if any.
+     * @brief The identity of the piece occupying this house, or kNoOccupant if there isn't one.
      * 
      */
-    std::weak_ptr<Piece> mOccupant {};
+    PieceIdentity mOccupant { kNoOccupant };
 };
 
 #endif
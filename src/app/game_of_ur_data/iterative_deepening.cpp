@@ -0,0 +1,26 @@
+#include <cassert>
+#include <algorithm>
+
+#include "iterative_deepening.hpp"
+
+IterativeDeepening::IterativeDeepening(double softSeconds, double hardSeconds, uint8_t maxDepth):
+    mSoftSeconds { softSeconds },
+    mHardSeconds { hardSeconds },
+    mMaxDepth { maxDepth }
+{
+    assert(softSeconds >= 0.0 && softSeconds <= hardSeconds && "The soft budget lies within the hard budget");
+    assert(maxDepth > 0 && "At least one search is run");
+}
+
+bool IterativeDeepening::shouldDeepen(
+    IterativeDeepeningResult& result, bool unstable, double elapsedSeconds, double searchSeconds, double previousSearchSeconds
+) const {
+    if(elapsedSeconds >= (unstable? std::min(mSoftSeconds * kSoftExtension, mHardSeconds): mSoftSeconds)) return false;
+    if(elapsedSeconds >= mSoftSeconds) result.mExtended = true;
+
+    // each search is assumed to take as many times longer than the last as
+    // the last did than the one before, and one that won't finish within the
+    // hard budget would only be abandoned
+    const double growth { previousSearchSeconds > 0.0? searchSeconds / previousSearchSeconds: 1.0 };
+    return elapsedSeconds + searchSeconds * growth < mHardSeconds;
+}
@@ -0,0 +1,239 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/iterative_deepening.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a driver running a depth-limited search at ever greater depths until a time budget runs out.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPITERATIVEDEEPENING_H
+#define ZOAPPITERATIVEDEEPENING_H
+
+#include <cstdint>
+#include <chrono>
+#include <cmath>
+
+#include "model.hpp"
+#include "search_action.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The choice made by a single run of IterativeDeepening::search(), along with statistics describing the run.
+ * 
+ */
+struct IterativeDeepeningResult {
+    /**
+     * @brief The best action found by the deepest search completed.
+     * 
+     */
+    SearchAction mAction;
+
+    /**
+     * @brief The value of the best action to the player, as given by the deepest search completed.
+     * 
+     */
+    double mValue;
+
+    /**
+     * @brief The depth of the deepest search completed, or 0 if even the shallowest was abandoned and the action is only the search's best guess.
+     * 
+     */
+    uint8_t mDepth;
+
+    /**
+     * @brief The number of states visited, over every search run including any abandoned.
+     * 
+     */
+    uint64_t mNodes;
+
+    /**
+     * @brief Whether the soft budget was stretched because the best action or its value moved between depths.
+     * 
+     */
+    bool mExtended;
+
+    /**
+     * @brief Whether a search was abandoned at the hard budget.
+     * 
+     */
+    bool mAbandoned;
+
+    /**
+     * @brief The time taken by the run, in seconds.
+     * 
+     */
+    double mSeconds;
+
+    /**
+     * @brief Gets the rate at which states were visited.
+     * 
+     * @return double The number of states visited per second.
+     */
+    double getNodesPerSecond() const { return mSeconds > 0.0? mNodes / mSeconds: 0.0; }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief Chooses an action within a time budget by searching a game to depth 1, then 2, and so on, keeping the result of the deepest search completed.
+ * 
+ * The budget has two parts.  No search is started once the soft budget has been used, and none is started that the growth of the searches so far predicts won't finish within the hard budget.  A search running when the hard budget runs out is abandoned, and its result discarded in favour of the deepest search completed, so that a decision never takes much longer than the hard budget.  When the best action changes between one depth and the next, or its value moves by more than kUnstableValueChange, the soft budget is stretched by kSoftExtension, up to the hard budget, since a deeper search is then most likely to change the decision.
+ * 
+ * Any search may be driven, so long as it offers a `search(const GameOfUrModel&, uint8_t depth, std::chrono::steady_clock::time_point deadline)` returning its best SearchAction as `mAction`, with `mValue`, `mNodes`, and `mCompleted`, as Expectiminimax::search() does.
+ * 
+ */
+class IterativeDeepening {
+public:
+    /**
+     * @brief The soft budget, unless another is asked for, leaving a 60 FPS frame room for everything else it does.
+     * 
+     */
+    static constexpr double kDefaultSoftSeconds { 0.004 };
+
+    /**
+     * @brief The hard budget, unless another is asked for.
+     * 
+     */
+    static constexpr double kDefaultHardSeconds { 0.010 };
+
+    /**
+     * @brief The deepest search run, unless another is asked for.
+     * 
+     */
+    static constexpr uint8_t kDefaultMaxDepth { 32 };
+
+    /**
+     * @brief The factor by which the soft budget is stretched when the decision is unstable.
+     * 
+     */
+    static constexpr double kSoftExtension { 2.0 };
+
+    /**
+     * @brief The change in the best action's value between depths past which the decision is unstable.
+     * 
+     */
+    static constexpr double kUnstableValueChange { 0.02 };
+
+    /**
+     * @brief Creates a driver.
+     * 
+     * @param softSeconds The time after which no search is started, unless the decision is unstable.
+     * @param hardSeconds The time after which any search running is abandoned, no less than the soft budget.
+     * @param maxDepth The deepest search run.
+     */
+    explicit IterativeDeepening(
+        double softSeconds=kDefaultSoftSeconds, double hardSeconds=kDefaultHardSeconds, uint8_t maxDepth=kDefaultMaxDepth
+    );
+
+    /**
+     * @brief Gets the time after which no search is started, unless the decision is unstable.
+     * 
+     * @return double The soft budget, in seconds.
+     */
+    double getSoftSeconds() const { return mSoftSeconds; }
+
+    /**
+     * @brief Gets the time after which any search running is abandoned.
+     * 
+     * @return double The hard budget, in seconds.
+     */
+    double getHardSeconds() const { return mHardSeconds; }
+
+    /**
+     * @brief Gets the deepest search run.
+     * 
+     * @return uint8_t The largest depth searched.
+     */
+    uint8_t getMaxDepth() const { return mMaxDepth; }
+
+    /**
+     * @brief Searches a game for the best action of the player whose turn it is, as deeply as the budget allows.
+     * 
+     * @tparam TSearch The type of the search driven.
+     * @param search The search driven.
+     * @param model The game searched.
+     * @return IterativeDeepeningResult The action chosen by the deepest search completed, along with statistics describing the run.
+     */
+    template <typename TSearch>
+    IterativeDeepeningResult search(TSearch& search, const GameOfUrModel& model) const;
+
+private:
+    /**
+     * @brief Decides, after a search completes, whether to search one level deeper.
+     * 
+     * @param result The result so far, marked as extended if the soft budget is stretched.
+     * @param unstable Whether the best action or its value moved between the last two depths.
+     * @param elapsedSeconds The time taken since the run started.
+     * @param searchSeconds The time taken by the search just completed.
+     * @param previousSearchSeconds The time taken by the search before it, or 0 if there was none.
+     * @retval true A deeper search is started.
+     * @retval false The run ends.
+     */
+    bool shouldDeepen(
+        IterativeDeepeningResult& result, bool unstable, double elapsedSeconds, double searchSeconds, double previousSearchSeconds
+    ) const;
+
+    /**
+     * @brief The time after which no search is started, unless the decision is unstable.
+     * 
+     */
+    double mSoftSeconds;
+
+    /**
+     * @brief The time after which any search running is abandoned.
+     * 
+     */
+    double mHardSeconds;
+
+    /**
+     * @brief The deepest search run.
+     * 
+     */
+    uint8_t mMaxDepth;
+};
+
+template <typename TSearch>
+IterativeDeepeningResult IterativeDeepening::search(TSearch& search, const GameOfUrModel& model) const {
+    using Clock = std::chrono::steady_clock;
+    IterativeDeepeningResult result {};
+    const Clock::time_point start { Clock::now() };
+    const Clock::time_point deadline { start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mHardSeconds)) };
+
+    double previousSearchSeconds { 0.0 };
+    for(uint32_t depth { 1 }; depth <= mMaxDepth; ++depth) {
+        const Clock::time_point searchStart { Clock::now() };
+        const auto searchResult { search.search(model, static_cast<uint8_t>(depth), deadline) };
+        result.mNodes += searchResult.mNodes;
+        if(!searchResult.mCompleted) {
+            // with nothing completed, the abandoned search's guess is all there is
+            result.mAbandoned = true;
+            if(result.mDepth == 0) {
+                result.mAction = searchResult.mAction;
+                result.mValue = searchResult.mValue;
+            }
+            break;
+        }
+
+        const bool unstable {
+            result.mDepth > 0
+            && (searchResult.mAction != result.mAction || std::abs(searchResult.mValue - result.mValue) > kUnstableValueChange)
+        };
+        result.mAction = searchResult.mAction;
+        result.mValue = searchResult.mValue;
+        result.mDepth = static_cast<uint8_t>(depth);
+
+        const Clock::time_point searchEnd { Clock::now() };
+        const double searchSeconds { std::chrono::duration<double>(searchEnd - searchStart).count() };
+        if(!shouldDeepen(result, unstable, std::chrono::duration<double>(searchEnd - start).count(), searchSeconds, previousSearchSeconds)) {
+            break;
+        }
+        previousSearchSeconds = searchSeconds;
+    }
+
+    result.mSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+#endif
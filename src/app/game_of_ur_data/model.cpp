@@ -1,10 +1,64 @@
 #include <cmath>
 
 #include "model.hpp"
-#include "piece_type.hpp"
+#include "ruleset.hpp"
 
 void GameOfUrModel::reset() {
-    *this = GameOfUrModel{};
+    // tokens issued before the reset must not be mistaken for ones issued after it
+    const uint32_t stateVersion { mStateVersion };
+    *this = GameOfUrModel{ mDice.getRandomEngine() };
+    mStateVersion = stateVersion + 1;
+}
+
+template <typename TOnMove>
+void GameOfUrModel::visitPossibleMoves(TOnMove&& onMove) const {
+    if(
+        mGamePhase != GamePhase::PLAY
+        || mTurnPhase != TurnPhase::MOVE_PIECE
+    ) return;
+    const RoleID activeRole { getRole(mCurrentPlayer) };
+    const RouteTable& route { kRouteTables[activeRole] };
+    const Player& activePlayer { mPlayers[mCurrentPlayer] };
+    const uint8_t diceRoll { mDice.getResult(GamePhase::PLAY) };
+
+    for(uint8_t type {0}; type < PieceTypeID::TOTAL; ++type) {
+        const Piece& piece { activePlayer.cGetPiece(static_cast<PieceTypeID>(type)) };
+
+        switch(piece.getState()) {
+            case Piece::State::UNLAUNCHED:
+                // launches are only possible with the piece's launch roll
+                if(diceRoll != kGamePieceTypes[type].mLaunchRoll) break;
+                for(uint8_t position { 0 }; position < RouteTable::kRouteEnd; ++position) {
+                    if(!route.isLaunchPosition(position, piece.getType())) continue;
+                    const glm::u8vec2 launchPosition { route.getLocation(position) };
+                    if(mBoard.canMove(activeRole, piece, launchPosition, diceRoll)) {
+                        const MoveResultData::flags routeFlags {
+                            static_cast<MoveResultData::flags>(
+                                MoveResultData::IS_POSSIBLE
+                                | (RouteTable::isRosettePosition(position)? MoveResultData::LANDS_ON_ROSETTE: 0)
+                            )
+                        };
+                        if(!onMove(piece.getIdentity(), launchPosition, routeFlags)) return;
+                    }
+                }
+                break;
+
+            case Piece::State::ON_BOARD: 
+                {
+                    // route step flags share their values with MoveResultData's
+                    const RouteTable::Step& step { mBoard.getRouteStep(piece, diceRoll) };
+                    if(!(step.mFlags & RouteTable::Step::IS_POSSIBLE)) break;
+                    const glm::u8vec2 movePosition { route.getLocation(step.mDestination) };
+                    if(mBoard.canMove(activeRole, piece, movePosition, diceRoll)) {
+                        if(!onMove(piece.getIdentity(), movePosition, step.mFlags)) return;
+                    }
+                }
+                break;
+
+            case Piece::State::FINISHED:
+                break;
+        }
+    }
 }
 
 void GameOfUrModel::endTurn() {
@@ -24,27 +78,31 @@ void GameOfUrModel::endTurn() {
     }
 }
 
-void GameOfUrModel::startPhasePlay() {
+StateDelta GameOfUrModel::startPhasePlay() {
     assert(canStartPhasePlay() && "Invalid conditions for starting the play phase");
+    StateDelta stateDelta { beginStateDelta() };
 
-    bool playerAGoesFirst { mPreviousRoll > mDice->getResult(GamePhase::INITIATIVE) };
+    bool playerAGoesFirst { mPreviousRoll > mDice.getResult(GamePhase::INITIATIVE) };
+    mHash ^= hashTurnState();
+    ++mStateVersion;
 
     // update game phase
     mGamePhase = GamePhase::PLAY;
     mTurnPhase = TurnPhase::ROLL_DICE;
     mRoundPhase = RoundPhase::IN_PROGRESS;
-    mDice->reset();
+    mDice.reset();
 
     // assign roles to each player
     mCurrentPlayer = playerAGoesFirst? PlayerID::PLAYER_A: PlayerID::PLAYER_B;
     mPlayers[PlayerID::PLAYER_A].initializeWithRole(playerAGoesFirst? RoleID::BLACK: RoleID::WHITE);
     mPlayers[PlayerID::PLAYER_B].initializeWithRole(playerAGoesFirst? RoleID::WHITE: RoleID::BLACK);
+    mHash ^= hashTurnState();
 
-    // collect 10 counters from each player and place them in the common pool
-    deductCounters(10, PlayerID::PLAYER_A);
-    deductCounters(10, PlayerID::PLAYER_B);
+    // collect each player's stake and place it in the common pool
+    deductCounters(kUrRuleset.mStake, PlayerID::PLAYER_A);
+    deductCounters(kUrRuleset.mStake, PlayerID::PLAYER_B);
 
-    assert(mCounters == 20 && "There should now be 20 counters in the common pool");
+    assert(mCounters == 2 * kUrRuleset.mStake && "The common pool should now hold both players' stakes");
     assert(
         mPlayers[PlayerID::PLAYER_A].getNPieces(Piece::State::UNLAUNCHED) == 5 
         && "Player A should have exactly 5 unlaunched pieces"
@@ -53,24 +111,231 @@ void GameOfUrModel::startPhasePlay() {
         mPlayers[PlayerID::PLAYER_B].getNPieces(Piece::State::UNLAUNCHED) == 5
         && "Player B should have exactly 5 unlaunched pieces"
     );
+
+    stateDelta.mChangedFields |= StateDelta::ROLES;
+    completeStateDelta(stateDelta);
+    return stateDelta;
 }
 
-void GameOfUrModel::rollDice(PlayerID requester) {
+StateDelta GameOfUrModel::rollDice(PlayerID requester) {
     assert(canRollDice(requester) && "This player cannot roll dice presently");
-    mDice->roll();
+    StateDelta stateDelta { beginStateDelta() };
+    applyDiceRoll();
+    completeStateDelta(stateDelta);
+    return stateDelta;
+}
+
+StateDelta GameOfUrModel::movePiece(PieceIdentity piece, glm::u8vec2 toLocation, PlayerID requester) {
+    assert(canMovePiece(piece, toLocation, requester) && "this player may not move this piece at the present time");
+    StateDelta stateDelta { beginStateDelta() };
+    addPieceChanges(stateDelta, applyMove(piece, toLocation));
+    completeStateDelta(stateDelta);
+    return stateDelta;
+}
+
+StateDelta GameOfUrModel::movePiece(const MoveToken& moveToken) {
+    StateDelta stateDelta { beginStateDelta() };
+    addPieceChanges(stateDelta, applyMove(moveToken));
+    completeStateDelta(stateDelta);
+    return stateDelta;
+}
+
+MoveToken GameOfUrModel::validateLaunch(PieceIdentity piece, glm::u8vec2 launchLocation, PlayerID requester) const {
+    assert(piece.mOwner != RoleID::NA && "A piece without an owner role is invalid");
+    if(
+        mGamePhase != GamePhase::PLAY
+        || getPlayer(piece.mOwner) != requester
+        || !canLaunchPieceTo(piece, launchLocation, requester)
+    ) {
+        return { .mMoveResult {}, .mStateVersion { mStateVersion } };
+    }
+    return { .mMoveResult { getMoveData(piece, launchLocation) }, .mStateVersion { mStateVersion } };
+}
+
+MoveToken GameOfUrModel::validateBoardMove(PieceIdentity piece, PlayerID requester) const {
+    assert(piece.mOwner != RoleID::NA && "A piece without an owner role is invalid");
+    if(
+        mGamePhase != GamePhase::PLAY
+        || mTurnPhase != TurnPhase::MOVE_PIECE
+        || getPlayer(piece.mOwner) != requester
+        || getPiece(piece).getState() != Piece::State::ON_BOARD
+    ) {
+        return { .mMoveResult {}, .mStateVersion { mStateVersion } };
+    }
+
+    const glm::u8vec2 moveLocation { mBoard.computeMoveLocation(getPiece(piece), mDice.getResult(mGamePhase)) };
+    if(!canMovePiece(piece, moveLocation, requester)) {
+        return { .mMoveResult {}, .mStateVersion { mStateVersion } };
+    }
+    return { .mMoveResult { getMoveData(piece, moveLocation) }, .mStateVersion { mStateVersion } };
+}
+
+bool GameOfUrModel::isTokenCurrent(const MoveToken& moveToken) const {
+    return moveToken.isValid() && moveToken.mStateVersion == mStateVersion;
+}
 
+StateDelta GameOfUrModel::advanceOneTurn(PlayerID requester) {
+    assert(canAdvanceOneTurn(requester) && "cannot advance to next turn at this stage");
+    StateDelta stateDelta { beginStateDelta() };
+    applyTurnAdvance();
+
+    assert(
+        mCurrentPlayer != requester 
+        && "The requester should have been the one to end the turn, handing over control\
+        to the other player"
+    );
+    completeStateDelta(stateDelta);
+    return stateDelta;
+}
+
+UndoRecord GameOfUrModel::beginUndoRecord(UndoRecord::Action action) const {
+    return {
+        .mAction { action },
+        .mGamePhase { mGamePhase },
+        .mTurnPhase { mTurnPhase },
+        .mRoundPhase { mRoundPhase },
+        .mCurrentPlayer { mCurrentPlayer },
+        .mPreviousRoll { mPreviousRoll },
+        .mDiceState { mDice.getState() },
+        .mPrimaryRoll { mDice.getPrimaryRoll() },
+        .mSecondaryRoll { mDice.getSecondaryRoll() },
+        .mMovedPiece { .mType { PieceTypeID::SWALLOW }, .mOwner { RoleID::NA } },
+        .mMovedFromState { Piece::State::UNLAUNCHED },
+        .mMovedFromLocation { 0, 0 },
+        .mDisplacedPiece { .mType { PieceTypeID::SWALLOW }, .mOwner { RoleID::NA } },
+        .mCountersLost { 0 },
+        .mCountersWon { 0 },
+    };
+}
+
+StateDelta GameOfUrModel::beginStateDelta() const {
+    return {
+        .mChangedFields { 0 },
+        .mPhase { getCurrentPhase() },
+        .mDice { getDiceData() },
+        .mPieceChanges {},
+        .mNPieceChanges { 0 },
+        .mCommonPoolCountersChange { static_cast<int8_t>(mCounters) },
+        .mPlayerCountersChanges {{
+            static_cast<int8_t>(mPlayers[PlayerID::PLAYER_A].getNCounters()),
+            static_cast<int8_t>(mPlayers[PlayerID::PLAYER_B].getNCounters()),
+        }},
+    };
+}
+
+void GameOfUrModel::completeStateDelta(StateDelta& stateDelta) const {
+    const GamePhaseData phase { getCurrentPhase() };
+    const DiceData dice { getDiceData() };
+    if(phase.mGamePhase != stateDelta.mPhase.mGamePhase) stateDelta.mChangedFields |= StateDelta::GAME_PHASE;
+    if(phase.mRoundPhase != stateDelta.mPhase.mRoundPhase) stateDelta.mChangedFields |= StateDelta::ROUND_PHASE;
+    if(phase.mTurnPhase != stateDelta.mPhase.mTurnPhase) stateDelta.mChangedFields |= StateDelta::TURN_PHASE;
+    if(phase.mTurn != stateDelta.mPhase.mTurn) stateDelta.mChangedFields |= StateDelta::TURN;
+    if(phase.mWinner != stateDelta.mPhase.mWinner) stateDelta.mChangedFields |= StateDelta::WINNER;
+    if(
+        dice.mState != stateDelta.mDice.mState
+        || dice.mPrimaryRoll != stateDelta.mDice.mPrimaryRoll
+        || dice.mSecondaryRoll != stateDelta.mDice.mSecondaryRoll
+        || dice.mResultScore != stateDelta.mDice.mResultScore
+        || dice.mPreviousResult != stateDelta.mDice.mPreviousResult
+    ) stateDelta.mChangedFields |= StateDelta::DICE;
+    stateDelta.mPhase = phase;
+    stateDelta.mDice = dice;
+
+    // counters held before the action were kept in place of their changes
+    stateDelta.mCommonPoolCountersChange = static_cast<int8_t>(mCounters - stateDelta.mCommonPoolCountersChange);
+    for(uint8_t player { PlayerID::PLAYER_A }; player <= PlayerID::PLAYER_B; ++player) {
+        stateDelta.mPlayerCountersChanges[player] = static_cast<int8_t>(
+            mPlayers[player].getNCounters() - stateDelta.mPlayerCountersChanges[player]
+        );
+    }
+}
+
+void GameOfUrModel::addPieceChanges(StateDelta& stateDelta, const UndoRecord& undoRecord) const {
+    assert(undoRecord.mAction == UndoRecord::MOVE_PIECE && "Only moves change the state of pieces");
+    const Piece& movedPiece { getPiece(undoRecord.mMovedPiece) };
+    stateDelta.mPieceChanges[stateDelta.mNPieceChanges++] = {
+        .mPiece { undoRecord.mMovedPiece },
+        .mFromState { undoRecord.mMovedFromState },
+        .mFromLocation { undoRecord.mMovedFromLocation },
+        .mToState { movedPiece.getState() },
+        .mToLocation { movedPiece.getLocation() },
+    };
+
+    // a displaced piece is always sent from where the moved piece landed
+    // back to its owner's unlaunched pieces
+    if(undoRecord.mDisplacedPiece.mOwner != RoleID::NA) {
+        stateDelta.mPieceChanges[stateDelta.mNPieceChanges++] = {
+            .mPiece { undoRecord.mDisplacedPiece },
+            .mFromState { Piece::State::ON_BOARD },
+            .mFromLocation { movedPiece.getLocation() },
+            .mToState { Piece::State::UNLAUNCHED },
+            .mToLocation { 0, 0 },
+        };
+    }
+}
+
+void GameOfUrModel::restoreFromUndoRecord(const UndoRecord& undoRecord) {
+    mHash ^= hashTurnState();
+    ++mStateVersion;
+    mGamePhase = undoRecord.mGamePhase;
+    mTurnPhase = undoRecord.mTurnPhase;
+    mRoundPhase = undoRecord.mRoundPhase;
+    mCurrentPlayer = undoRecord.mCurrentPlayer;
+    mPreviousRoll = undoRecord.mPreviousRoll;
+    mDice.restore(undoRecord.mDiceState, undoRecord.mPrimaryRoll, undoRecord.mSecondaryRoll);
+    mHash ^= hashTurnState();
+}
+
+UndoRecord GameOfUrModel::applyDiceRoll() {
+    assert(canRollDice(mCurrentPlayer) && "The dice cannot be rolled presently");
+    const UndoRecord undoRecord { beginUndoRecord(UndoRecord::ROLL_DICE) };
+    mHash ^= hashTurnState();
+    ++mStateVersion;
+
+    mDice.roll();
+    resolveDiceRoll();
+
+    mHash ^= hashTurnState();
+
+    return undoRecord;
+}
+
+Dice::OutcomeList GameOfUrModel::getDiceRollOutcomes() const {
+    if(!canRollDice(mCurrentPlayer)) return {};
+    return mDice.getOutcomes(mGamePhase);
+}
+
+UndoRecord GameOfUrModel::applyDiceOutcome(const Dice::Outcome& outcome) {
+    assert(canRollDice(mCurrentPlayer) && "The dice cannot be rolled presently");
+    const UndoRecord undoRecord { beginUndoRecord(UndoRecord::ROLL_DICE) };
+    mHash ^= hashTurnState();
+    ++mStateVersion;
+
+    mDice.force(outcome);
+    resolveDiceRoll();
+
+    mHash ^= hashTurnState();
+    return undoRecord;
+}
+
+void GameOfUrModel::undoDiceRoll(const UndoRecord& undoRecord) {
+    assert(undoRecord.mAction == UndoRecord::ROLL_DICE && "This record does not describe a dice roll");
+    restoreFromUndoRecord(undoRecord);
+}
+
+void GameOfUrModel::resolveDiceRoll() {
     // If the dice have been rolled a second time, and...
-    if(mDice->getState() == Dice::State::SECONDARY_ROLLED) {
+    if(mDice.getState() == Dice::State::SECONDARY_ROLLED) {
         // ... we've reached the end of the turn...
         if(
             mGamePhase == GamePhase::INITIATIVE
-            || !(mDice->getResult(GamePhase::PLAY))
-            || getAllPossibleMoves().empty()
+            || !(mDice.getResult(GamePhase::PLAY))
+            || !hasPossibleMoves()
         ) {
             endTurn();
 
         // ... or there is still a move that can be made
-        } else if (mGamePhase == GamePhase::PLAY && !(getAllPossibleMoves().empty())){
+        } else if (mGamePhase == GamePhase::PLAY && hasPossibleMoves()){
             mTurnPhase = TurnPhase::MOVE_PIECE;
 
         } else {
@@ -79,7 +344,7 @@ void GameOfUrModel::rollDice(PlayerID requester) {
         return;
     } 
 
-    assert(mDice->getState() == Dice::State::PRIMARY_ROLLED && "At this point, the dice should have been rolled exactly once");
+    assert(mDice.getState() == Dice::State::PRIMARY_ROLLED && "At this point, the dice should have been rolled exactly once");
     if(mGamePhase == GamePhase::INITIATIVE) return;
     assert(mGamePhase == GamePhase::PLAY && "If we've gotten this far, that must mean we're in the play phase");
 
@@ -87,22 +352,45 @@ void GameOfUrModel::rollDice(PlayerID requester) {
     mRoundPhase = RoundPhase::IN_PROGRESS;
 }
 
-void GameOfUrModel::movePiece(PieceIdentity piece, glm::u8vec2 toLocation, PlayerID requester) {
-    assert(canMovePiece(piece, toLocation, requester) && "this player may not move this piece at the present time");
-    const MoveResultData moveResults { getMoveData(piece, toLocation) };
+UndoRecord GameOfUrModel::applyMove(PieceIdentity piece, glm::u8vec2 toLocation) {
+    assert(canMovePiece(piece, toLocation, mCurrentPlayer) && "this piece may not be moved at the present time");
+    return applyMoveResult(getMoveData(piece, toLocation));
+}
+
+UndoRecord GameOfUrModel::applyMove(const MoveToken& moveToken) {
+    assert(isTokenCurrent(moveToken) && "This move token was not issued for the current state of the game");
+    assert(getPlayer(moveToken.mMoveResult.mMovedPiece.mIdentity.mOwner) == mCurrentPlayer && "Only the current player's pieces may be moved");
+    return applyMoveResult(moveToken.mMoveResult);
+}
+
+UndoRecord GameOfUrModel::applyMoveResult(const MoveResultData& moveResults) {
+    const PieceIdentity piece { moveResults.mMovedPiece.mIdentity };
+    const glm::u8vec2 toLocation { moveResults.mMovedPiece.mLocation };
+    ++mStateVersion;
 
     // update moved piece state
-    std::shared_ptr<Piece> movedPiece { mPlayers[requester].getPiece(piece.mType) };
+    Piece& movedPiece { mPlayers[mCurrentPlayer].getPiece(piece.mType) };
+    UndoRecord undoRecord { beginUndoRecord(UndoRecord::MOVE_PIECE) };
+    undoRecord.mMovedPiece = piece;
+    undoRecord.mMovedFromState = movedPiece.getState();
+    undoRecord.mMovedFromLocation = movedPiece.getLocation();
+    mHash ^= hashTurnState() ^ hashPiece(mCurrentPlayer, movedPiece);
 
     // update displaced piece state, if necessary
-    std::weak_ptr<Piece> weakPtrDisplacedPiece {
-        mBoard.move(getRole(requester), movedPiece, toLocation, mDice->getResult(mGamePhase))
+    const PieceIdentity displacedPieceIdentity {
+        mBoard.move(getRole(mCurrentPlayer), movedPiece, toLocation, mDice.getResult(mGamePhase))
     };
-    if(std::shared_ptr<Piece> displacedPiece = weakPtrDisplacedPiece.lock()) {
+    if(displacedPieceIdentity.mOwner != RoleID::NA) {
         assert(moveResults.mDisplacedPiece.mState == Piece::State::UNLAUNCHED && "Results should indicate that the piece is in the UNLAUNCHED state after move");
         assert(moveResults.mMovedPiece.mState != Piece::State::FINISHED && "No piece may be displaced when the moved piece has completed its route");
-        displacedPiece->setState(Piece::State::UNLAUNCHED);
+        const PlayerID displacedPlayer { getPlayer(displacedPieceIdentity.mOwner) };
+        Piece& displacedPiece { mPlayers[displacedPlayer].getPiece(displacedPieceIdentity.mType) };
+        mHash ^= hashPiece(displacedPlayer, displacedPiece);
+        displacedPiece.setState(Piece::State::UNLAUNCHED);
+        displacedPiece.setLocation(glm::u8vec2{0, 0});
+        mHash ^= hashPiece(displacedPlayer, displacedPiece);
     }
+    undoRecord.mDisplacedPiece = displacedPieceIdentity;
 
     assert(
         (
@@ -110,11 +398,14 @@ void GameOfUrModel::movePiece(PieceIdentity piece, glm::u8vec2 toLocation, Playe
             || moveResults.mMovedPiece.mState == Piece::State::FINISHED
         ) && "The moved piece must either have entered the board or completed its route"
     );
-    movedPiece->setState(moveResults.mMovedPiece.mState);
+    movedPiece.setState(moveResults.mMovedPiece.mState);
+    mHash ^= hashPiece(mCurrentPlayer, movedPiece);
 
     // update counters for the player who moved
-    deductCounters(moveResults.mCountersLost, requester);
-    payCounters(moveResults.mCountersWon, requester);
+    deductCounters(moveResults.mCountersLost, mCurrentPlayer);
+    payCounters(moveResults.mCountersWon, mCurrentPlayer);
+    undoRecord.mCountersLost = moveResults.mCountersLost;
+    undoRecord.mCountersWon = moveResults.mCountersWon;
 
     // update phase data
     endTurn();
@@ -124,54 +415,129 @@ void GameOfUrModel::movePiece(PieceIdentity piece, glm::u8vec2 toLocation, Playe
         mGamePhase = GamePhase::END;
     } else {
         assert(
-            mPlayers[requester].getNPieces(Piece::State::FINISHED) < 5
+            mPlayers[mCurrentPlayer].getNPieces(Piece::State::FINISHED) < 5
             && "There should be at least one piece that hasn't reached the end of the route \
             for this not to be a game ending move"
         );
     }
+
+    mHash ^= hashTurnState();
+    return undoRecord;
 }
 
-void GameOfUrModel::advanceOneTurn(PlayerID requester) {
-    assert(canAdvanceOneTurn(requester) && "cannot advance to next turn at this stage");
+void GameOfUrModel::undoMove(const UndoRecord& undoRecord) {
+    assert(undoRecord.mAction == UndoRecord::MOVE_PIECE && "This record does not describe a move");
+    Piece& movedPiece { mPlayers[undoRecord.mCurrentPlayer].getPiece(undoRecord.mMovedPiece.mType) };
+    const glm::u8vec2 toLocation { movedPiece.getLocation() };
+
+    // return counters won to the common pool, and counters lost to the mover
+    deductCounters(undoRecord.mCountersWon, undoRecord.mCurrentPlayer);
+    payCounters(undoRecord.mCountersLost, undoRecord.mCurrentPlayer);
+
+    // return the moved piece, and any piece it displaced, to where they were
+    mHash ^= hashPiece(undoRecord.mCurrentPlayer, movedPiece);
+    mBoard.undoMove(movedPiece, undoRecord.mMovedFromState, undoRecord.mMovedFromLocation, undoRecord.mDisplacedPiece);
+    movedPiece.setState(undoRecord.mMovedFromState);
+    mHash ^= hashPiece(undoRecord.mCurrentPlayer, movedPiece);
+    if(undoRecord.mDisplacedPiece.mOwner != RoleID::NA) {
+        const PlayerID displacedPlayer { getPlayer(undoRecord.mDisplacedPiece.mOwner) };
+        Piece& displacedPiece { mPlayers[displacedPlayer].getPiece(undoRecord.mDisplacedPiece.mType) };
+        mHash ^= hashPiece(displacedPlayer, displacedPiece);
+        displacedPiece.setState(Piece::State::ON_BOARD);
+        displacedPiece.setLocation(toLocation);
+        mHash ^= hashPiece(displacedPlayer, displacedPiece);
+    }
+
+    restoreFromUndoRecord(undoRecord);
+}
+
+UndoRecord GameOfUrModel::applyTurnAdvance() {
+    assert(canAdvanceOneTurn(mCurrentPlayer) && "cannot advance to next turn at this stage");
+    const UndoRecord undoRecord { beginUndoRecord(UndoRecord::ADVANCE_TURN) };
+    mHash ^= hashTurnState();
+    ++mStateVersion;
 
     // store the current dice roll in case it will be needed later on
-    mPreviousRoll = mDice->getResult(mGamePhase);
-    mDice->reset();
+    mPreviousRoll = mDice.getResult(mGamePhase);
+    mDice.reset();
     mCurrentPlayer = static_cast<PlayerID>((mCurrentPlayer + 1) % mPlayers.size());
     mRoundPhase = RoundPhase::IN_PROGRESS;
     mTurnPhase = TurnPhase::ROLL_DICE;
+    mHash ^= hashTurnState();
 
-    assert(mDice->getState() == Dice::State::UNROLLED && "The dice should have its state reset by now");
-    assert(
-        mCurrentPlayer != requester 
-        && "The requester should have been the one to end the turn, handing over control\
-        to the other player"
-    );
+    assert(mDice.getState() == Dice::State::UNROLLED && "The dice should have its state reset by now");
+
+    return undoRecord;
+}
+
+void GameOfUrModel::undoTurnAdvance(const UndoRecord& undoRecord) {
+    assert(undoRecord.mAction == UndoRecord::ADVANCE_TURN && "This record does not describe a turn advance");
+    restoreFromUndoRecord(undoRecord);
 }
 
 void GameOfUrModel::payCounters(uint8_t counters, PlayerID player) {
     if(counters > mCounters) counters = mCounters;
+    mHash ^= hashCounters(player);
     mCounters -= counters;
     mPlayers[player].depositCounters(counters);
+    mHash ^= hashCounters(player);
     assert(
         (
             (mCounters + mPlayers[PlayerID::PLAYER_A].getNCounters() + mPlayers[PlayerID::PLAYER_B].getNCounters())
-            == 50
-        ) && "There should be 50 counters in all"
+            == kUrRuleset.getTotalCounters()
+        ) && "Every counter in the game should be accounted for"
     );
 }
 
 void GameOfUrModel::deductCounters(uint8_t counters, PlayerID player) {
+    mHash ^= hashCounters(player);
     counters = mPlayers[player].deductCounters(counters);
     mCounters += counters;
+    mHash ^= hashCounters(player);
     assert(
         (
             (mCounters + mPlayers[PlayerID::PLAYER_A].getNCounters() + mPlayers[PlayerID::PLAYER_B].getNCounters())
-            == 50
-        ) && "There should be 50 counters in all"
+            == kUrRuleset.getTotalCounters()
+        ) && "Every counter in the game should be accounted for"
+    );
+}
+
+uint64_t GameOfUrModel::computeHash() const {
+    uint64_t hash { hashTurnState() ^ kZobristKeys.getPoolCounterKey(mCounters) };
+    for(uint8_t player { 0 }; player < mPlayers.size(); ++player) {
+        hash ^= kZobristKeys.getPlayerCounterKey(player, mPlayers[player].getNCounters());
+
+        // pieces aren't dealt out until players are assigned roles, and
+        // are considered unlaunched until then
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            hash ^= (
+                mPlayers[player].getRole() == RoleID::NA?
+                    kZobristKeys.getPieceKey(player, static_cast<PieceTypeID>(type), Piece::State::UNLAUNCHED, glm::u8vec2{0, 0}):
+                    hashPiece(static_cast<PlayerID>(player), mPlayers[player].cGetPiece(static_cast<PieceTypeID>(type)))
+            );
+        }
+    }
+    return hash;
+}
+
+uint64_t GameOfUrModel::hashTurnState() const {
+    return (
+        kZobristKeys.getPhaseKey(mGamePhase, mTurnPhase, mRoundPhase)
+        ^ kZobristKeys.getCurrentPlayerKey(mCurrentPlayer)
+        ^ kZobristKeys.getDiceKey(mDice.getState(), mDice.getPrimaryRoll(), mDice.getSecondaryRoll())
+        ^ kZobristKeys.getPreviousRollKey(mPreviousRoll)
+        ^ kZobristKeys.getRoleKey(mPlayers[PlayerID::PLAYER_A].getRole())
     );
 }
 
+uint64_t GameOfUrModel::hashCounters(PlayerID player) const {
+    return kZobristKeys.getPoolCounterKey(mCounters) ^ kZobristKeys.getPlayerCounterKey(player, mPlayers[player].getNCounters());
+}
+
+uint64_t GameOfUrModel::hashPiece(PlayerID player, const Piece& piece) const {
+    return kZobristKeys.getPieceKey(player, piece.getType(), piece.getState(), piece.getLocation());
+}
+
 bool GameOfUrModel::canRollDice(PlayerID requester) const {
     return (
         // The dice can be rolled in every phase by whoever's turn it
@@ -179,7 +545,7 @@ bool GameOfUrModel::canRollDice(PlayerID requester) const {
         requester == mCurrentPlayer
         && mGamePhase != GamePhase::END
         && mTurnPhase != TurnPhase::END
-        && mDice->canRoll()
+        && mDice.canRoll()
     );
 }
 
@@ -203,16 +569,18 @@ const Piece& GameOfUrModel::getPiece(const PieceIdentity& pieceIdentity) const {
 
 RoleID GameOfUrModel::getWinner() const {
     if(mGamePhase != GamePhase::END) return RoleID::NA;
-    const uint8_t nVictoryPiecesA { mPlayers[PLAYER_A].getNPieces(Piece::State::FINISHED) };
-    const uint8_t nVictoryPiecesB { mPlayers[PLAYER_B].getNPieces(Piece::State::FINISHED) };
-    assert(
-        nVictoryPiecesA != nVictoryPiecesB
-        && (
-            nVictoryPiecesA == 5
-            || nVictoryPiecesB == 5
-        ) && "Invalid victory state; requires review"
-    );
-    return nVictoryPiecesA == 5? getRole(PLAYER_A): getRole(PLAYER_B);
+    return getDerived(mWinner, [this]() {
+        const uint8_t nVictoryPiecesA { mPlayers[PLAYER_A].getNPieces(Piece::State::FINISHED) };
+        const uint8_t nVictoryPiecesB { mPlayers[PLAYER_B].getNPieces(Piece::State::FINISHED) };
+        assert(
+            nVictoryPiecesA != nVictoryPiecesB
+            && (
+                nVictoryPiecesA == 5
+                || nVictoryPiecesB == 5
+            ) && "Invalid victory state; requires review"
+        );
+        return nVictoryPiecesA == 5? getRole(PLAYER_A): getRole(PLAYER_B);
+    });
 }
 
 RoleID GameOfUrModel::getRole(PlayerID player) const {
@@ -240,7 +608,7 @@ bool GameOfUrModel::canMovePiece(PieceIdentity pieceIdentity, glm::u8vec2 toLoca
         mGamePhase == GamePhase::PLAY
         && mTurnPhase == TurnPhase::MOVE_PIECE
         && requester == mCurrentPlayer
-        && mBoard.canMove(mPlayers[requester].getRole(), getPiece(pieceIdentity), toLocation, mDice->getResult(mGamePhase))
+        && mBoard.canMove(mPlayers[requester].getRole(), getPiece(pieceIdentity), toLocation, mDice.getResult(mGamePhase))
     );
 }
 bool GameOfUrModel::canMoveBoardPiece(PieceIdentity pieceIdentity, PlayerID requester) const {
@@ -274,12 +642,9 @@ bool GameOfUrModel::canLaunchPiece(PieceIdentity pieceIdentity, PlayerID request
         || getPiece(pieceIdentity).getState() != Piece::State::UNLAUNCHED
     ) return false;
 
-    for(auto& movePair: getAllPossibleMoves()) {
-        if(movePair.first.mOwner == pieceIdentity.mOwner && movePair.first.mType == pieceIdentity.mType) {
-            return true;
-        }
+    for(const MoveResultData& moveResult: getPossibleMoveData()) {
+        if(moveResult.mMovedPiece.mIdentity == pieceIdentity) return true;
     }
-
     return false;
 }
 
@@ -299,7 +664,7 @@ bool GameOfUrModel::canAdvanceOneTurn(PlayerID requester) const {
 
                     // continue rolling dice for initiative until one player rolls
                     // higher than the other
-                    || mPreviousRoll == mDice->getResult(GamePhase::INITIATIVE)
+                    || mPreviousRoll == mDice.getResult(GamePhase::INITIATIVE)
                 )
             )
         )
@@ -313,8 +678,8 @@ bool GameOfUrModel::canStartPhasePlay() const {
         mGamePhase == GamePhase::INITIATIVE
         && mRoundPhase == RoundPhase::END
         && mTurnPhase == TurnPhase::END
-        && mDice->getState() == Dice::SECONDARY_ROLLED
-        && mDice->getResult(GamePhase::INITIATIVE) != mPreviousRoll
+        && mDice.getState() == Dice::SECONDARY_ROLLED
+        && mDice.getResult(GamePhase::INITIATIVE) != mPreviousRoll
     );
 }
 
@@ -329,13 +694,19 @@ GamePhaseData GameOfUrModel::getCurrentPhase() const {
 }
 
 GameScoreData GameOfUrModel::getScore() const {
-    return {
-        .mCommonPoolCounters { mCounters },
-        .mPlayerOneCounters { static_cast<uint8_t>(mGamePhase != GamePhase::INITIATIVE? mPlayers[getPlayer(RoleID::BLACK)].getNCounters(): 0) },
-        .mPlayerTwoCounters { static_cast<uint8_t>(mGamePhase != GamePhase::INITIATIVE? mPlayers[getPlayer(RoleID::WHITE)].getNCounters(): 0) },
-        .mPlayerOneVictoryPieces { static_cast<uint8_t>(mGamePhase != GamePhase::INITIATIVE? mPlayers[getPlayer(RoleID::BLACK)].getNPieces(Piece::State::FINISHED): 0) },
-        .mPlayerTwoVictoryPieces { static_cast<uint8_t>(mGamePhase != GamePhase::INITIATIVE? mPlayers[getPlayer(RoleID::WHITE)].getNPieces(Piece::State::FINISHED): 0) },
-    };
+    return getDerived(mScore, [this]() {
+        GameScoreData score {};
+        score.mCommonPoolCounters = mCounters;
+        if(mGamePhase == GamePhase::INITIATIVE) return score;
+
+        const Player& black { mPlayers[getPlayer(RoleID::BLACK)] };
+        const Player& white { mPlayers[getPlayer(RoleID::WHITE)] };
+        score.mPlayerOneCounters = black.getNCounters();
+        score.mPlayerTwoCounters = white.getNCounters();
+        score.mPlayerOneVictoryPieces = black.getNPieces(Piece::State::FINISHED);
+        score.mPlayerTwoVictoryPieces = white.getNPieces(Piece::State::FINISHED);
+        return score;
+    });
 }
 
 HouseData GameOfUrModel::getHouseData(glm::u8vec2 location) const {
@@ -365,15 +736,17 @@ GamePieceData GameOfUrModel::getPieceData(PlayerID player, PieceTypeID pieceType
 }
 
 PlayerData GameOfUrModel::getPlayerData(PlayerID player) const {
-    return {
-        .mPlayer { player },
-        .mRole { mPlayers[player].getRole() },
-        .mIsWinner { mPlayers[player].getRole() == getWinner() },
-        .mCounters { mPlayers[player].getNCounters() },
-        .mNUnlaunchedPieces { mPlayers[player].getNPieces(Piece::State::UNLAUNCHED) },
-        .mNBoardPieces { mPlayers[player].getNPieces(Piece::State::ON_BOARD) },
-        .mNVictoryPieces { mPlayers[player].getNPieces(Piece::State::FINISHED) },
-    };
+    return getDerived(mPlayerData[player], [this, player]() -> PlayerData {
+        return {
+            .mPlayer { player },
+            .mRole { mPlayers[player].getRole() },
+            .mIsWinner { mPlayers[player].getRole() == getWinner() },
+            .mCounters { mPlayers[player].getNCounters() },
+            .mNUnlaunchedPieces { mPlayers[player].getNPieces(Piece::State::UNLAUNCHED) },
+            .mNBoardPieces { mPlayers[player].getNPieces(Piece::State::ON_BOARD) },
+            .mNVictoryPieces { mPlayers[player].getNPieces(Piece::State::FINISHED) },
+        };
+    });
 }
 
 PlayerData GameOfUrModel::getCurrentPlayer() const {
@@ -386,14 +759,171 @@ PlayerData GameOfUrModel::getPlayerData(RoleID role) const {
 
 DiceData GameOfUrModel::getDiceData() const {
     return {
-        .mState { mDice->getState() },
-        .mPrimaryRoll { mDice->getPrimaryRoll() },
-        .mSecondaryRoll { mDice->getSecondaryRoll() },
-        .mResultScore { mDice->getResult(mGamePhase) },
+        .mState { mDice.getState() },
+        .mPrimaryRoll { mDice.getPrimaryRoll() },
+        .mSecondaryRoll { mDice.getSecondaryRoll() },
+        .mResultScore { mDice.getResult(mGamePhase) },
         .mPreviousResult { mPreviousRoll },
     };
 }
 
+GamePosition GameOfUrModel::getPosition() const {
+    assert(mGamePhase != GamePhase::INITIATIVE && "Pieces have no owners before roles are assigned");
+    GamePosition position {
+        .mTurn { getRole(mCurrentPlayer) },
+        .mTurnPhase { mTurnPhase },
+    };
+    for(uint8_t role { RoleID::BLACK }; role <= RoleID::WHITE; ++role) {
+        const Player& player { mPlayers[getPlayer(static_cast<RoleID>(role))] };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const Piece& piece { player.cGetPiece(static_cast<PieceTypeID>(type)) };
+            position.mPieces[role - 1][type] = {
+                .mState { piece.getState() },
+                .mRoutePosition {
+                    piece.getState() == Piece::State::ON_BOARD?
+                        kRouteTables[role].getRoutePosition(piece.getLocation()):
+                        uint8_t { 0 }
+                },
+            };
+        }
+    }
+    return position;
+}
+
+GameSnapshot GameOfUrModel::getSnapshot() const {
+    GameSnapshot snapshot {};
+    snapshot.mBytes[GameSnapshot::FORMAT_VERSION] = GameSnapshot::kFormatVersion;
+    snapshot.mBytes[GameSnapshot::PHASES] = static_cast<uint8_t>(
+        static_cast<uint8_t>(mGamePhase)
+        | (static_cast<uint8_t>(mTurnPhase) << 2)
+        | (static_cast<uint8_t>(mRoundPhase) << 4)
+        | (mCurrentPlayer << 5)
+        | (mPlayers[PlayerID::PLAYER_A].getRole() << 6)
+    );
+    snapshot.mBytes[GameSnapshot::DICE] = static_cast<uint8_t>(
+        mDice.getState()
+        | ((mDice.getPrimaryRoll() - 1) << 2)
+        | (mDice.getSecondaryRoll() << 4)
+    );
+    snapshot.mBytes[GameSnapshot::PREVIOUS_ROLL] = mPreviousRoll;
+    snapshot.mBytes[GameSnapshot::POOL_COUNTERS] = mCounters;
+
+    for(uint8_t player { 0 }; player < mPlayers.size(); ++player) {
+        snapshot.mBytes[GameSnapshot::PLAYER_COUNTERS + player] = mPlayers[player].getNCounters();
+
+        // pieces aren't dealt out until players are assigned roles, and
+        // are left as unlaunched until then
+        const RoleID role { mPlayers[player].getRole() };
+        if(role == RoleID::NA) continue;
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const Piece& piece { mPlayers[player].cGetPiece(static_cast<PieceTypeID>(type)) };
+            snapshot.mBytes[GameSnapshot::PIECES + player * PieceTypeID::TOTAL + type] = static_cast<uint8_t>(
+                static_cast<uint8_t>(piece.getState())
+                | (
+                    piece.getState() == Piece::State::ON_BOARD?
+                        (kRouteTables[role].getRoutePosition(piece.getLocation()) << 2):
+                        0
+                )
+            );
+        }
+    }
+    return snapshot;
+}
+
+bool GameOfUrModel::restoreSnapshot(const GameSnapshot& snapshot) {
+    const std::array<uint8_t, GameSnapshot::TOTAL>& bytes { snapshot.mBytes };
+    if(bytes[GameSnapshot::FORMAT_VERSION] != GameSnapshot::kFormatVersion) return false;
+
+    const uint8_t phases { bytes[GameSnapshot::PHASES] };
+    const uint8_t dice { bytes[GameSnapshot::DICE] };
+    const uint8_t* playerCounters { &bytes[GameSnapshot::PLAYER_COUNTERS] };
+    const GamePhase gamePhase { static_cast<GamePhase>(phases & 0x3u) };
+    const TurnPhase turnPhase { static_cast<TurnPhase>((phases >> 2) & 0x3u) };
+    const RoleID playerARole { static_cast<RoleID>(phases >> 6) };
+    const Dice::State diceState { static_cast<Dice::State>(dice & 0x3u) };
+    if(
+        gamePhase > GamePhase::END
+        || turnPhase > TurnPhase::END
+        || playerARole > RoleID::WHITE
+        || diceState > Dice::State::SECONDARY_ROLLED
+        || (dice >> 5)
+        // no roll scores more than 10
+        || bytes[GameSnapshot::PREVIOUS_ROLL] > 10
+        // roles are assigned exactly when the initiative phase ends
+        || (gamePhase == GamePhase::INITIATIVE) != (playerARole == RoleID::NA)
+        || bytes[GameSnapshot::POOL_COUNTERS] + playerCounters[PlayerID::PLAYER_A] + playerCounters[PlayerID::PLAYER_B] != kUrRuleset.getTotalCounters()
+    ) return false;
+
+    // check every piece before anything is changed, so that this game is left
+    // untouched should the snapshot turn out to be invalid
+    const RoleID playerBRole {
+        playerARole == RoleID::NA? RoleID::NA:
+        playerARole == RoleID::BLACK? RoleID::WHITE:
+        RoleID::BLACK
+    };
+    const std::array<RoleID, 2> roles { playerARole, playerBRole };
+    const uint8_t* pieceBytes { &bytes[GameSnapshot::PIECES] };
+    uint32_t occupiedHouses { 0 };
+    for(uint8_t piece { 0 }; piece < 2 * PieceTypeID::TOTAL; ++piece) {
+        const Piece::State state { static_cast<Piece::State>(pieceBytes[piece] & 0x3u) };
+        const uint8_t routePosition { static_cast<uint8_t>(pieceBytes[piece] >> 2) };
+        const RoleID role { roles[piece / PieceTypeID::TOTAL] };
+
+        // pieces are unlaunched until they are dealt out along with roles
+        if(role == RoleID::NA && pieceBytes[piece]) return false;
+        if(state != Piece::State::ON_BOARD) {
+            if(state > Piece::State::FINISHED || routePosition) return false;
+            continue;
+        }
+
+        if(routePosition >= RouteTable::kRouteEnd) return false;
+        const uint32_t house { 1u << Board::getHouseIndex(kRouteTables[role].getLocation(routePosition)) };
+        if(occupiedHouses & house) return false;
+        occupiedHouses |= house;
+    }
+
+    // tokens issued before the restore must not be mistaken for ones issued after it
+    ++mStateVersion;
+
+    mGamePhase = gamePhase;
+    mTurnPhase = turnPhase;
+    mRoundPhase = static_cast<RoundPhase>((phases >> 4) & 0x1u);
+    mCurrentPlayer = static_cast<PlayerID>((phases >> 5) & 0x1u);
+    mDice.restore(diceState, ((dice >> 2) & 0x3u) + 1, (dice >> 4) & 0x1u);
+    mPreviousRoll = bytes[GameSnapshot::PREVIOUS_ROLL];
+    mCounters = bytes[GameSnapshot::POOL_COUNTERS];
+    mBoard = Board {};
+
+    for(uint8_t player { 0 }; player < mPlayers.size(); ++player) {
+        mPlayers[player] = Player {};
+        mPlayers[player].deductCounters(mPlayers[player].getNCounters());
+        mPlayers[player].depositCounters(playerCounters[player]);
+        if(roles[player] == RoleID::NA) continue;
+
+        mPlayers[player].initializeWithRole(roles[player]);
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const uint8_t pieceByte { pieceBytes[player * PieceTypeID::TOTAL + type] };
+            Piece& piece { mPlayers[player].getPiece(static_cast<PieceTypeID>(type)) };
+            piece.setState(static_cast<Piece::State>(pieceByte & 0x3u));
+            switch(piece.getState()) {
+                case Piece::State::UNLAUNCHED:
+                    break;
+
+                case Piece::State::ON_BOARD:
+                    piece.setLocation(kRouteTables[roles[player]].getLocation(pieceByte >> 2));
+                    mBoard.place(piece);
+                    break;
+
+                case Piece::State::FINISHED:
+                    piece.setLocation(kRouteTables[roles[player]].getLocation(RouteTable::kRouteEnd));
+                    break;
+            }
+        }
+    }
+    mHash = computeHash();
+    return true;
+}
+
 MoveResultData GameOfUrModel::getBoardMoveData(PieceIdentity pieceID) const {
     assert(pieceID.mOwner != RoleID::NA && "Pieces without owners are invalid");
     if(mGamePhase != GamePhase::PLAY || mTurnPhase != TurnPhase::MOVE_PIECE) {
@@ -401,7 +931,7 @@ MoveResultData GameOfUrModel::getBoardMoveData(PieceIdentity pieceID) const {
     }
 
     const Piece& piece { mPlayers[getPlayer(pieceID.mOwner)].cGetPiece(pieceID.mType) };
-    const glm::u8vec2 moveLocation { mBoard.computeMoveLocation(piece, mDice->getResult(mGamePhase)) };
+    const glm::u8vec2 moveLocation { mBoard.computeMoveLocation(piece, mDice.getResult(mGamePhase)) };
     if(!canMovePiece(pieceID, moveLocation, getPlayer(pieceID.mOwner))) {
         return { };
     }
@@ -423,10 +953,19 @@ MoveResultData GameOfUrModel::getLaunchMoveData(PieceIdentity pieceID, glm::u8ve
 }
 
 MoveResultData GameOfUrModel::getMoveData(PieceIdentity pieceID, glm::u8vec2 moveLocation) const {
-    const Piece& piece { mPlayers[getPlayer(pieceID.mOwner)].cGetPiece(pieceID.mType) };
-    MoveResultData::flags moveFlags {
-        MoveResultData::IS_POSSIBLE
-    };
+    const Player& player { mPlayers[getPlayer(pieceID.mOwner)] };
+    const Piece& piece { player.cGetPiece(pieceID.mType) };
+
+    MoveResultData::flags routeFlags { MoveResultData::IS_POSSIBLE };
+    routeFlags |= mBoard.movePassesRosette(piece, moveLocation)? MoveResultData::PASSES_ROSETTE: 0;
+    routeFlags |= mBoard.isRosette(moveLocation)? MoveResultData::LANDS_ON_ROSETTE: 0;
+    routeFlags |= mBoard.isRouteEnd(moveLocation)? MoveResultData::COMPLETES_ROUTE: 0;
+
+    return makeMoveResult(pieceID, moveLocation, routeFlags, player.getNPieces(Piece::State::FINISHED), player.getNCounters());
+}
+
+MoveResultData GameOfUrModel::makeMoveResult(PieceIdentity pieceID, glm::u8vec2 moveLocation, MoveResultData::flags routeFlags, uint8_t nFinishedPieces, uint8_t playerCounters) const {
+    MoveResultData::flags moveFlags { routeFlags };
 
     GamePieceData displacedPieceData {.mIdentity{.mType{PieceTypeID::SWALLOW},.mOwner{RoleID::NA},}, .mState{}, .mLocation{},};
     if(mBoard.houseIsOccupied(moveLocation)) {
@@ -435,37 +974,35 @@ MoveResultData GameOfUrModel::getMoveData(PieceIdentity pieceID, glm::u8vec2 mov
         displacedPieceData.mLocation = glm::u8vec2 {0, 0};
     }
 
-    GamePieceData movedPieceData { getPieceData(pieceID) };
-    movedPieceData.mLocation = moveLocation;
-
-    moveFlags |= mBoard.movePassesRosette(piece, moveLocation)? MoveResultData::PASSES_ROSETTE: 0;
-    moveFlags |= mBoard.isRosette(moveLocation)? MoveResultData::LANDS_ON_ROSETTE: 0;
-    moveFlags |= mBoard.isRouteEnd(moveLocation)? MoveResultData::COMPLETES_ROUTE: 0;
     moveFlags |= (
         (
             (moveFlags&MoveResultData::COMPLETES_ROUTE)
         ) && (
-            mPlayers[getPlayer(pieceID.mOwner)].getNPieces(Piece::State::FINISHED) == 4
+            nFinishedPieces == 4
         )
     )? MoveResultData::ENDS_GAME: 0;
 
-
+    const uint8_t cost { kGamePieceTypes[pieceID.mType].mCost };
     const uint8_t nCountersLost { 
         (
             (moveFlags&MoveResultData::PASSES_ROSETTE) && !(
                 (moveFlags&MoveResultData::LANDS_ON_ROSETTE) 
                 || (moveFlags&MoveResultData::COMPLETES_ROUTE)
             )
-        )? static_cast<uint8_t>(std::min(kGamePieceTypes[piece.getType()].mCost, mPlayers[getPlayer(pieceID.mOwner)].getNCounters())):
+        )? std::min(cost, playerCounters):
         static_cast<uint8_t>(0)
     };
     const uint8_t nCountersWon { 
         (moveFlags&MoveResultData::LANDS_ON_ROSETTE)?
-        static_cast<uint8_t>(std::min(kGamePieceTypes[piece.getType()].mCost, mCounters)):
-        (moveFlags&MoveResultData::ENDS_GAME)? static_cast<uint8_t>(mCounters): static_cast<uint8_t>(0)
+        std::min(cost, mCounters):
+        (moveFlags&MoveResultData::ENDS_GAME)? mCounters: static_cast<uint8_t>(0)
     };
 
-    movedPieceData.mState = ((moveFlags&MoveResultData::COMPLETES_ROUTE)? Piece::State::FINISHED: Piece::State::ON_BOARD);
+    const GamePieceData movedPieceData {
+        .mIdentity { pieceID },
+        .mState { (moveFlags&MoveResultData::COMPLETES_ROUTE)? Piece::State::FINISHED: Piece::State::ON_BOARD },
+        .mLocation { moveLocation },
+    };
 
     return {
         .mFlags { moveFlags },
@@ -476,45 +1013,47 @@ MoveResultData GameOfUrModel::getMoveData(PieceIdentity pieceID, glm::u8vec2 mov
     };
 }
 
-std::vector<std::pair<PieceIdentity, glm::u8vec2>> GameOfUrModel::getAllPossibleMoves() const {
-    if(
-        mGamePhase != GamePhase::PLAY
-        || mTurnPhase != TurnPhase::MOVE_PIECE
-    ) return {};
-    const RoleID activeRole { getRole(mCurrentPlayer) };
-
-    std::vector<std::pair<PieceIdentity, glm::u8vec2>> possibleMoves {};
+MoveList GameOfUrModel::getAllPossibleMoves() const {
+    MoveList possibleMoves {};
+    for(const MoveResultData& moveResult: getPossibleMoveData()) {
+        possibleMoves.push_back(moveResult.mMovedPiece.mIdentity, moveResult.mMovedPiece.mLocation);
+    }
+    return possibleMoves;
+}
 
-    for(uint8_t type {0}; type < PieceTypeID::TOTAL; ++type) {
+MoveResultList GameOfUrModel::getAllPossibleMoveData() const {
+    return getPossibleMoveData();
+}
 
-        const PieceIdentity pieceIdentity { PieceIdentity{.mType { static_cast<PieceTypeID>(type) }, .mOwner {activeRole} } };
-        const Piece& piece { getPiece(pieceIdentity) };
-        const uint8_t diceRoll { mDice->getResult(GamePhase::PLAY) };
+const MoveResultList& GameOfUrModel::getPossibleMoveData() const {
+    return getDerived(mPossibleMoveData, [this]() {
+        MoveResultList possibleMoveData {};
+        if(mGamePhase != GamePhase::PLAY || mTurnPhase != TurnPhase::MOVE_PIECE) return possibleMoveData;
 
-        switch(piece.getState()) {
-            case Piece::State::UNLAUNCHED:
-                for(glm::u8vec2 launchPosition: mBoard.getLaunchPositions(pieceIdentity)) {
-                    if(mBoard.canMove(activeRole, piece, launchPosition, diceRoll)) {
-                        possibleMoves.push_back({pieceIdentity, launchPosition});
-                    }
-                }
-                break;
+        // facts about the mover shared by every move
+        const Player& activePlayer { mPlayers[mCurrentPlayer] };
+        const uint8_t nFinishedPieces { activePlayer.getNPieces(Piece::State::FINISHED) };
+        const uint8_t playerCounters { activePlayer.getNCounters() };
 
-            case Piece::State::ON_BOARD: 
-                {
-                    const glm::u8vec2 movePosition { mBoard.computeMoveLocation(piece, diceRoll) };
-                    if(mBoard.canMove(activeRole, piece, mBoard.computeMoveLocation(piece, diceRoll), diceRoll)) {
-                        possibleMoves.push_back({pieceIdentity, movePosition});
-                    }
-                }
-                break;
+        visitPossibleMoves([&](PieceIdentity piece, glm::u8vec2 toLocation, MoveResultData::flags routeFlags) {
+            possibleMoveData.push_back(makeMoveResult(piece, toLocation, routeFlags, nFinishedPieces, playerCounters));
+            return true;
+        });
+        return possibleMoveData;
+    });
+}
 
-            case Piece::State::FINISHED:
-                break;
-        }
-    }
+uint8_t GameOfUrModel::countPossibleMoves() const {
+    return static_cast<uint8_t>(getPossibleMoveData().size());
+}
 
-    return possibleMoves;
+bool GameOfUrModel::hasPossibleMoves() const {
+    bool movePossible { false };
+    visitPossibleMoves([&movePossible](PieceIdentity, glm::u8vec2, MoveResultData::flags) {
+        movePossible = true;
+        return false;
+    });
+    return movePossible;
 }
 
 std::vector<glm::u8vec2> GameOfUrModel::getLaunchPositions(const PieceIdentity& pieceIdentity) const {
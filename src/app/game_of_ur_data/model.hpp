@@ -24,13 +24,16 @@
 
 #include <cstdint>
 #include <array>
-#include <memory>
-
+#include <type_traits>
 
 #include "phase.hpp"
 #include "board.hpp"
 #include "player.hpp"
 #include "dice.hpp"
+#include "random_engine.hpp"
+#include "move_list.hpp"
+#include "zobrist.hpp"
+#include "position_index.hpp"
 
 /**
  * @ingroup UrGameDataModel
@@ -325,6 +328,388 @@ struct MoveResultData {
     uint8_t mCountersLost;
 };
 
+/**
+ * @ingroup UrGameDataModel
+ * @brief Proof, issued by GameOfUrModel, that a move was found to be valid in a particular state of the game, along with the move's precomputed results.
+ * 
+ * A token may be applied with GameOfUrModel::movePiece(const MoveToken&) for as long as the model issuing it remains unchanged, without the move being validated again.
+ * 
+ * @see GameOfUrModel::validateLaunch()
+ * @see GameOfUrModel::validateBoardMove()
+ */
+struct MoveToken {
+    /**
+     * @brief The results of making the move, whose MoveResultData::IS_POSSIBLE flag is unset if the move was found to be invalid.
+     * 
+     */
+    MoveResultData mMoveResult;
+
+    /**
+     * @brief The version of the model's state in which the move was validated.
+     * 
+     */
+    uint32_t mStateVersion;
+
+    /**
+     * @brief Tests whether the move was found to be valid when this token was issued.
+     * 
+     * @retval true The move was valid.
+     * @retval false The move was invalid, and this token may not be applied.
+     */
+    bool isValid() const { return mMoveResult.mFlags & MoveResultData::IS_POSSIBLE; }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A list of the results of every move available on a single turn, whose storage lives wherever the list itself does.
+ * 
+ * @see MoveList
+ */
+class MoveResultList {
+public:
+    /**
+     * @brief The maximum number of moves this list can hold.
+     * 
+     */
+    static constexpr uint8_t kCapacity { MoveList::kCapacity };
+
+    /**
+     * @brief Adds the results of a move to the end of this list.
+     * 
+     * @param moveResult The results of the move.
+     */
+    void push_back(const MoveResultData& moveResult) {
+        assert(mSize < kCapacity && "A move list cannot hold more moves than are possible in a single turn");
+        mMoveResults[mSize++] = moveResult;
+    }
+
+    /**
+     * @brief Gets the number of moves in this list.
+     * 
+     * @return std::size_t The number of moves in this list.
+     */
+    std::size_t size() const { return mSize; }
+
+    /**
+     * @brief Tests whether this list holds no moves.
+     * 
+     * @retval true There are no moves in this list.
+     * @retval false There is at least one move in this list.
+     */
+    bool empty() const { return mSize == 0; }
+
+    /**
+     * @brief Gets the results of a move in this list.
+     * 
+     * @param index The position of the move in this list.
+     * @return const MoveResultData& The results of the move at that position.
+     */
+    const MoveResultData& operator[](std::size_t index) const {
+        assert(index < mSize && "Move index out of range");
+        return mMoveResults[index];
+    }
+
+    /**
+     * @brief Gets an iterator to the first move in this list.
+     * 
+     * @return const MoveResultData* The first move in this list.
+     */
+    const MoveResultData* begin() const { return mMoveResults.data(); }
+
+    /**
+     * @brief Gets an iterator to one past the last move in this list.
+     * 
+     * @return const MoveResultData* One past the last move in this list.
+     */
+    const MoveResultData* end() const { return mMoveResults.data() + mSize; }
+
+private:
+    /**
+     * @brief Storage for the moves in this list, of which only the first mSize are meaningful.
+     * 
+     */
+    std::array<MoveResultData, kCapacity> mMoveResults {};
+
+    /**
+     * @brief The number of moves in this list.
+     * 
+     */
+    uint8_t mSize { 0 };
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A compact record of everything changed by a single action applied to GameOfUrModel, from which the action can be reverted.
+ * 
+ * Produced by GameOfUrModel::applyMove(), GameOfUrModel::applyDiceRoll(), and GameOfUrModel::applyTurnAdvance(), and consumed by their corresponding undo methods.  Records must be undone in the reverse of the order they were produced in.
+ * 
+ */
+struct UndoRecord {
+    /**
+     * @brief The kinds of action that may be recorded.
+     * 
+     */
+    enum Action: uint8_t {
+        MOVE_PIECE, //< A piece was launched or moved on the board.
+        ROLL_DICE, //< One of the dice was rolled.
+        ADVANCE_TURN, //< The turn passed to the next player.
+    };
+
+    /**
+     * @brief The kind of action recorded.
+     * 
+     */
+    Action mAction;
+
+    /**
+     * @brief The phase of the game before the action.
+     * 
+     */
+    GamePhase mGamePhase;
+
+    /**
+     * @brief The phase of the turn before the action.
+     * 
+     */
+    TurnPhase mTurnPhase;
+
+    /**
+     * @brief The phase of the round before the action.
+     * 
+     */
+    RoundPhase mRoundPhase;
+
+    /**
+     * @brief The player whose turn it was before the action.
+     * 
+     */
+    PlayerID mCurrentPlayer;
+
+    /**
+     * @brief The result of the previous turn's dice roll before the action.
+     * 
+     */
+    uint8_t mPreviousRoll;
+
+    /**
+     * @brief The state of the dice before the action.
+     * 
+     */
+    Dice::State mDiceState;
+
+    /**
+     * @brief The value of the primary die before the action.
+     * 
+     */
+    uint8_t mPrimaryRoll;
+
+    /**
+     * @brief The value of the secondary die before the action.
+     * 
+     */
+    bool mSecondaryRoll;
+
+    /**
+     * @brief The piece moved, for Action::MOVE_PIECE.
+     * 
+     */
+    PieceIdentity mMovedPiece;
+
+    /**
+     * @brief The state of the moved piece before it was moved, for Action::MOVE_PIECE.
+     * 
+     */
+    Piece::State mMovedFromState;
+
+    /**
+     * @brief The location of the moved piece before it was moved, for Action::MOVE_PIECE.
+     * 
+     */
+    glm::u8vec2 mMovedFromLocation;
+
+    /**
+     * @brief The piece knocked off the board by the move, with an owner of RoleID::NA if there wasn't one, for Action::MOVE_PIECE.
+     * 
+     */
+    PieceIdentity mDisplacedPiece;
+
+    /**
+     * @brief The number of counters the mover paid into the common pool, for Action::MOVE_PIECE.
+     * 
+     */
+    uint8_t mCountersLost;
+
+    /**
+     * @brief The number of counters the mover took from the common pool, for Action::MOVE_PIECE.
+     * 
+     */
+    uint8_t mCountersWon;
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A compact description of everything one action changed in the state of GameOfUrModel, meant for those who only want to do work in proportion to the change.
+ * 
+ * Returned by GameOfUrModel::startPhasePlay(), GameOfUrModel::rollDice(), GameOfUrModel::movePiece(), and GameOfUrModel::advanceOneTurn().
+ * 
+ */
+struct StateDelta {
+    /**
+     * @brief The underlying type of the variable in which the fields changed are stored.
+     * 
+     */
+    using fields=uint8_t;
+
+    /**
+     * @brief Enum values corresponding to masks used on fields to tell which parts of the state changed.
+     * 
+     */
+    enum Fields: fields {
+        GAME_PHASE=0x1, //< GamePhaseData::mGamePhase changed.
+        ROUND_PHASE=0x2, //< GamePhaseData::mRoundPhase changed.
+        TURN_PHASE=0x4, //< GamePhaseData::mTurnPhase changed.
+        TURN=0x8, //< GamePhaseData::mTurn changed.
+        WINNER=0x10, //< GamePhaseData::mWinner changed.
+        DICE=0x20, //< Anything reported by DiceData changed.
+        ROLES=0x40, //< The roles of the players were assigned.
+    };
+
+    /**
+     * @brief A piece whose state or location was changed by the action.
+     * 
+     */
+    struct PieceChange {
+        /**
+         * @brief The identity of the piece.
+         * 
+         */
+        PieceIdentity mPiece;
+
+        /**
+         * @brief The state of the piece before the action.
+         * 
+         */
+        Piece::State mFromState;
+
+        /**
+         * @brief The location of the piece before the action.
+         * 
+         */
+        glm::u8vec2 mFromLocation;
+
+        /**
+         * @brief The state of the piece after the action.
+         * 
+         */
+        Piece::State mToState;
+
+        /**
+         * @brief The location of the piece after the action.
+         * 
+         */
+        glm::u8vec2 mToLocation;
+    };
+
+    /**
+     * @brief Tests whether any of some fields were changed by the action.
+     * 
+     * @param fieldMask A combination of Fields.
+     * @retval true At least one of the fields changed.
+     * @retval false None of the fields changed.
+     */
+    bool hasChanged(fields fieldMask) const { return mChangedFields & fieldMask; }
+
+    /**
+     * @brief Tests whether any counters changed hands during the action.
+     * 
+     * @retval true The common pool or either player gained or lost counters.
+     * @retval false No counters changed hands.
+     */
+    bool hasCounterChanges() const {
+        return mCommonPoolCountersChange || mPlayerCountersChanges[PlayerID::PLAYER_A] || mPlayerCountersChanges[PlayerID::PLAYER_B];
+    }
+
+    /**
+     * @brief The fields changed by the action, a combination of Fields.
+     * 
+     */
+    fields mChangedFields;
+
+    /**
+     * @brief The phase of the game after the action, whose changed members are given by mChangedFields.
+     * 
+     */
+    GamePhaseData mPhase;
+
+    /**
+     * @brief The state of the dice after the action, meaningful if the Fields::DICE field changed.
+     * 
+     */
+    DiceData mDice;
+
+    /**
+     * @brief The pieces moved by the action, of which only the first mNPieceChanges are meaningful: the moved piece, followed by any piece it displaced.
+     * 
+     */
+    std::array<PieceChange, 2> mPieceChanges;
+
+    /**
+     * @brief The number of pieces moved by the action.
+     * 
+     */
+    uint8_t mNPieceChanges;
+
+    /**
+     * @brief The number of counters added to (or, if negative, taken from) the common pool.
+     * 
+     */
+    int8_t mCommonPoolCountersChange;
+
+    /**
+     * @brief The number of counters added to (or, if negative, taken from) each player, indexed by PlayerID.
+     * 
+     */
+    std::array<int8_t, 2> mPlayerCountersChanges;
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A compact, versioned binary encoding of the entire state of a GameOfUrModel, meant for saving and resuming games and for passing positions between processes.
+ * 
+ * Fields are packed into single bytes, so that the encoding is the same on every platform and may be written out as is.  The state of the model's random engine is not part of the snapshot.
+ * 
+ * @see GameOfUrModel::getSnapshot()
+ * @see GameOfUrModel::restoreSnapshot()
+ */
+struct GameSnapshot {
+    /**
+     * @brief The version of the layout described by Byte, stored in the snapshot's first byte and bumped whenever the layout changes.
+     * 
+     */
+    static constexpr uint8_t kFormatVersion { 1 };
+
+    /**
+     * @brief The offset of each field within the snapshot.
+     * 
+     */
+    enum Byte: uint8_t {
+        FORMAT_VERSION, //< kFormatVersion.
+        PHASES, //< The GamePhase in bits 0-1, the TurnPhase in bits 2-3, the RoundPhase in bit 4, the current PlayerID in bit 5, and player A's RoleID in bits 6-7.
+        DICE, //< The Dice::State in bits 0-1, the primary roll less one in bits 2-3, and the secondary roll in bit 4.
+        PREVIOUS_ROLL, //< The result of the previous turn's roll.
+        POOL_COUNTERS, //< The counters held in the common pool.
+        PLAYER_COUNTERS, //< The counters held by each player, indexed by PlayerID.
+        PIECES=PLAYER_COUNTERS + 2, //< Each piece, indexed by its owner's PlayerID and then by its PieceTypeID, with its Piece::State in bits 0-1 and, when on the board, its route position in bits 2-6.
+        TOTAL=PIECES + 2 * PieceTypeID::TOTAL, //< The size of a snapshot.
+    };
+
+    /**
+     * @brief The bytes of the snapshot.
+     * 
+     */
+    std::array<uint8_t, Byte::TOTAL> mBytes;
+};
+
 /**
  * @ingroup UrGameDataModel
  * @brief The data model representing one instance of Game of Ur.
@@ -333,6 +718,8 @@ struct MoveResultData {
  * 
  * An instance of this object should be, at all times, treated as the single source of truth about the game.
  * 
+ * The possible moves, the score, each player's data and the winner are derived once per version of the state and kept until the state changes again, so that repeated queries between changes cost no more than a comparison.  As a result, even the const methods of one instance must not be called from several threads at once.
+ * 
  */
 class GameOfUrModel {
 public:
@@ -343,34 +730,58 @@ public:
     GameOfUrModel()=default;
 
     /**
-     * @brief Constructs a new game of ur model by stealing resources from another instance.
+     * @brief Constructs a new game of ur model whose dice draw on a given random engine, so that the game may be reproduced exactly.
+     * 
+     * @param randomEngine The engine from which the game's dice draw their rolls.
+     */
+    explicit GameOfUrModel(RandomEngine randomEngine): mDice { randomEngine } {}
+
+    /**
+     * @brief Constructs a new game of ur model as a copy of another.
+     * 
+     * The model holds no references or resources of its own, and so copying it is a plain copy of its bytes.
+     * 
+     * @param other The model being copied.
+     */
+    GameOfUrModel(const GameOfUrModel& other)=default;
+
+    /**
+     * @brief Constructs a new game of ur model from another instance.
      * 
-     * @param other The model being stolen from.
+     * @param other The model being moved from.
      */
     GameOfUrModel(GameOfUrModel&& other)=default;
 
     /**
-     * @brief Replaces resources owned by this model with those stolen from another instance.
+     * @brief Replaces the state of this model with a copy of another's.
      * 
-     * @param other The model being stolen from.
-     * @return GameOfUrModel& An instance to this object, after it has taken possession of other's resources.
+     * @param other The model being copied.
+     * @return GameOfUrModel& A reference to this object, after it has taken on other's state.
      */
-    inline GameOfUrModel& operator=(GameOfUrModel&& other);
+    GameOfUrModel& operator=(const GameOfUrModel& other)=default;
 
-    GameOfUrModel(const GameOfUrModel& other)=delete;
-    GameOfUrModel& operator=(const GameOfUrModel& other)=delete;
+    /**
+     * @brief Replaces the state of this model with that of another instance.
+     * 
+     * @param other The model being moved from.
+     * @return GameOfUrModel& A reference to this object, after it has taken on other's state.
+     */
+    GameOfUrModel& operator=(GameOfUrModel&& other)=default;
 
     /**
      * @brief Resets the game to its initial state, losing track of its current one.
      * 
+     * The dice carry on drawing from the same random engine.
+     * 
      */
     void reset();
 
     /**
      * @brief Starts the play phase of the game, where counters are placed into the common pile, roles are assigned to each player, and the turn for the player playing black is begun.
      * 
+     * @return StateDelta The changes made to the state of the game.
      */
-    void startPhasePlay();
+    StateDelta startPhasePlay();
 
     /**
      * @brief Rolls dice on behalf of the requester.
@@ -378,8 +789,9 @@ public:
      * @warning This method assumes that the dice roll has already been validated before it was called.  It will throw an error if rolling dice is not possible currently.
      * 
      * @param requester The player attempting to roll the dice.
+     * @return StateDelta The changes made to the state of the game.
      */
-    void rollDice(PlayerID requester);
+    StateDelta rollDice(PlayerID requester);
 
     /**
      * @brief Moves a piece from its current state or location to the one requested.
@@ -389,8 +801,54 @@ public:
      * @param piece The identity of the piece being moved.
      * @param toLocation The location (on the board or at the end of the route) the piece is to be moved to.
      * @param requester The player requesting to move the piece.
+     * @return StateDelta The changes made to the state of the game.
+     */
+    StateDelta movePiece(PieceIdentity piece, glm::u8vec2 toLocation, PlayerID requester);
+
+    /**
+     * @brief Makes a move validated earlier, without validating it or computing its results again.
+     * 
+     * @warning The token must be valid and must have been issued by this model in its current state, which is only checked by assertion.
+     * 
+     * @param moveToken The token issued when the move was validated.
+     * @return StateDelta The changes made to the state of the game.
+     */
+    StateDelta movePiece(const MoveToken& moveToken);
+
+    /**
+     * @brief Validates the launch of a piece to some location, producing a token with which the launch may be made.
+     * 
+     * @param piece The identity of the piece being launched.
+     * @param launchLocation The location the piece is to be launched to.
+     * @param requester The player requesting the launch.
+     * @return MoveToken A token for the launch, which is only valid if the launch is.
      */
-    void movePiece(PieceIdentity piece, glm::u8vec2 toLocation, PlayerID requester);
+    MoveToken validateLaunch(PieceIdentity piece, glm::u8vec2 launchLocation, PlayerID requester) const;
+
+    /**
+     * @brief Validates the move of a piece on the board by the current dice roll, producing a token with which the move may be made.
+     * 
+     * @param piece The identity of the piece being moved.
+     * @param requester The player requesting the move.
+     * @return MoveToken A token for the move, which is only valid if the move is.
+     */
+    MoveToken validateBoardMove(PieceIdentity piece, PlayerID requester) const;
+
+    /**
+     * @brief Tests whether a move token is valid and was issued by this model in its current state.
+     * 
+     * @param moveToken The token being tested.
+     * @retval true The token may be applied to this model.
+     * @retval false The token is invalid, or the state of the model has changed since it was issued.
+     */
+    bool isTokenCurrent(const MoveToken& moveToken) const;
+
+    /**
+     * @brief Gets the version of the model's state, which changes every time the state of the model does.
+     * 
+     * @return uint32_t The current version of the model's state.
+     */
+    uint32_t getStateVersion() const { return mStateVersion; }
 
     /**
      * @brief Advances the game by one turn, usually starting the turn of the next player.
@@ -398,8 +856,88 @@ public:
      * @warning This method assumes that the fact that the turn can be advanced has already been verified, and will throw an error if it can't.
      * 
      * @param requester The player requesting a move to the next turn.
+     * @return StateDelta The changes made to the state of the game.
      */
-    void advanceOneTurn(PlayerID requester);
+    StateDelta advanceOneTurn(PlayerID requester);
+
+    /**
+     * @brief Moves a piece belonging to the current player, as movePiece() does, returning a record from which the move can be undone.
+     * 
+     * @warning This method assumes the move was already validated, and will throw an error if it is invalid.
+     * 
+     * @param piece The identity of the piece being moved.
+     * @param toLocation The location (on the board or at the end of the route) the piece is to be moved to.
+     * @return UndoRecord The record of the move, to be passed to undoMove().
+     */
+    UndoRecord applyMove(PieceIdentity piece, glm::u8vec2 toLocation);
+
+    /**
+     * @brief Makes a move validated earlier, as movePiece(const MoveToken&) does, returning a record from which the move can be undone.
+     * 
+     * @warning The token must be valid and must have been issued by this model in its current state, which is only checked by assertion.
+     * 
+     * @param moveToken The token issued when the move was validated.
+     * @return UndoRecord The record of the move, to be passed to undoMove().
+     */
+    UndoRecord applyMove(const MoveToken& moveToken);
+
+    /**
+     * @brief Reverts a move made with applyMove() (or movePiece()), restoring the pieces, counters, and phases it changed.
+     * 
+     * @param undoRecord The record returned when the move was applied.
+     */
+    void undoMove(const UndoRecord& undoRecord);
+
+    /**
+     * @brief Rolls the dice for the current player, as rollDice() does, returning a record from which the roll can be undone.
+     * 
+     * @warning This method assumes that the dice roll has already been validated, and will throw an error if it is invalid.
+     * 
+     * @return UndoRecord The record of the roll, to be passed to undoDiceRoll().
+     */
+    UndoRecord applyDiceRoll();
+
+    /**
+     * @brief Lists every way the current player's next roll of the dice may turn out, along with its probability, without rolling them.
+     * 
+     * @return Dice::OutcomeList Every outcome of the next roll, or none if the dice can't be rolled presently.
+     */
+    Dice::OutcomeList getDiceRollOutcomes() const;
+
+    /**
+     * @brief Rolls the dice for the current player, as applyDiceRoll() does, but with a chosen outcome instead of a random one.
+     * 
+     * @warning This method assumes that the dice roll has already been validated, and will throw an error if it is invalid.
+     * 
+     * @param outcome One of the outcomes listed by getDiceRollOutcomes().
+     * @return UndoRecord The record of the roll, to be passed to undoDiceRoll().
+     */
+    UndoRecord applyDiceOutcome(const Dice::Outcome& outcome);
+
+    /**
+     * @brief Reverts a dice roll made with applyDiceRoll() or applyDiceOutcome(), restoring the dice and phases it changed.
+     * 
+     * The dice's random engine is not rewound, so rolling again may produce a different result.
+     * 
+     * @param undoRecord The record returned when the roll was applied.
+     */
+    void undoDiceRoll(const UndoRecord& undoRecord);
+
+    /**
+     * @brief Advances the game by one turn, as advanceOneTurn() does, returning a record from which the advance can be undone.
+     * 
+     * @warning This method assumes that the turn can be advanced, and will throw an error if it can't.
+     * 
+     * @return UndoRecord The record of the turn advance, to be passed to undoTurnAdvance().
+     */
+    UndoRecord applyTurnAdvance();
+
+    /**
+     * @brief Reverts a turn advance made with applyTurnAdvance(), restoring the dice, previous roll, and phases it changed.
+     * 
+     * @param undoRecord The record returned when the turn advance was applied.
+     */
+    void undoTurnAdvance(const UndoRecord& undoRecord);
 
     /**
      * @brief Gets the types of the pieces that this player hasn't yet launched.
@@ -414,9 +952,41 @@ public:
     /**
      * @brief Gets a list of every possible move that can be made given the game's current state.
      * 
-     * @return std::vector<std::pair<PieceIdentity, glm::u8vec2>> A list of pieces that may be moved along with the locations they may be moved to.
+     * The list is held entirely in the returned value, and so generating it never allocates.  It is read from the moves derived for the current version of the state.
+     * 
+     * @return MoveList A list of pieces that may be moved along with the locations they may be moved to.
+     * 
+     * @see getAllPossibleMoveData()
+     */
+    MoveList getAllPossibleMoves() const;
+
+    /**
+     * @brief Gets the results of every possible move that can be made given the game's current state, in the same order as getAllPossibleMoves().
+     * 
+     * Equivalent to calling getBoardMoveData() or getLaunchMoveData() for every possible move, but computed in a single pass over the current player's pieces, once per version of the state.
+     * 
+     * @return MoveResultList The results of every possible move.
+     */
+    MoveResultList getAllPossibleMoveData() const;
+
+    /**
+     * @brief Counts the moves that can be made given the game's current state.
+     * 
+     * @return uint8_t The number of moves that can be made.
+     * 
+     * @see getAllPossibleMoves()
      */
-    std::vector<std::pair<PieceIdentity, glm::u8vec2>> getAllPossibleMoves() const;
+    uint8_t countPossibleMoves() const;
+
+    /**
+     * @brief Tests whether any move at all can be made given the game's current state, stopping at the first one found.
+     * 
+     * Unlike the other queries on possible moves, this is never cached, as the model relies on it while its state is still changing.
+     * 
+     * @retval true At least one move can be made.
+     * @retval false No move can be made.
+     */
+    bool hasPossibleMoves() const;
 
     /**
      * @brief Gets a list of positions a particular piece may be launched to.
@@ -506,6 +1076,42 @@ public:
      */
     DiceData getDiceData() const;
 
+    /**
+     * @brief Gets a 64-bit hash of the entire state of the game, kept up to date as the game changes.
+     * 
+     * Two games in the same state always have the same hash, so this may be used to index transposition tables or to cheaply compare games.
+     * 
+     * @return uint64_t The hash of the game's current state.
+     */
+    uint64_t getHash() const { return mHash; }
+
+    /**
+     * @brief Gets the placement of every piece along with the current turn, which kPositionIndex maps to a dense index.
+     * 
+     * Only meaningful once roles have been assigned, i.e., outside of the initiative phase.
+     * 
+     * @return GamePosition The current position of the game.
+     */
+    GamePosition getPosition() const;
+
+    /**
+     * @brief Encodes the entire state of the game, save for its random engine, into a snapshot.
+     * 
+     * @return GameSnapshot The snapshot of the game's current state.
+     */
+    GameSnapshot getSnapshot() const;
+
+    /**
+     * @brief Replaces the state of the game with one encoded in a snapshot, keeping this game's random engine.
+     * 
+     * The snapshot is checked before anything is changed, so a snapshot of another format version, or one describing an impossible state, leaves the game as it was.  Move tokens issued before a successful restore are no longer current.
+     * 
+     * @param snapshot The snapshot to restore.
+     * @retval true The game now holds the state encoded in the snapshot.
+     * @retval false The snapshot could not be decoded, and the game is unchanged.
+     */
+    bool restoreSnapshot(const GameSnapshot& snapshot);
+
     /**
      * @brief Gets data about the results of making a move with the current dice roll with a piece present on the board.
      * 
@@ -593,6 +1199,26 @@ private:
      */
     bool canMovePiece(PieceIdentity pieceIdentity, glm::u8vec2 toLocation, PlayerID requester) const;
 
+    /**
+     * @brief The underlying implementation for getPossibleMoveData() and hasPossibleMoves().
+     * 
+     * Calls `onMove` with the identity of the piece, its destination, and the MoveResultData::Flags describing its path there (of which ENDS_GAME is never set) for every possible move, in the order of the pieces' types and then of their destinations along the route, for as long as `onMove` returns true.
+     * 
+     * @tparam TOnMove A callable taking a PieceIdentity, a glm::u8vec2, and a MoveResultData::flags, and returning whether more moves should be reported.
+     * @param onMove The callable receiving each possible move.
+     */
+    template <typename TOnMove>
+    void visitPossibleMoves(TOnMove&& onMove) const;
+
+    /**
+     * @brief Gets the results of every possible move, derived at most once per version of the state.
+     * 
+     * @return const MoveResultList& The results of every possible move, valid until the state of the model next changes.
+     * 
+     * @see getAllPossibleMoveData()
+     */
+    const MoveResultList& getPossibleMoveData() const;
+
     /**
      * @brief Gets the role of the winner of the game, and NA if there isn't one yet.
      * 
@@ -633,6 +1259,18 @@ private:
      */
     MoveResultData getMoveData(PieceIdentity piece, glm::u8vec2 moveLocation) const;
 
+    /**
+     * @brief Builds the results of a move out of facts about it and its mover that callers may share across several moves.
+     * 
+     * @param piece The piece being moved.
+     * @param moveLocation The location to which the piece is moved.
+     * @param routeFlags The flags describing the piece's path to its destination, excluding MoveResultData::ENDS_GAME.
+     * @param nFinishedPieces The number of the mover's pieces that have already completed the route.
+     * @param playerCounters The number of counters held by the mover.
+     * @return MoveResultData The results of the move.
+     */
+    MoveResultData makeMoveResult(PieceIdentity piece, glm::u8vec2 moveLocation, MoveResultData::flags routeFlags, uint8_t nFinishedPieces, uint8_t playerCounters) const;
+
     /**
      * @brief Moves some number of counters from a player into the common pile.
      * 
@@ -655,6 +1293,133 @@ private:
      */
     void endTurn();
 
+    /**
+     * @brief Updates the phases of the game to reflect the dice having just been rolled.
+     * 
+     */
+    void resolveDiceRoll();
+
+    /**
+     * @brief Creates an undo record holding the parts of the game's state common to every action.
+     * 
+     * @param action The action about to be applied.
+     * @return UndoRecord The partially filled undo record.
+     */
+    UndoRecord beginUndoRecord(UndoRecord::Action action) const;
+
+    /**
+     * @brief Restores the parts of the game's state common to every action from an undo record.
+     * 
+     * @param undoRecord The record to restore the game's state from.
+     */
+    void restoreFromUndoRecord(const UndoRecord& undoRecord);
+
+    /**
+     * @brief Creates a state delta holding the parts of the game's state that any action may change, as they are before the action.
+     * 
+     * The counter changes hold the counters of the common pool and of each player until the delta is completed.
+     * 
+     * @return StateDelta The state delta, to be completed by completeStateDelta() once the action has been applied.
+     */
+    StateDelta beginStateDelta() const;
+
+    /**
+     * @brief Compares a state delta made by beginStateDelta() with the game's current state, recording which fields have changed and what they have changed to.
+     * 
+     * @param stateDelta The state delta being completed.
+     */
+    void completeStateDelta(StateDelta& stateDelta) const;
+
+    /**
+     * @brief Adds the pieces moved by a move to a state delta, from the undo record made when the move was applied.
+     * 
+     * @param stateDelta The state delta of the move.
+     * @param undoRecord The undo record of the move.
+     */
+    void addPieceChanges(StateDelta& stateDelta, const UndoRecord& undoRecord) const;
+
+    /**
+     * @brief Computes the hash of the entire state of the game from scratch.
+     * 
+     * @return uint64_t The hash of the game's current state.
+     */
+    uint64_t computeHash() const;
+
+    /**
+     * @brief Computes the part of the game's hash contributed by its phases, dice, current player, previous roll, and role assignments.
+     * 
+     * These change together on almost every action, and so are rehashed as a group.
+     * 
+     * @return uint64_t The part of the game's hash contributed by its turn state.
+     */
+    uint64_t hashTurnState() const;
+
+    /**
+     * @brief Computes the part of the game's hash contributed by the common pool's and a player's counters.
+     * 
+     * @param player The player whose counters are included.
+     * @return uint64_t The part of the game's hash contributed by these counters.
+     */
+    uint64_t hashCounters(PlayerID player) const;
+
+    /**
+     * @brief Computes the part of the game's hash contributed by a single piece.
+     * 
+     * @param player The player owning the piece.
+     * @param piece The piece being hashed.
+     * @return uint64_t The part of the game's hash contributed by this piece.
+     */
+    uint64_t hashPiece(PlayerID player, const Piece& piece) const;
+
+    /**
+     * @brief Makes a move for the current player whose results are already known, returning a record from which the move can be undone.
+     * 
+     * @param moveResults The results of the move, as computed by getMoveData().
+     * @return UndoRecord The record of the move.
+     */
+    UndoRecord applyMoveResult(const MoveResultData& moveResults);
+
+    /**
+     * @brief The result of a query on the state of the model, along with the version of the state it was derived from.
+     * 
+     * @tparam TValue The type of the result.
+     */
+    template <typename TValue>
+    struct DerivedQuery {
+        /**
+         * @brief The version of the model's state the value was derived from.
+         * 
+         * Starts out at a version the model's state is never expected to reach, so that the value is derived the first time it is asked for.
+         */
+        uint32_t mStateVersion { UINT32_MAX };
+
+        /**
+         * @brief The derived value.
+         * 
+         */
+        TValue mValue {};
+    };
+
+    /**
+     * @brief Gets the result of a query, deriving it again only if the state of the model has changed since it was last derived.
+     * 
+     * Queries made while the state of the model is being changed must not go through here, as their results would be kept for a version of the state that is not yet final.
+     * 
+     * @tparam TValue The type of the result.
+     * @tparam TDerive A callable taking no arguments and returning a TValue.
+     * @param query The cached result of the query.
+     * @param derive The callable deriving the result from the current state.
+     * @return const TValue& The result of the query for the current state.
+     */
+    template <typename TValue, typename TDerive>
+    const TValue& getDerived(DerivedQuery<TValue>& query, TDerive&& derive) const {
+        if(query.mStateVersion != mStateVersion) {
+            query.mValue = derive();
+            query.mStateVersion = mStateVersion;
+        }
+        return query.mValue;
+    }
+
     /**
      * @brief The current phase of the game as a whole.
      * 
@@ -686,10 +1451,10 @@ private:
     uint8_t mCounters { 0 };
 
     /**
-     * @brief A reference to the data model of the dice used in this game.
+     * @brief The data model of the dice used in this game.
      * 
      */
-    std::unique_ptr<Dice> mDice { std::make_unique<Dice>() };
+    Dice mDice {};
 
     /**
      * @brief The data model for the board used by this game.
@@ -708,7 +1473,46 @@ private:
      * 
      */
     uint8_t mPreviousRoll {0};
+
+    /**
+     * @brief A number incremented on every change to the state of this game, with which move tokens issued by it are checked.
+     * 
+     */
+    uint32_t mStateVersion { 0 };
+
+    /**
+     * @brief The moves possible in the current state, with their results, as last derived.
+     * 
+     */
+    mutable DerivedQuery<MoveResultList> mPossibleMoveData {};
+
+    /**
+     * @brief The score of the game, as last derived.
+     * 
+     */
+    mutable DerivedQuery<GameScoreData> mScore {};
+
+    /**
+     * @brief The data of each player, indexed by PlayerID, as last derived.
+     * 
+     */
+    mutable std::array<DerivedQuery<PlayerData>, 2> mPlayerData {};
+
+    /**
+     * @brief The winner of the game, as last derived.
+     * 
+     */
+    mutable DerivedQuery<RoleID> mWinner {};
+
+    /**
+     * @brief The hash of the entire state of this game, updated alongside it.
+     * 
+     * @warning Must be declared after every other member, as its initial value is computed from theirs.
+     * 
+     */
+    uint64_t mHash { computeHash() };
 };
 
-inline GameOfUrModel& GameOfUrModel::operator=(GameOfUrModel&& other)=default;
+static_assert(std::is_trivially_copyable_v<GameOfUrModel>, "GameOfUrModel must remain copyable with a plain memcpy");
+
 #endif
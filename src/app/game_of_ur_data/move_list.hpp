@@ -0,0 +1,116 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/move_list.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a fixed-capacity list of moves, used to report legal moves without allocating.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPMOVELIST_H
+#define ZOAPPMOVELIST_H
+
+#include <cstdint>
+#include <cassert>
+#include <array>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include "piece.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A list of moves, each a piece paired with the location it may be moved to, whose storage lives wherever the list itself does.
+ * 
+ * Its capacity is the largest number of moves available on any single turn.  A roll of 2 is the only one with which a swallow may be launched, and it may be launched to one of 4 houses.  Each of the other 4 pieces can make at most one move with any roll.
+ * 
+ */
+class MoveList {
+public:
+    /**
+     * @brief The type of a single move held in this list.
+     * 
+     */
+    using value_type = std::pair<PieceIdentity, glm::u8vec2>;
+
+    /**
+     * @brief The maximum number of moves this list can hold.
+     * 
+     */
+    static constexpr uint8_t kCapacity { 8 };
+
+    /**
+     * @brief Adds a move to the end of this list.
+     * 
+     * @param piece The piece being moved.
+     * @param toLocation The location the piece is moved to.
+     */
+    void push_back(PieceIdentity piece, glm::u8vec2 toLocation) {
+        assert(mSize < kCapacity && "A move list cannot hold more moves than are possible in a single turn");
+        mMoves[mSize++] = { piece, toLocation };
+    }
+
+    /**
+     * @brief Removes every move from this list.
+     * 
+     */
+    void clear() { mSize = 0; }
+
+    /**
+     * @brief Gets the number of moves in this list.
+     * 
+     * @return std::size_t The number of moves in this list.
+     */
+    std::size_t size() const { return mSize; }
+
+    /**
+     * @brief Tests whether this list holds no moves.
+     * 
+     * @retval true There are no moves in this list.
+     * @retval false There is at least one move in this list.
+     */
+    bool empty() const { return mSize == 0; }
+
+    /**
+     * @brief Gets a move in this list.
+     * 
+     * @param index The position of the move in this list.
+     * @return const value_type& The move at that position.
+     */
+    const value_type& operator[](std::size_t index) const {
+        assert(index < mSize && "Move index out of range");
+        return mMoves[index];
+    }
+
+    /**
+     * @brief Gets an iterator to the first move in this list.
+     * 
+     * @return const value_type* The first move in this list.
+     */
+    const value_type* begin() const { return mMoves.data(); }
+
+    /**
+     * @brief Gets an iterator to one past the last move in this list.
+     * 
+     * @return const value_type* One past the last move in this list.
+     */
+    const value_type* end() const { return mMoves.data() + mSize; }
+
+private:
+    /**
+     * @brief Storage for the moves in this list, of which only the first mSize are meaningful.
+     * 
+     */
+    std::array<value_type, kCapacity> mMoves {};
+
+    /**
+     * @brief The number of moves in this list.
+     * 
+     */
+    uint8_t mSize { 0 };
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include <cassert>
+#include <chrono>
+#include <utility>
+
+#include "perft.hpp"
+
+PerftResult Perft::run(const GameOfUrModel& position, uint8_t depth) {
+    PerftResult result {};
+    GameOfUrModel model { position };
+
+    const auto start { std::chrono::steady_clock::now() };
+    if(depth == 0) {
+        result.mNodes = 1;
+        result.mNodesVisited = 1;
+    } else {
+        expand(model, depth, result);
+    }
+    result.mSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+GameOfUrModel Perft::makeStartPosition(StartPosition startPosition) {
+    GameOfUrModel model {};
+    if(startPosition == StartPosition::GAME_START) return model;
+    assert(startPosition == StartPosition::PLAY_START && "There is no such standard position");
+
+    // player A outrolls player B for initiative, 10 to 1, and so plays black
+    for(const auto& [primaryRoll, secondaryRoll]: { std::pair { 4, true }, std::pair { 1, false } }) {
+        model.applyDiceOutcome(model.getDiceRollOutcomes()[primaryRoll - 1]);
+        model.applyDiceOutcome(model.getDiceRollOutcomes()[secondaryRoll]);
+        if(model.canAdvanceOneTurn(model.getCurrentPhase().mTurn)) model.applyTurnAdvance();
+    }
+    model.startPhasePlay();
+    return model;
+}
+
+bool Perft::matchesReference(StartPosition startPosition, uint8_t depth) {
+    assert(depth <= kMaxReferenceDepth && "No reference count is known this deep");
+    return run(makeStartPosition(startPosition), depth).mNodes == kReferenceCounts[startPosition][depth];
+}
+
+void Perft::expand(GameOfUrModel& model, uint8_t depth, PerftResult& result) {
+    ++result.mNodesVisited;
+    if(depth == 1) {
+        countLeaves(model, result);
+        return;
+    }
+
+    const PlayerID player { model.getCurrentPhase().mTurn };
+    if(model.canRollDice(player)) {
+        for(const Dice::Outcome& outcome: model.getDiceRollOutcomes()) {
+            const UndoRecord undoRecord { model.applyDiceOutcome(outcome) };
+            expand(model, depth - 1, result);
+            model.undoDiceRoll(undoRecord);
+        }
+    }
+
+    for(const auto& [piece, toLocation]: model.getAllPossibleMoves()) {
+        const UndoRecord undoRecord { model.applyMove(piece, toLocation) };
+        expand(model, depth - 1, result);
+        model.undoMove(undoRecord);
+    }
+
+    if(model.canAdvanceOneTurn(player)) {
+        const UndoRecord undoRecord { model.applyTurnAdvance() };
+        expand(model, depth - 1, result);
+        model.undoTurnAdvance(undoRecord);
+
+    } else if(model.canStartPhasePlay()) {
+        // starting the play phase can't be undone, and happens once a game,
+        // so it is expanded on a copy instead
+        GameOfUrModel playStart { model };
+        playStart.startPhasePlay();
+        expand(playStart, depth - 1, result);
+    }
+}
+
+void Perft::countLeaves(const GameOfUrModel& model, PerftResult& result) {
+    uint64_t nLeaves { 0 };
+    const PlayerID player { model.getCurrentPhase().mTurn };
+    if(model.canRollDice(player)) {
+        const std::size_t nOutcomes { model.getDiceRollOutcomes().size() };
+        nLeaves += nOutcomes;
+        result.mDiceOutcomes += nOutcomes;
+    }
+
+    for(const MoveResultData& moveResult: model.getAllPossibleMoveData()) {
+        ++nLeaves;
+        if(model.getPieceData(moveResult.mMovedPiece.mIdentity).mState == Piece::State::UNLAUNCHED) {
+            ++result.mLaunches;
+        } else {
+            ++result.mBoardMoves;
+        }
+        if(moveResult.mDisplacedPiece.mIdentity.mOwner != RoleID::NA) ++result.mCaptures;
+        if(moveResult.mFlags & MoveResultData::ENDS_GAME) ++result.mGameEnds;
+    }
+
+    if(model.canAdvanceOneTurn(player) || model.canStartPhasePlay()) {
+        ++nLeaves;
+        ++result.mTurnEnds;
+    }
+
+    result.mNodes += nLeaves;
+    result.mNodesVisited += nLeaves;
+}
@@ -0,0 +1,176 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/perft.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains a game tree enumerator which counts the states reachable from a game within some number of actions, to validate and time the model's move generation.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPPERFT_H
+#define ZOAPPPERFT_H
+
+#include <cstdint>
+#include <array>
+
+#include "model.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The counts gathered by a single run of Perft, along with how long it took.
+ * 
+ */
+struct PerftResult {
+    /**
+     * @brief The number of states reached at the requested depth, i.e., the number of distinct sequences of that many actions.
+     * 
+     */
+    uint64_t mNodes;
+
+    /**
+     * @brief The number of leaves reached by a dice outcome.
+     * 
+     */
+    uint64_t mDiceOutcomes;
+
+    /**
+     * @brief The number of leaves reached by launching a piece.
+     * 
+     */
+    uint64_t mLaunches;
+
+    /**
+     * @brief The number of leaves reached by moving a piece already on the board.
+     * 
+     */
+    uint64_t mBoardMoves;
+
+    /**
+     * @brief The number of leaves reached by a move displacing an opponent's piece.
+     * 
+     */
+    uint64_t mCaptures;
+
+    /**
+     * @brief The number of leaves reached by a move ending the game.
+     * 
+     */
+    uint64_t mGameEnds;
+
+    /**
+     * @brief The number of leaves reached by ending a turn, or by starting the play phase.
+     * 
+     */
+    uint64_t mTurnEnds;
+
+    /**
+     * @brief The number of states visited on the way, counting both the leaves and every state above them.
+     * 
+     */
+    uint64_t mNodesVisited;
+
+    /**
+     * @brief The time taken by the run, in seconds.
+     * 
+     */
+    double mSeconds;
+
+    /**
+     * @brief Gets the rate at which states were visited.
+     * 
+     * @return double The number of states visited per second.
+     */
+    double getNodesPerSecond() const { return mSeconds > 0.0? mNodesVisited / mSeconds: 0.0; }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief Counts every state reachable from a game within some number of actions, in the manner of the perft counts used to validate chess move generators.
+ * 
+ * Each action is a single edge of the tree: one outcome of a roll of the dice (four for the primary die, two for the secondary die), one launch or board move, or the end of a turn, which at the end of the initiative phase starts the play phase instead.  Rolling the secondary die in place of moving is one more choice of the player, so a roll's outcomes are expanded alongside the moves available.  A game that has ended has no children, and so contributes nothing to counts deeper than itself.
+ * 
+ * The counts from each StartPosition are fixed by the rules alone, and so any change to Board, Dice, or the move generation of GameOfUrModel that leaves the rules be should reproduce matchesReference().
+ * 
+ */
+class Perft {
+public:
+    /**
+     * @brief The standard positions counts are published for.
+     * 
+     */
+    enum StartPosition: uint8_t {
+        GAME_START, //< A new game, with player A about to roll for initiative.
+        PLAY_START, //< The start of the play phase, with black (player A) about to roll.
+        TOTAL, //< The number of standard positions.
+    };
+
+    /**
+     * @brief The greatest depth for which reference counts are known.
+     * 
+     */
+    static constexpr uint8_t kMaxReferenceDepth { 20 };
+
+    /**
+     * @brief The number of leaves at every depth from 0 to kMaxReferenceDepth, for each StartPosition.
+     * 
+     */
+    static constexpr std::array<std::array<uint64_t, kMaxReferenceDepth + 1>, StartPosition::TOTAL> kReferenceCounts {{
+        {{
+            1, 4, 8, 8, 32, 64, 64, 256, 736, 736, 2272, 6784, 8576, 20864, 63344,
+            104560, 217256, 631912, 1234920, 2384568, 6330024,
+        }},
+        {{
+            1, 4, 12, 12, 36, 112, 144, 336, 1026, 1762, 3555, 10315, 20827, 39601, 103987,
+            242527, 477355, 1145690, 2804289, 5783427, 12897619,
+        }},
+    }};
+
+    /**
+     * @brief Counts the states reachable from a game within some number of actions.
+     * 
+     * @param position The game counted from, which is left unchanged.
+     * @param depth The number of actions taken to reach each counted state.
+     * @return PerftResult The counts, along with how long they took to gather.
+     */
+    static PerftResult run(const GameOfUrModel& position, uint8_t depth);
+
+    /**
+     * @brief Creates one of the standard positions.
+     * 
+     * @param startPosition The position created.
+     * @return GameOfUrModel A game in that position.
+     */
+    static GameOfUrModel makeStartPosition(StartPosition startPosition);
+
+    /**
+     * @brief Tests whether the counts from a standard position agree with kReferenceCounts at a depth.
+     * 
+     * @param startPosition The position counted from.
+     * @param depth The depth counted to, at most kMaxReferenceDepth.
+     * @retval true The number of leaves matches the reference count.
+     * @retval false The number of leaves differs from the reference count, and so the rules are no longer being followed.
+     */
+    static bool matchesReference(StartPosition startPosition, uint8_t depth);
+
+private:
+    /**
+     * @brief Adds the counts of the subtree below a state to a result, restoring the state before returning.
+     * 
+     * @param model The game at the root of the subtree.
+     * @param depth The number of actions remaining until a leaf, at least 1.
+     * @param result The result counts are added to.
+     */
+    static void expand(GameOfUrModel& model, uint8_t depth, PerftResult& result);
+
+    /**
+     * @brief Adds the children of a state, each a leaf, to a result without visiting them.
+     * 
+     * @param model The game whose children are counted.
+     * @param result The result counts are added to.
+     */
+    static void countLeaves(const GameOfUrModel& model, PerftResult& result);
+};
+
+#endif
@@ -12,12 +12,14 @@
 #ifndef ZOAPPGAMEPHASE_H
 #define ZOAPPGAMEPHASE_H
 
+#include <cstdint>
+
 /**
  * @ingroup UrGameDataModel
  * @brief A value representing the high level phase of an entire game.
  * 
  */
-enum class GamePhase {
+enum class GamePhase: uint8_t {
     INITIATIVE, //< A phase in which both players roll both dice to determine role-assignments and turn order.
     PLAY, //< The phase where the bulk of the game takes place, where pieces are move and counters are exchanged.
     END, //< The end of the game, reached when one player succeeds in moving all their pieces to the end of the route.
@@ -28,7 +30,7 @@ enum class GamePhase {
  * @brief A value representing the phases possible in a single turn of the game.
  * 
  */
-enum class TurnPhase {
+enum class TurnPhase: uint8_t {
     ROLL_DICE, //< The player must roll the dice now.
     MOVE_PIECE, //< The player may move a piece if possible, or roll the dice again.
     END, //< No moves are possible, and the turn should go to the next player.
@@ -40,7 +42,7 @@ enum class TurnPhase {
  * 
  * In Game of Ur, a round ends every pair of turns.
  */
-enum class RoundPhase {
+enum class RoundPhase: uint8_t {
     IN_PROGRESS, //< The round is in progress.
     END, //< Both players have taken a turn, and the round has ended.
 };
@@ -1,4 +1,4 @@
-#include "piece_type.hpp"
+#include "ruleset.hpp"
 #include "piece.hpp"
 
 bool Piece::canMove(uint8_t roll, RoleID player) const {
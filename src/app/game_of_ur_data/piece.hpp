@@ -61,6 +61,12 @@ public:
         FINISHED, //< This piece has completed its route.
     };
 
+    /**
+     * @brief Constructs a placeholder Piece without an owner, to be replaced once roles are assigned.
+     * 
+     */
+    Piece()=default;
+
     /**
      * @brief Constructs a new Piece.
      * 
@@ -143,7 +149,7 @@ private:
      * @brief The unique identity of this piece.
      * 
      */
-    PieceIdentity mIdentity;
+    PieceIdentity mIdentity { .mType { PieceTypeID::SWALLOW }, .mOwner { RoleID::NA } };
 
     /**
      * @brief This piece's current location with respect to the game board.
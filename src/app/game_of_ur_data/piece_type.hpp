@@ -12,9 +12,8 @@
 #ifndef ZOAPPGAMEPIECETYPE_H
 #define ZOAPPGAMEPIECETYPE_H
 
-#include <string>
+#include <string_view>
 #include <cstdint>
-#include <array>
 
 #include "piece_type_id.hpp"
 
@@ -37,7 +36,7 @@ struct PieceType {
      * @brief The name of this type of piece, for display.
      * 
      */
-    std::string mName;
+    std::string_view mName;
 
     /**
      * @brief The roll required in order to launch this type of piece.
@@ -58,17 +57,4 @@ struct PieceType {
     uint8_t mCost;
 };
 
-/**
- * @ingroup UrGameDataModel
- * @brief An array of PieceTypes, each element describing a single type of piece used in the game.
- * 
- */
-inline const std::array<const PieceType, 5> kGamePieceTypes {{
-    {.mName="swallow", .mLaunchRoll=2, .mLaunchType=PieceType::LaunchType::ONE_BEFORE_ROSETTE, .mCost=3},
-    {.mName="storm-bird", .mLaunchRoll=5,  .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=4},
-    {.mName="raven", .mLaunchRoll=6, .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=4},
-    {.mName="rooster", .mLaunchRoll=7, .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=4},
-    {.mName="eagle", .mLaunchRoll=10, .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=5},
-}};
-
 #endif
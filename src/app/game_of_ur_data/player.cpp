@@ -12,15 +12,16 @@ uint8_t Player::deductCounters(uint8_t counters) {
     return counters;
 }
 
-std::weak_ptr<Piece> Player::getPiece(PieceTypeID pieceType) {
+Piece& Player::getPiece(PieceTypeID pieceType) {
     assert(pieceType <= PieceTypeID::TOTAL && "pieceType must be a valid member of the enum PieceTypeID");
+    assert(mRole != RoleID::NA && "This player has not been assigned a role");
     return mPieces[pieceType];
 }
 
 const Piece& Player::cGetPiece(PieceTypeID pieceType) const {
     assert(pieceType <= PieceTypeID::TOTAL && "pieceType must be a valid member of the enum PieceTypeID");
     assert(mRole != RoleID::NA && "This player has not been assigned a role");
-    return *mPieces[pieceType];
+    return mPieces[pieceType];
 }
 
 void Player::initializeWithRole(RoleID role) {
@@ -29,7 +30,7 @@ void Player::initializeWithRole(RoleID role) {
         case RoleID::BLACK:
         case RoleID::WHITE:
             for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
-                mPieces[type] = std::make_shared<Piece>(static_cast<PieceTypeID>(type), mRole);
+                mPieces[type] = Piece{ static_cast<PieceTypeID>(type), mRole };
             }
             break;
 
@@ -42,7 +43,7 @@ uint8_t Player::getNPieces(Piece::State inState) const {
     if(mRole == RoleID::NA) { return 0; }
     uint8_t count { 0 };
     for(uint8_t i{0}; i < mPieces.size(); ++i) {
-        if(mPieces[i]->getState() == inState) {
+        if(mPieces[i].getState() == inState) {
             ++count;
         }
     }
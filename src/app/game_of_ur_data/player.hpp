@@ -12,13 +12,13 @@
 #ifndef ZOAPPPLAYER_H
 #define ZOAPPPLAYER_H
 
-#include <memory>
 #include <array>
 
 #include <glm/glm.hpp>
 
 #include "piece.hpp"
 #include "role_id.hpp"
+#include "ruleset.hpp"
 
 /**
  * @ingroup UrGameDataModel
@@ -75,11 +75,9 @@ public:
      * @brief Gets a reference to the data model of some piece owned by this player.
      * 
      * @param pieceType The type of piece whose reference we want.
-     * @return std::weak_ptr<Piece> The reference to the requested piece.
-     * 
-     * @todo Why did I make this a pointer in the first place?  I forget.
+     * @return Piece& The reference to the requested piece.
      */
-    std::weak_ptr<Piece> getPiece(PieceTypeID pieceType);
+    Piece& getPiece(PieceTypeID pieceType);
 
     /**
      * @brief Gets (a const reference to) a piece owned by this player corresponding to a requested type.
@@ -97,18 +95,18 @@ private:
     RoleID mRole { NA };
 
     /**
-     * @brief References to the data models of all the pieces owned by this player.
+     * @brief The data models of all the pieces owned by this player, indexed by PieceTypeID.
      * 
-     * @todo Once again, why did these need to be pointers?
+     * Pieces are held by value so that a Player (and the GameOfUrModel containing it) may be copied trivially.
      * 
      */
-    std::array<std::shared_ptr<Piece>, 5> mPieces { nullptr };
+    std::array<Piece, 5> mPieces {};
 
     /**
      * @brief The number of counters currently held by this player.
      * 
      */
-    uint8_t mCounters { 25 };
+    uint8_t mCounters { kUrRuleset.mStartingCounters };
 };
 
 #endif
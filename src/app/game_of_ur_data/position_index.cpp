@@ -0,0 +1,229 @@
+#include <cassert>
+
+#include "position_index.hpp"
+#include "route.hpp"
+
+uint8_t PositionIndex::getFreeHouse(uint8_t rank, uint16_t takenHouses) const {
+    // select the free house of some rank from whichever chunk of houses holds it
+    static_assert(kBattlefieldLength <= 2 * kChunkLength && kRegionLength <= kChunkLength, "Every board region must be covered by two chunks of houses");
+    const uint16_t freeHouses { static_cast<uint16_t>(~takenHouses & ((1u << (2 * kChunkLength)) - 1u)) };
+    const uint8_t nLowHouses { mChunkCounts[freeHouses & ((1u << kChunkLength) - 1u)] };
+    const bool isHigh { rank >= nLowHouses };
+    const uint8_t chunk { static_cast<uint8_t>((freeHouses >> (isHigh * kChunkLength)) & ((1u << kChunkLength) - 1u)) };
+    return static_cast<uint8_t>(isHigh * kChunkLength + mChunkSelects[chunk][(rank - isHigh * nLowHouses) & 0x7u]);
+}
+
+uint64_t PositionIndex::divide(uint64_t& dividend, uint64_t divisor, double reciprocal) {
+    // the quotient estimated in floating point is off by at most one for the
+    // dividends an index holds, well within a double's precision
+    static_assert(kPositionIndex.getSize() < (uint64_t { 1 } << 52), "Indices must be exactly representable as doubles");
+    int64_t quotient { static_cast<int64_t>(static_cast<double>(dividend) * reciprocal) };
+    int64_t remainder { static_cast<int64_t>(dividend) - quotient * static_cast<int64_t>(divisor) };
+    quotient -= (remainder < 0);
+    remainder += (remainder < 0)? divisor: 0;
+    quotient += (remainder >= static_cast<int64_t>(divisor));
+    remainder -= (remainder >= static_cast<int64_t>(divisor))? divisor: 0;
+    dividend = static_cast<uint64_t>(remainder);
+    return static_cast<uint64_t>(quotient);
+}
+
+uint16_t PositionIndex::findGroup(const std::array<uint64_t, kNClassAssignments + 1>& offsets, const Guide& guide, uint8_t guideShift, uint64_t index) {
+    uint16_t group { guide[index >> guideShift] };
+    while(offsets[group + 1] <= index) ++group;
+    return group;
+}
+
+bool PositionIndex::isValid(const GamePosition& position) const {
+    if(position.mTurn != RoleID::BLACK && position.mTurn != RoleID::WHITE) return false;
+    if(static_cast<uint8_t>(position.mTurnPhase) > static_cast<uint8_t>(TurnPhase::END)) return false;
+
+    uint16_t battlefieldHouses { 0 };
+    for(const auto& pieces: position.mPieces) {
+        uint16_t regionHouses { 0 };
+        for(const GamePosition::PiecePlacement& piece: pieces) {
+            if(piece.mState != Piece::State::ON_BOARD) continue;
+            if(piece.mRoutePosition >= RouteTable::kRouteEnd) return false;
+
+            uint16_t& takenHouses { piece.mRoutePosition < kRegionLength? regionHouses: battlefieldHouses };
+            const uint16_t house { static_cast<uint16_t>(1u << (piece.mRoutePosition < kRegionLength? piece.mRoutePosition: piece.mRoutePosition - kRegionLength)) };
+            if(takenHouses & house) return false;
+            takenHouses |= house;
+        }
+    }
+    return true;
+}
+
+uint64_t PositionIndex::rank(const GamePosition& position) const {
+    assert(isValid(position) && "Only valid positions have an index");
+
+    // gather the houses of each role's region pieces, and of the battlefield
+    // pieces of both, in piece order.  Every piece's house is written to both
+    // lists, but only counted by the list its class calls for, so that no
+    // branch depends on where pieces are
+    static_assert(UNLAUNCHED == 0, "Pieces of no other class must contribute nothing to a class assignment");
+    std::array<uint16_t, 2> assignments {};
+    std::array<std::array<uint8_t, PieceTypeID::TOTAL + 1>, 2> regionHouses {};
+    std::array<uint8_t, 2> nRegionPieces {};
+    std::array<uint8_t, 2 * PieceTypeID::TOTAL + 1> battlefieldHouses {};
+    uint8_t nBattlefieldPieces { 0 };
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        uint16_t assignment { 0 };
+        uint8_t nRolePieces { 0 };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const GamePosition::PiecePlacement& piece { position.mPieces[role][type] };
+            const bool isOnBoard { piece.mState == Piece::State::ON_BOARD };
+            const bool isRegion { static_cast<bool>(isOnBoard & (piece.mRoutePosition < kRegionLength)) };
+            const bool isBattlefield { static_cast<bool>(isOnBoard & (piece.mRoutePosition >= kRegionLength)) };
+            regionHouses[role][nRolePieces] = piece.mRoutePosition;
+            nRolePieces += isRegion;
+            battlefieldHouses[nBattlefieldPieces] = static_cast<uint8_t>(piece.mRoutePosition - kRegionLength);
+            nBattlefieldPieces += isBattlefield;
+
+            const uint16_t placementClass {
+                static_cast<uint16_t>((piece.mState == Piece::State::FINISHED) * FINISHED + isRegion * REGION + isBattlefield * BATTLEFIELD)
+            };
+            assignment |= placementClass << (2 * type);
+        }
+        assignments[role] = assignment;
+        nRegionPieces[role] = nRolePieces;
+    }
+
+    // rank each list as a partial permutation.  A piece's digit is its house
+    // less the number of houses taken below it, and those numbers are kept a
+    // nibble per house, so that taking a house adds one to every nibble above
+    // it at once
+    static_assert(kBattlefieldLength <= 16 && 2 * PieceTypeID::TOTAL < 16, "Counts of houses taken must fit a nibble per house");
+    const auto rankPlacement = [](const uint8_t* houses, uint8_t nPieces, uint8_t nHouses) {
+        constexpr uint64_t kHouseNibbles { 0x1111'1111'1111'1111ull };
+        uint64_t placementRank { 0 };
+        uint64_t takenBelow { 0 };
+        for(uint8_t piece { 0 }; piece < nPieces; ++piece) {
+            const uint8_t house { houses[piece] };
+            placementRank = placementRank * (nHouses - piece) + house - ((takenBelow >> (4 * house)) & 0xFu);
+            takenBelow += kHouseNibbles << (4 * (house + 1));
+        }
+        return placementRank;
+    };
+    const std::array<uint64_t, 2> regionRanks {
+        rankPlacement(regionHouses[0].data(), nRegionPieces[0], kRegionLength),
+        rankPlacement(regionHouses[1].data(), nRegionPieces[1], kRegionLength),
+    };
+    const uint64_t battlefieldRank { rankPlacement(battlefieldHouses.data(), nBattlefieldPieces, kBattlefieldLength) };
+    const uint16_t black { assignments[0] };
+    const uint16_t white { assignments[1] };
+    const uint64_t blackRegionRank { regionRanks[0] };
+    const uint64_t whiteRegionRank { regionRanks[1] };
+
+    // black's region placement sits between the two roles' class assignments,
+    // as the number of white placements depends on black's
+    const std::array<uint64_t, kNClassAssignments + 1>& whiteOffsets { mWhiteOffsets[mBattlefieldCounts[black]] };
+    const uint64_t pieceRank {
+        mBlackOffsets[black]
+        + blackRegionRank * whiteOffsets[kNClassAssignments]
+        + whiteOffsets[white]
+        + whiteRegionRank * mBattlefieldPlacementCounts[nBattlefieldPieces]
+        + battlefieldRank
+    };
+    const uint8_t turnRank { static_cast<uint8_t>((position.mTurn == RoleID::WHITE) * 3 + static_cast<uint8_t>(position.mTurnPhase)) };
+    return pieceRank * kNTurnStates + turnRank;
+}
+
+GamePosition PositionIndex::unrank(uint64_t index) const {
+    assert(index < mSize && "Index must lie within the index space");
+    GamePosition position {};
+
+    const uint8_t turnRank { static_cast<uint8_t>(index % kNTurnStates) };
+    position.mTurn = turnRank / 3? RoleID::WHITE: RoleID::BLACK;
+    position.mTurnPhase = static_cast<TurnPhase>(turnRank % 3);
+    index /= kNTurnStates;
+
+    const uint16_t black { findGroup(mBlackOffsets, mBlackGuide, mBlackGuideShift, index) };
+    index -= mBlackOffsets[black];
+    const uint8_t nBlackBattlefieldPieces { mBattlefieldCounts[black] };
+    const std::array<uint64_t, kNClassAssignments + 1>& whiteOffsets { mWhiteOffsets[nBlackBattlefieldPieces] };
+    std::array<uint32_t, 2> regionRanks {};
+    regionRanks[0] = static_cast<uint32_t>(divide(index, whiteOffsets[kNClassAssignments], mWhiteTotalReciprocals[nBlackBattlefieldPieces]));
+    const uint16_t white { findGroup(whiteOffsets, mWhiteGuides[nBlackBattlefieldPieces], mWhiteGuideShifts[nBlackBattlefieldPieces], index) };
+    index -= whiteOffsets[white];
+
+    const uint8_t nBattlefieldPieces { static_cast<uint8_t>(nBlackBattlefieldPieces + mBattlefieldCounts[white]) };
+    regionRanks[1] = static_cast<uint32_t>(divide(index, mBattlefieldPlacementCounts[nBattlefieldPieces], mBattlefieldPlacementReciprocals[nBattlefieldPieces]));
+    uint32_t battlefieldRank { static_cast<uint32_t>(index) };
+
+    // peel off the digits of each partial permutation, last piece first,
+    // dividing by each radix with a multiply and a shift.  Digit arrays hold
+    // one spare digit for the pieces placed after the last of their kind
+    static_assert(
+        countPlacements(kBattlefieldLength, 2 * PieceTypeID::TOTAL) * kBattlefieldLength <= (uint64_t { 1 } << kRadixShift),
+        "Multiplying by a radix's reciprocal must divide any placement rank exactly"
+    );
+    std::array<uint8_t, 2 * PieceTypeID::TOTAL + 1> battlefieldDigits {};
+    for(uint8_t piece { nBattlefieldPieces }; piece-- > 0;) {
+        const uint8_t radix { static_cast<uint8_t>(kBattlefieldLength - piece) };
+        const uint32_t quotient { static_cast<uint32_t>((battlefieldRank * mRadixMultipliers[radix]) >> kRadixShift) };
+        battlefieldDigits[piece] = static_cast<uint8_t>(battlefieldRank - quotient * radix);
+        battlefieldRank = quotient;
+    }
+    std::array<std::array<uint8_t, PieceTypeID::TOTAL + 1>, 2> regionDigits {};
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        for(uint8_t piece { mRegionCounts[role == 0? black: white] }; piece-- > 0;) {
+            const uint8_t radix { static_cast<uint8_t>(kRegionLength - piece) };
+            const uint32_t quotient { static_cast<uint32_t>((regionRanks[role] * mRadixMultipliers[radix]) >> kRadixShift) };
+            regionDigits[role][piece] = static_cast<uint8_t>(regionRanks[role] - quotient * radix);
+            regionRanks[role] = quotient;
+        }
+    }
+
+    // turn each list of digits back into houses in piece order, then hand the
+    // houses out to the pieces whose classes call for them, as rank() gathers
+    // them, so that no branch depends on where pieces are
+    const auto unrankPlacement = [this](const uint8_t* digits, uint8_t nPieces, uint8_t* houses) {
+        uint16_t takenHouses { 0 };
+        for(uint8_t piece { 0 }; piece < nPieces; ++piece) {
+            const uint8_t house { getFreeHouse(digits[piece], takenHouses) };
+            takenHouses |= (1u << house);
+            houses[piece] = house;
+        }
+    };
+    std::array<std::array<uint8_t, PieceTypeID::TOTAL + 1>, 2> regionHouses {};
+    unrankPlacement(regionDigits[0].data(), mRegionCounts[black], regionHouses[0].data());
+    unrankPlacement(regionDigits[1].data(), mRegionCounts[white], regionHouses[1].data());
+    std::array<uint8_t, 2 * PieceTypeID::TOTAL + 1> battlefieldHouses {};
+    unrankPlacement(battlefieldDigits.data(), nBattlefieldPieces, battlefieldHouses.data());
+
+    constexpr std::array<Piece::State, 4> kClassStates {
+        Piece::State::UNLAUNCHED, Piece::State::FINISHED, Piece::State::ON_BOARD, Piece::State::ON_BOARD,
+    };
+    static_assert(UNLAUNCHED == 0 && FINISHED == 1 && REGION == 2 && BATTLEFIELD == 3, "Classes must index kClassStates");
+    uint8_t nPlacedBattlefieldPieces { 0 };
+    for(uint8_t role { 0 }; role < 2; ++role) {
+        const uint16_t assignment { role == 0? black: white };
+        uint8_t nPlacedRegionPieces { 0 };
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            GamePosition::PiecePlacement& piece { position.mPieces[role][type] };
+            const uint8_t placementClass { static_cast<uint8_t>((assignment >> (2 * type)) & 0x3u) };
+            const bool isRegion { placementClass == REGION };
+            const bool isBattlefield { placementClass == BATTLEFIELD };
+            piece.mState = kClassStates[placementClass];
+            piece.mRoutePosition = static_cast<uint8_t>(
+                isRegion * regionHouses[role][nPlacedRegionPieces]
+                + isBattlefield * (kRegionLength + battlefieldHouses[nPlacedBattlefieldPieces])
+            );
+            nPlacedRegionPieces += isRegion;
+            nPlacedBattlefieldPieces += isBattlefield;
+        }
+    }
+    return position;
+}
+
+uint64_t PositionIndex::rankCanonical(const GamePosition& position, bool& isMirrored) const {
+    const CanonicalPosition canonical { canonicalize(position) };
+    isMirrored = canonical.mIsMirrored;
+    const uint64_t index { rank(canonical.mPosition) };
+    return index / kNTurnStates * (kNTurnStates / 2) + index % kNTurnStates;
+}
+
+GamePosition PositionIndex::unrankCanonical(uint64_t index) const {
+    assert(index < getCanonicalSize() && "Index must lie within the canonical index space");
+    return unrank(index / (kNTurnStates / 2) * kNTurnStates + index % (kNTurnStates / 2));
+}
@@ -0,0 +1,486 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/position_index.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the description of a game position in terms of its pieces and turn, along with a perfect hash mapping every such position to an index in a dense range.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPPOSITIONINDEX_H
+#define ZOAPPPOSITIONINDEX_H
+
+#include <cstdint>
+#include <array>
+
+#include "role_id.hpp"
+#include "phase.hpp"
+#include "piece_type_id.hpp"
+#include "piece.hpp"
+#include "ruleset.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The placement of every piece of both roles, along with the role whose turn it is and the part of the turn the game is in.
+ * 
+ * Counters, dice, and the previous turn's roll are not a part of a position.
+ * 
+ * @see GameOfUrModel::getPosition()
+ * @see PositionIndex
+ */
+struct GamePosition {
+    /**
+     * @brief The placement of a single piece.
+     * 
+     */
+    struct PiecePlacement {
+        /**
+         * @brief The state of the piece.
+         * 
+         */
+        Piece::State mState { Piece::State::UNLAUNCHED };
+
+        /**
+         * @brief The route position of the piece, considered only when it is on the board.
+         * 
+         */
+        uint8_t mRoutePosition { 0 };
+
+        /**
+         * @brief Tests whether two placements put a piece in the same place.
+         * 
+         */
+        bool operator==(const PiecePlacement& other) const {
+            return mState == other.mState && (mState != Piece::State::ON_BOARD || mRoutePosition == other.mRoutePosition);
+        }
+    };
+
+    /**
+     * @brief The placement of every piece, indexed by its owner's RoleID less one, and then by its PieceTypeID.
+     * 
+     */
+    std::array<std::array<PiecePlacement, PieceTypeID::TOTAL>, 2> mPieces {};
+
+    /**
+     * @brief The role whose turn it is.
+     * 
+     */
+    RoleID mTurn { RoleID::BLACK };
+
+    /**
+     * @brief The part of the turn the game is in.
+     * 
+     */
+    TurnPhase mTurnPhase { TurnPhase::ROLL_DICE };
+
+    /**
+     * @brief Tests whether two positions are the same.
+     * 
+     */
+    bool operator==(const GamePosition& other) const = default;
+
+    /**
+     * @brief Gets the mirror image of this position, with the roles of every piece and of the player to move swapped.
+     * 
+     * Both roles follow routes of the same shape, mirrored across the battlefield, so a piece's route position is unchanged by the swap.  A position and its mirror have the same value from the point of view of the player to move.
+     * 
+     * @return GamePosition The mirrored position.
+     */
+    GamePosition getMirror() const {
+        return {
+            .mPieces {{ mPieces[1], mPieces[0] }},
+            .mTurn { mTurn == RoleID::BLACK? RoleID::WHITE: RoleID::BLACK },
+            .mTurnPhase { mTurnPhase },
+        };
+    }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The representative of a position and its mirror, along with whether the position had to be mirrored to arrive at it.
+ * 
+ * @see canonicalize()
+ */
+struct CanonicalPosition {
+    /**
+     * @brief The representative position, in which black is always the role to move.
+     * 
+     */
+    GamePosition mPosition;
+
+    /**
+     * @brief Whether the representative is the mirror of the original position, in which case results computed for it should have their roles swapped before being applied to the original.
+     * 
+     */
+    bool mIsMirrored;
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief Maps a position and its mirror to the same representative, the one of the two in which black is to move.
+ * 
+ * @param position The position being canonicalized.
+ * @return CanonicalPosition The representative position, and whether it is the mirror of the original.
+ */
+inline CanonicalPosition canonicalize(const GamePosition& position) {
+    const bool isMirrored { position.mTurn == RoleID::WHITE };
+    return { .mPosition { isMirrored? position.getMirror(): position }, .mIsMirrored { isMirrored } };
+}
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A bijection between valid GamePositions and the integers from 0 up to (but excluding) getSize(), so that tables over positions may be flat arrays.
+ * 
+ * A position is valid when its turn belongs to black or white, every piece on the board lies before the end of its route, no two pieces of a role share a house of that role's region, and no two pieces share a house of the battlefield.  Every reachable position is valid, though not every valid position is reachable (a position in which both roles have completed their routes, for instance).  Under kUrRuleset there are 2,643,895,394,304 valid positions.
+ * 
+ * Each role's pieces are first sorted into classes (unlaunched, finished, in the role's region, or on the battlefield), and the houses taken by each role's region pieces and by the battlefield pieces of both roles are ranked as partial permutations.  An index is then made up of, from most to least significant, black's class assignment, black's region placement, white's class assignment, white's region placement, the battlefield placement, and the turn (black's turns before white's).  The offsets of each class assignment's positions are looked up from tables built at compile time, along with guides into those tables, the reciprocals of the divisors unranking needs, and tables selecting free houses, so that neither ranking nor unranking divides or counts bits, and neither branches on the class of any one piece.
+ * 
+ * Since canonical positions are exactly those with black to move, they take up the first half of the turn digit of every index, and the canonical index of a representative is its index with that half of the digit dropped.
+ * 
+ * @see kPositionIndex
+ */
+class PositionIndex {
+public:
+    /**
+     * @brief The number of houses in each role's own region.
+     * 
+     */
+    static constexpr uint8_t kRegionLength { kUrRuleset.getRegionLength() };
+
+    /**
+     * @brief The number of houses on the battlefield.
+     * 
+     */
+    static constexpr uint8_t kBattlefieldLength { kUrRuleset.getBattlefieldLength() };
+
+    /**
+     * @brief The number of ways the pieces of one role may be sorted into classes, two bits per piece.
+     * 
+     */
+    static constexpr uint16_t kNClassAssignments { 1u << (2 * PieceTypeID::TOTAL) };
+
+    /**
+     * @brief The number of combinations of the role whose turn it is and the phase of the turn.
+     * 
+     */
+    static constexpr uint8_t kNTurnStates { 2 * 3 };
+
+    /**
+     * @brief Builds the offset tables of every group of positions.
+     * 
+     */
+    constexpr PositionIndex();
+
+    /**
+     * @brief Gets the number of valid positions, one more than the largest index.
+     * 
+     * @return uint64_t The size of the index space.
+     */
+    constexpr uint64_t getSize() const { return mSize; }
+
+    /**
+     * @brief Tests whether a position is valid, and so has an index.
+     * 
+     * @param position The position being tested.
+     * @retval true The position is valid.
+     * @retval false The position breaks one of the invariants of valid positions.
+     */
+    bool isValid(const GamePosition& position) const;
+
+    /**
+     * @brief Gets the index of a position.
+     * 
+     * @param position A valid position.
+     * @return uint64_t The index of the position, less than getSize().
+     */
+    uint64_t rank(const GamePosition& position) const;
+
+    /**
+     * @brief Gets the position at an index.
+     * 
+     * @param index An index less than getSize().
+     * @return GamePosition The position whose rank is this index.
+     */
+    GamePosition unrank(uint64_t index) const;
+
+    /**
+     * @brief Gets the number of canonical positions, half the number of valid positions.
+     * 
+     * @return uint64_t The size of the canonical index space.
+     */
+    constexpr uint64_t getCanonicalSize() const { return mSize / 2; }
+
+    /**
+     * @brief Gets the index of a position's canonical representative, shared by the position and its mirror.
+     * 
+     * @param position A valid position.
+     * @param[out] isMirrored Set to whether the position had to be mirrored to arrive at its representative.
+     * @return uint64_t The index of the representative, less than getCanonicalSize().
+     */
+    uint64_t rankCanonical(const GamePosition& position, bool& isMirrored) const;
+
+    /**
+     * @brief Gets the canonical representative at an index.
+     * 
+     * @param index An index less than getCanonicalSize().
+     * @return GamePosition The representative position, with black to move, whose canonical rank is this index.
+     */
+    GamePosition unrankCanonical(uint64_t index) const;
+
+private:
+    /**
+     * @brief The class of a piece's placement, stored in two bits for each piece of a class assignment.
+     * 
+     */
+    enum PlacementClass: uint8_t {
+        UNLAUNCHED, //< The piece hasn't been launched yet.
+        FINISHED, //< The piece has completed its route.
+        REGION, //< The piece is on a house of its role's own region.
+        BATTLEFIELD, //< The piece is on a house of the battlefield.
+    };
+
+    /**
+     * @brief Counts the ways of placing some number of distinct pieces in distinct houses.
+     * 
+     * @param nHouses The number of houses available.
+     * @param nPieces The number of pieces placed.
+     * @return uint64_t The number of placements, or 0 if there are more pieces than houses.
+     */
+    static constexpr uint64_t countPlacements(uint8_t nHouses, uint8_t nPieces) {
+        if(nPieces > nHouses) return 0;
+        uint64_t count { 1 };
+        for(uint8_t piece { 0 }; piece < nPieces; ++piece) count *= nHouses - piece;
+        return count;
+    }
+
+    /**
+     * @brief The number of houses covered by a single lookup of mChunkSelects.
+     * 
+     */
+    static constexpr uint8_t kChunkLength { 6 };
+
+    /**
+     * @brief The number of bits the multipliers of mRadixMultipliers are scaled by.
+     * 
+     */
+    static constexpr uint8_t kRadixShift { 32 };
+
+    /**
+     * @brief Gets the house with some rank among the houses not yet taken, by selecting it from whichever of two chunks of houses holds it.
+     * 
+     * @param rank The number of untaken houses preceding the house.
+     * @param takenHouses A mask of the houses already taken, where bit N corresponds to house N.
+     * @return uint8_t The index of the house.
+     */
+    uint8_t getFreeHouse(uint8_t rank, uint16_t takenHouses) const;
+
+    /**
+     * @brief Splits a dividend into its quotient and remainder by one of the few divisors unrank() uses, without a 64-bit division.
+     * 
+     * @param[in,out] dividend The dividend, replaced by the remainder.
+     * @param divisor The divisor.
+     * @param reciprocal The reciprocal of the divisor, which gives a quotient off by at most one that is then corrected.
+     * @return uint64_t The quotient.
+     */
+    static uint64_t divide(uint64_t& dividend, uint64_t divisor, double reciprocal);
+
+    /**
+     * @brief The number of buckets of indices a guide to a table of offsets divides the table's indices into.
+     * 
+     */
+    static constexpr uint16_t kNGuideBuckets { kNClassAssignments };
+
+    /**
+     * @brief The group of positions holding the first index of each bucket of a table of offsets, from which findGroup() starts its search.
+     * 
+     */
+    using Guide = std::array<uint16_t, kNGuideBuckets>;
+
+    /**
+     * @brief Builds the guide to a table of offsets.
+     * 
+     * @param offsets The offsets of each class assignment's positions, with their total last.
+     * @param[out] guide The group holding the first index of each bucket.
+     * @param[out] guideShift The shift turning an index into its bucket, the smallest that fits every index of the table into the guide.
+     */
+    static constexpr void buildGuide(const std::array<uint64_t, kNClassAssignments + 1>& offsets, Guide& guide, uint8_t& guideShift);
+
+    /**
+     * @brief Finds the group of positions holding an index, i.e., the last class assignment whose offset doesn't exceed it.
+     * 
+     * Class assignments without any positions share their offset with the next, and so are never found.  The search starts at the group the guide gives for the index's bucket, and steps forward past the offsets of any groups starting within the bucket before the index, of which there are seldom more than one or two, as buckets crossing many offsets are those of the smallest groups.
+     * 
+     * @param offsets The offsets of each class assignment's positions.
+     * @param guide The guide to the offsets.
+     * @param guideShift The shift turning an index into its bucket.
+     * @param index The index being looked for, relative to the offsets.
+     * @return uint16_t The class assignment whose positions include this index.
+     */
+    static uint16_t findGroup(const std::array<uint64_t, kNClassAssignments + 1>& offsets, const Guide& guide, uint8_t guideShift, uint64_t index);
+
+    /**
+     * @brief The number of pieces in each role's region, indexed by class assignment.
+     * 
+     */
+    std::array<uint8_t, kNClassAssignments> mRegionCounts {};
+
+    /**
+     * @brief The number of pieces on the battlefield, indexed by class assignment.
+     * 
+     */
+    std::array<uint8_t, kNClassAssignments> mBattlefieldCounts {};
+
+    /**
+     * @brief The number of ways of placing each number of pieces on the battlefield.
+     * 
+     */
+    std::array<uint64_t, 2 * PieceTypeID::TOTAL + 1> mBattlefieldPlacementCounts {};
+
+    /**
+     * @brief The offset of the positions having each class assignment for black, with the total number of positions last.
+     * 
+     */
+    std::array<uint64_t, kNClassAssignments + 1> mBlackOffsets {};
+
+    /**
+     * @brief The offset, relative to black's, of the positions having each class assignment for white, indexed by the number of black pieces on the battlefield, with the total for that number of black battlefield pieces last.
+     * 
+     */
+    std::array<std::array<uint64_t, kNClassAssignments + 1>, PieceTypeID::TOTAL + 1> mWhiteOffsets {};
+
+    /**
+     * @brief The guide to mBlackOffsets.
+     * 
+     */
+    Guide mBlackGuide {};
+
+    /**
+     * @brief The guide to each table of mWhiteOffsets.
+     * 
+     */
+    std::array<Guide, PieceTypeID::TOTAL + 1> mWhiteGuides {};
+
+    /**
+     * @brief The shift turning an index into its bucket of mBlackGuide.
+     * 
+     */
+    uint8_t mBlackGuideShift { 0 };
+
+    /**
+     * @brief The shift turning an index into its bucket of each guide of mWhiteGuides.
+     * 
+     */
+    std::array<uint8_t, PieceTypeID::TOTAL + 1> mWhiteGuideShifts {};
+
+    /**
+     * @brief The reciprocal of each white offset total, for dividing indices by them.
+     * 
+     */
+    std::array<double, PieceTypeID::TOTAL + 1> mWhiteTotalReciprocals {};
+
+    /**
+     * @brief The reciprocal of each count of battlefield placements, for dividing indices by them.
+     * 
+     */
+    std::array<double, 2 * PieceTypeID::TOTAL + 1> mBattlefieldPlacementReciprocals {};
+
+    /**
+     * @brief The multiplier dividing a rank of a partial permutation by each radix its digits take, as ceil(2^kRadixShift / radix).
+     * 
+     */
+    std::array<uint64_t, kBattlefieldLength + 1> mRadixMultipliers {};
+
+    /**
+     * @brief The number of bits set in each chunk of kChunkLength houses.
+     * 
+     */
+    std::array<uint8_t, 1u << kChunkLength> mChunkCounts {};
+
+    /**
+     * @brief The position of each bit set in each chunk of kChunkLength houses, by the number of set bits preceding it.
+     * 
+     */
+    std::array<std::array<uint8_t, 8>, 1u << kChunkLength> mChunkSelects {};
+
+    /**
+     * @brief The number of valid positions.
+     * 
+     */
+    uint64_t mSize { 0 };
+};
+
+constexpr void PositionIndex::buildGuide(const std::array<uint64_t, kNClassAssignments + 1>& offsets, Guide& guide, uint8_t& guideShift) {
+    guideShift = 0;
+    while(((offsets[kNClassAssignments] - 1) >> guideShift) >= kNGuideBuckets) ++guideShift;
+
+    uint16_t group { 0 };
+    for(uint16_t bucket { 0 }; bucket < kNGuideBuckets; ++bucket) {
+        const uint64_t bucketStart { static_cast<uint64_t>(bucket) << guideShift };
+        while(group + 1 < kNClassAssignments && offsets[group + 1] <= bucketStart) ++group;
+        guide[bucket] = group;
+    }
+}
+
+constexpr PositionIndex::PositionIndex() {
+    for(uint16_t assignment { 0 }; assignment < kNClassAssignments; ++assignment) {
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const uint8_t placementClass { static_cast<uint8_t>((assignment >> (2 * type)) & 0x3u) };
+            if(placementClass == REGION) ++mRegionCounts[assignment];
+            if(placementClass == BATTLEFIELD) ++mBattlefieldCounts[assignment];
+        }
+    }
+
+    for(uint8_t nPieces { 0 }; nPieces < mBattlefieldPlacementCounts.size(); ++nPieces) {
+        mBattlefieldPlacementCounts[nPieces] = countPlacements(kBattlefieldLength, nPieces);
+    }
+
+    // the positions of a pair of class assignments are every combination of
+    // black's region placements, white's region placements, and the placements
+    // of both roles' battlefield pieces
+    for(uint8_t nBlackBattlefield { 0 }; nBlackBattlefield <= PieceTypeID::TOTAL; ++nBlackBattlefield) {
+        std::array<uint64_t, kNClassAssignments + 1>& whiteOffsets { mWhiteOffsets[nBlackBattlefield] };
+        for(uint16_t white { 0 }; white < kNClassAssignments; ++white) {
+            whiteOffsets[white + 1] = whiteOffsets[white] + (
+                countPlacements(kRegionLength, mRegionCounts[white])
+                * countPlacements(kBattlefieldLength, nBlackBattlefield + mBattlefieldCounts[white])
+            );
+        }
+    }
+    for(uint16_t black { 0 }; black < kNClassAssignments; ++black) {
+        mBlackOffsets[black + 1] = mBlackOffsets[black] + (
+            countPlacements(kRegionLength, mRegionCounts[black])
+            * mWhiteOffsets[mBattlefieldCounts[black]][kNClassAssignments]
+        );
+    }
+    mSize = mBlackOffsets[kNClassAssignments] * kNTurnStates;
+
+    buildGuide(mBlackOffsets, mBlackGuide, mBlackGuideShift);
+    for(uint8_t nBlackBattlefield { 0 }; nBlackBattlefield <= PieceTypeID::TOTAL; ++nBlackBattlefield) {
+        buildGuide(mWhiteOffsets[nBlackBattlefield], mWhiteGuides[nBlackBattlefield], mWhiteGuideShifts[nBlackBattlefield]);
+        mWhiteTotalReciprocals[nBlackBattlefield] = 1.0 / mWhiteOffsets[nBlackBattlefield][kNClassAssignments];
+    }
+    for(uint8_t nPieces { 0 }; nPieces < mBattlefieldPlacementCounts.size(); ++nPieces) {
+        mBattlefieldPlacementReciprocals[nPieces] = 1.0 / mBattlefieldPlacementCounts[nPieces];
+    }
+    for(uint8_t radix { 1 }; radix <= kBattlefieldLength; ++radix) {
+        mRadixMultipliers[radix] = ((uint64_t { 1 } << kRadixShift) + radix - 1) / radix;
+    }
+    for(uint8_t chunk { 0 }; chunk < mChunkCounts.size(); ++chunk) {
+        for(uint8_t house { 0 }; house < kChunkLength; ++house) {
+            if(chunk & (1u << house)) mChunkSelects[chunk][mChunkCounts[chunk]++] = house;
+        }
+    }
+}
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The index of every position of the game.
+ * 
+ */
+inline constexpr PositionIndex kPositionIndex {};
+
+static_assert(kPositionIndex.getSize() == 2643895394304ull, "The documented size of the position index must match the ruleset");
+
+#endif
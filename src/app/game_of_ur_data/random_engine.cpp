@@ -0,0 +1,15 @@
+#include <atomic>
+#include <random>
+
+#include "random_engine.hpp"
+
+RandomEngine RandomEngine::fromProcessSeed() {
+    static const uint64_t processSeed {
+        [] {
+            std::random_device randomDevice {};
+            return (static_cast<uint64_t>(randomDevice()) << 32) ^ randomDevice();
+        }()
+    };
+    static std::atomic<uint64_t> nextStream { 0 };
+    return RandomEngine { processSeed, nextStream.fetch_add(1, std::memory_order_relaxed) };
+}
@@ -0,0 +1,151 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/random_engine.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the small, seedable, counter-based random number generator used by the game's dice and computer players.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPRANDOMENGINE_H
+#define ZOAPPRANDOMENGINE_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A counter-based random number generator, whose every output is a hash of its stream key and the number of values drawn so far.
+ * 
+ * The whole state of the engine is a pair of integers, so that it is cheap to create and may be copied freely (along with the Dice and GameOfUrModel holding it).  Engines built from the same seed and stream produce identical sequences on every platform.  Distinct streams of one seed are statistically independent, and are meant to be handed out one per thread or per simulated game.
+ * 
+ * Satisfies the requirements of UniformRandomBitGenerator, and so may be used with the standard library's distributions.
+ * 
+ */
+class RandomEngine {
+public:
+    /**
+     * @brief The type of value produced by the engine.
+     * 
+     */
+    using result_type = uint64_t;
+
+    /**
+     * @brief Creates an engine for one stream of a seed.
+     * 
+     * @param seed The seed shared by a family of engines.
+     * @param stream The index of this engine's stream within the family.
+     */
+    constexpr explicit RandomEngine(uint64_t seed, uint64_t stream=0):
+        mKey { mix(mix(seed) ^ (stream * kGamma + kStreamSalt)) }
+    {}
+
+    /**
+     * @brief Creates an engine on a fresh stream of a seed chosen once per process.
+     * 
+     * Only the first call reads from a random device; every call after it just claims the next unused stream.
+     * 
+     * @return RandomEngine An engine whose sequence differs from that of every other engine created this way.
+     */
+    static RandomEngine fromProcessSeed();
+
+    /**
+     * @brief The smallest value the engine may produce.
+     * 
+     */
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+
+    /**
+     * @brief The largest value the engine may produce.
+     * 
+     */
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Produces the next value in this engine's sequence.
+     * 
+     * @return result_type A uniformly distributed 64-bit value.
+     */
+    constexpr result_type operator()() { return mix(mKey + (++mCounter) * kGamma); }
+
+    /**
+     * @brief Draws a value below some bound from the top bits of the next value, by multiplying them by the bound and keeping the high half.
+     * 
+     * Unlike the standard library's distributions, whose algorithms are left to each implementation, this gives the same values on every platform.  Every value is drawn with a probability within bound / 2^32 of every other.
+     * 
+     * @param bound The number of values that may be drawn, at least 1.
+     * @return uint32_t A value from 0 up to but not including the bound.
+     */
+    constexpr uint32_t drawBelow(uint32_t bound) { return static_cast<uint32_t>((((*this)() >> 32) * bound) >> 32); }
+
+    /**
+     * @brief Skips over some number of values in this engine's sequence, in constant time.
+     * 
+     * @param count The number of values skipped.
+     */
+    constexpr void discard(uint64_t count) { mCounter += count; }
+
+    /**
+     * @brief Creates an engine on a stream derived from this one's, without disturbing this engine.
+     * 
+     * Asking for the same index twice produces the same engine, so threads may derive their streams from a shared engine without coordinating.
+     * 
+     * @param stream The index of the derived stream.
+     * @return RandomEngine An engine at the start of the derived stream.
+     */
+    constexpr RandomEngine getStream(uint64_t stream) const { return RandomEngine { mKey, stream }; }
+
+    /**
+     * @brief Creates an engine on a new stream seeded by the next value of this one, advancing this engine.
+     * 
+     * @return RandomEngine An engine independent of this one.
+     */
+    constexpr RandomEngine split() { return RandomEngine { (*this)(), mKey }; }
+
+    /**
+     * @brief Tests whether two engines will produce the same sequence from here on.
+     * 
+     */
+    constexpr bool operator==(const RandomEngine& other) const = default;
+
+private:
+    /**
+     * @brief The increment between the hashed inputs of successive values, the golden ratio in fixed point.
+     * 
+     */
+    static constexpr uint64_t kGamma { 0x9E3779B97F4A7C15ull };
+
+    /**
+     * @brief A constant distinguishing stream indices from seeds, so that seed N stream 0 and seed 0 stream N differ.
+     * 
+     */
+    static constexpr uint64_t kStreamSalt { 0xD1B54A32D192ED03ull };
+
+    /**
+     * @brief Hashes a 64-bit value into a well distributed 64-bit value (the finaliser of SplitMix64).
+     * 
+     * @param value The value being hashed.
+     * @return uint64_t The hashed value.
+     */
+    static constexpr uint64_t mix(uint64_t value) {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    /**
+     * @brief The key identifying this engine's seed and stream.
+     * 
+     */
+    uint64_t mKey;
+
+    /**
+     * @brief The number of values drawn from this engine so far.
+     * 
+     */
+    uint64_t mCounter { 0 };
+};
+
+#endif
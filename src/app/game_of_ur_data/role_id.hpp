@@ -12,12 +12,14 @@
 #ifndef ZOAPPPLAYERROLEID_H
 #define ZOAPPPLAYERROLEID_H
 
+#include <cstdint>
+
 /**
  * @ingroup UrGameDataModel
  * @brief A value representing the various roles (or sets, if preferred) possible in this game.
  * 
  */
-enum RoleID {
+enum RoleID: uint8_t {
     NA, //< Role assignment hasn't been done yet, or the data containing this represents some object considered "empty."
     BLACK, //< The role (and the corresponding set of pieces) whose player goes first in the play phase of the game.
     WHITE, //< The role (and the corresponding set of pieces) whose player goes second in the play phase of the game.
@@ -0,0 +1,241 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/route.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains tables, generated at compile time, describing the route each role's pieces follow and the outcome of every move along it.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPROUTE_H
+#define ZOAPPROUTE_H
+
+#include <cstdint>
+#include <cassert>
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "role_id.hpp"
+#include "ruleset.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A table describing the route followed by the pieces of a single role, along with the outcome of every move that can be made along it.
+ * 
+ * A piece's route position is the number of houses it has left behind on its route.  Under kUrRuleset, positions 0 through 3 lie in the role's own region (the last of them being its rosette), positions 4 through 15 lie on the battlefield, and kRouteEnd lies one past the last house of the route.
+ * 
+ * The layout of Board::mGrid is derived from these tables.
+ * 
+ * @see kRouteTables
+ */
+class RouteTable {
+public:
+    /**
+     * @brief The route position of a piece that has completed its route.
+     * 
+     */
+    static constexpr uint8_t kRouteEnd { kUrRuleset.getRouteLength() };
+
+    /**
+     * @brief The route position reported for locations that don't lie on this table's route.
+     * 
+     */
+    static constexpr uint8_t kOffRoute { 0xFF };
+
+    /**
+     * @brief The outcome of moving a piece some number of steps forward from some position on its route.
+     * 
+     */
+    struct Step {
+        /**
+         * @brief Enum values corresponding to masks used on Step::mFlags.
+         * 
+         * Their values match those of the corresponding MoveResultData::Flags.
+         * 
+         */
+        enum Flags: uint8_t {
+            IS_POSSIBLE=0x1, //< Whether the move stays on the route, i.e., whether it doesn't overshoot the end of the route.
+            PASSES_ROSETTE=0x2, //< Whether a rosette lies between the start and the destination of the move.
+            LANDS_ON_ROSETTE=0x4, //< Whether the destination of the move is a rosette.
+            COMPLETES_ROUTE=0x8, //< Whether the destination of the move is the end of the route.
+        };
+
+        /**
+         * @brief The route position at which the move ends, or kOffRoute if the move isn't possible.
+         * 
+         */
+        uint8_t mDestination { kOffRoute };
+
+        /**
+         * @brief Flags describing the move.
+         * 
+         */
+        uint8_t mFlags { 0 };
+    };
+
+    /**
+     * @brief Generates the route table for a role.
+     * 
+     * The table generated for RoleID::NA reports every location as off its route, and every move as impossible.
+     * 
+     * @param role The role whose route is described by this table.
+     */
+    constexpr explicit RouteTable(RoleID role);
+
+    /**
+     * @brief Tests whether the house at some route position is a rosette house.
+     * 
+     * @param routePosition The route position being tested.
+     * @retval true The house at this route position is a rosette.
+     * @retval false The house at this route position is not a rosette, or isn't a house at all.
+     */
+    static constexpr bool isRosettePosition(uint8_t routePosition) {
+        return routePosition < kRouteEnd && routePosition % kUrRuleset.mRosetteSpacing == kUrRuleset.mRosetteSpacing - 1;
+    }
+
+    /**
+     * @brief Gets the outcome of moving a piece forward by some number of steps from a position on its route.
+     * 
+     * @param routePosition The route position the piece is moving from.
+     * @param steps The number of houses the piece moves forward by, usually the dice roll.
+     * @return const Step& The outcome of the move.
+     */
+    const Step& getStep(uint8_t routePosition, uint8_t steps) const {
+        assert(routePosition <= kRouteEnd && steps <= kRouteEnd && "Route position and step count must lie within the route");
+        return mSteps[routePosition][steps];
+    }
+
+    /**
+     * @brief Gets the board location corresponding to a route position.
+     * 
+     * @param routePosition A position on this route, between 0 and kRouteEnd.
+     * @return glm::u8vec2 The board location of that position.
+     */
+    constexpr glm::u8vec2 getLocation(uint8_t routePosition) const {
+        assert(routePosition <= kRouteEnd && "Route position must lie within the route");
+        return { mLocations[routePosition][0], mLocations[routePosition][1] };
+    }
+
+    /**
+     * @brief Gets the route position corresponding to a board location.
+     * 
+     * @param location The board location (or the end of the route).
+     * @return uint8_t The route position of this location, or kOffRoute if it doesn't lie on this route.
+     */
+    uint8_t getRoutePosition(glm::u8vec2 location) const {
+        if(location.x >= mRoutePositions.size() || location.y >= mRoutePositions[location.x].size()) return kOffRoute;
+        return mRoutePositions[location.x][location.y];
+    }
+
+    /**
+     * @brief Gets a mask of the route positions a piece of some type may be launched to, where bit N corresponds to route position N.
+     * 
+     * @param pieceType The type of piece being launched.
+     * @return uint32_t The mask of valid launch positions for this piece type.
+     */
+    constexpr uint32_t getLaunchPositions(PieceTypeID pieceType) const { return mLaunchPositions[pieceType]; }
+
+    /**
+     * @brief Tests whether a piece of some type may be launched to a route position.
+     * 
+     * @param routePosition The route position being tested.
+     * @param pieceType The type of piece being launched.
+     * @retval true The piece may be launched to the house at this route position.
+     * @retval false The piece can't be launched here.
+     */
+    bool isLaunchPosition(uint8_t routePosition, PieceTypeID pieceType) const {
+        return routePosition < kRouteEnd && ((mLaunchPositions[pieceType] >> routePosition) & 1u);
+    }
+
+private:
+    /**
+     * @brief The outcome of every move along the route, indexed by the route position moved from and the number of steps moved.
+     * 
+     */
+    std::array<std::array<Step, kRouteEnd + 1>, kRouteEnd + 1> mSteps {};
+
+    /**
+     * @brief The board location of every route position, stored as plain integers so that this table may be built at compile time.
+     * 
+     */
+    std::array<std::array<uint8_t, 2>, kRouteEnd + 1> mLocations {};
+
+    /**
+     * @brief The route position of every board location (including the end of the route), indexed by its x and y components.
+     * 
+     */
+    std::array<std::array<uint8_t, kUrRuleset.getBattlefieldLength() + 1>, 3> mRoutePositions {};
+
+    /**
+     * @brief Masks of the valid launch positions for each type of piece, indexed by PieceTypeID.
+     * 
+     */
+    std::array<uint32_t, PieceTypeID::TOTAL> mLaunchPositions {};
+};
+
+constexpr RouteTable::RouteTable(RoleID role) {
+    for(auto& row: mRoutePositions) {
+        row.fill(kOffRoute);
+    }
+    if(role == RoleID::NA) return;
+
+    // the route starts at the far end of this role's own region, enters the
+    // battlefield after the region's rosette, and ends just past the
+    // battlefield's last house
+    const uint8_t regionLength { kUrRuleset.getRegionLength() };
+    const uint8_t homeRow { static_cast<uint8_t>(role == RoleID::BLACK? 0: 2) };
+    for(uint8_t position { 0 }; position <= kRouteEnd; ++position) {
+        const uint8_t x { static_cast<uint8_t>(position < regionLength? homeRow: 1) };
+        const uint8_t y { static_cast<uint8_t>(position < regionLength? regionLength - 1 - position: position - regionLength) };
+        mLocations[position] = { x, y };
+        mRoutePositions[x][y] = position;
+    }
+
+    // moves of 0 steps, and moves overshooting the end of the route, are not possible
+    for(uint8_t position { 0 }; position <= kRouteEnd; ++position) {
+        for(uint8_t steps { 1 }; position + steps <= kRouteEnd; ++steps) {
+            const uint8_t destination { static_cast<uint8_t>(position + steps) };
+            uint8_t flags { Step::IS_POSSIBLE };
+            for(uint8_t passed { static_cast<uint8_t>(position + 1) }; passed < destination; ++passed) {
+                if(isRosettePosition(passed)) flags |= Step::PASSES_ROSETTE;
+            }
+            if(isRosettePosition(destination)) flags |= Step::LANDS_ON_ROSETTE;
+            if(destination == kRouteEnd) flags |= Step::COMPLETES_ROUTE;
+
+            mSteps[position][steps] = Step { .mDestination { destination }, .mFlags { flags } };
+        }
+    }
+
+    for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+        const PieceType& pieceType { kGamePieceTypes[type] };
+        switch(pieceType.mLaunchType) {
+            // the house just before any rosette
+            case PieceType::ONE_BEFORE_ROSETTE:
+                for(uint8_t position { 0 }; position + 1 < kRouteEnd; ++position) {
+                    if(isRosettePosition(position + 1)) mLaunchPositions[type] |= (1u << position);
+                }
+                break;
+
+            // the house ordinally equal to the launch roll
+            case PieceType::SAME_AS_LAUNCH_ROLL:
+                mLaunchPositions[type] |= (1u << (pieceType.mLaunchRoll - 1));
+                break;
+        }
+    }
+}
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The route tables for every role, indexed by RoleID.
+ * 
+ */
+inline constexpr std::array<RouteTable, 3> kRouteTables {{
+    RouteTable { RoleID::NA },
+    RouteTable { RoleID::BLACK },
+    RouteTable { RoleID::WHITE },
+}};
+
+#endif
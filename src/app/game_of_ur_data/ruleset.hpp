@@ -0,0 +1,129 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/ruleset.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the compile-time description of the rules of Game of Ur from which the board, its routes, and the game's pieces and counters are derived.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPRULESET_H
+#define ZOAPPRULESET_H
+
+#include <cstdint>
+#include <array>
+
+#include "piece_type_id.hpp"
+#include "piece_type.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A description of one variant of the rules of Game of Ur, which every rule-dependent table in the data model is derived from at compile time.
+ * 
+ * The board is made up of three rows: the first and last each form the private region of one role, and the middle one forms the battlefield shared by both.  A piece's route runs backwards along its own region, then forwards along the battlefield, and ends just past the battlefield's last house.
+ * 
+ * @see kUrRuleset
+ */
+struct Ruleset {
+    /**
+     * @brief The number of houses present in each row of the board, i.e., for each value of a location's x component.
+     * 
+     */
+    std::array<uint8_t, 3> mRowLengths;
+
+    /**
+     * @brief The spacing between rosettes along a route, where the last house of each span of this length is a rosette.
+     * 
+     */
+    uint8_t mRosetteSpacing;
+
+    /**
+     * @brief The description of each type of piece, indexed by PieceTypeID.
+     * 
+     */
+    std::array<PieceType, PieceTypeID::TOTAL> mPieceTypes;
+
+    /**
+     * @brief The number of counters each player holds at the start of the game.
+     * 
+     */
+    uint8_t mStartingCounters;
+
+    /**
+     * @brief The number of counters each player places in the common pool when the play phase begins.
+     * 
+     */
+    uint8_t mStake;
+
+    /**
+     * @brief Gets the number of houses in each role's own region.
+     * 
+     * @return uint8_t The length of a role's region.
+     */
+    constexpr uint8_t getRegionLength() const { return mRowLengths[0]; }
+
+    /**
+     * @brief Gets the number of houses on the battlefield.
+     * 
+     * @return uint8_t The length of the battlefield.
+     */
+    constexpr uint8_t getBattlefieldLength() const { return mRowLengths[1]; }
+
+    /**
+     * @brief Gets the number of houses along each role's route, which is also the route position of the end of the route.
+     * 
+     * @return uint8_t The length of a route.
+     */
+    constexpr uint8_t getRouteLength() const { return getRegionLength() + getBattlefieldLength(); }
+
+    /**
+     * @brief Gets the number of houses on the board.
+     * 
+     * @return uint8_t The number of houses on the board.
+     */
+    constexpr uint8_t getNHouses() const { return mRowLengths[0] + mRowLengths[1] + mRowLengths[2]; }
+
+    /**
+     * @brief Gets the number of counters in the game, shared between both players and the common pool.
+     * 
+     * @return uint8_t The number of counters in the game.
+     */
+    constexpr uint8_t getTotalCounters() const { return 2 * mStartingCounters; }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The rules this application plays by.
+ * 
+ */
+inline constexpr Ruleset kUrRuleset {
+    .mRowLengths {{ 4, 12, 4 }},
+    .mRosetteSpacing { 4 },
+    .mPieceTypes {{
+        {.mName="swallow", .mLaunchRoll=2, .mLaunchType=PieceType::LaunchType::ONE_BEFORE_ROSETTE, .mCost=3},
+        {.mName="storm-bird", .mLaunchRoll=5,  .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=4},
+        {.mName="raven", .mLaunchRoll=6, .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=4},
+        {.mName="rooster", .mLaunchRoll=7, .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=4},
+        {.mName="eagle", .mLaunchRoll=10, .mLaunchType=PieceType::LaunchType::SAME_AS_LAUNCH_ROLL, .mCost=5},
+    }},
+    .mStartingCounters { 25 },
+    .mStake { 10 },
+};
+
+static_assert(kUrRuleset.mRowLengths[0] == kUrRuleset.mRowLengths[2], "Both roles' regions must be of the same length");
+static_assert(kUrRuleset.getRegionLength() <= kUrRuleset.getBattlefieldLength(), "A role's region may not extend past the battlefield");
+static_assert(kUrRuleset.getNHouses() <= 32, "Board occupancy must fit in a 32-bit mask");
+static_assert(kUrRuleset.mStake <= kUrRuleset.mStartingCounters, "Players must be able to afford their stake");
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief An array of PieceTypes, each element describing a single type of piece used in the game.
+ * 
+ * Available at compile time, so that tables derived from it (such as kRouteTables) may be too.
+ * 
+ */
+inline constexpr const std::array<PieceType, PieceTypeID::TOTAL>& kGamePieceTypes { kUrRuleset.mPieceTypes };
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/search_action.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the description of a single action of a player, as chosen by a search and taken through a player's controls.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPSEARCHACTION_H
+#define ZOAPPSEARCHACTION_H
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "piece.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A single action a player may take, as chosen by a search.
+ * 
+ */
+struct SearchAction {
+    /**
+     * @brief The kinds of action a player may take.
+     * 
+     */
+    enum class Type: uint8_t {
+        NONE, //< No action, chosen only when the game is over.
+        DICE_ROLL, //< Roll the dice.
+        LAUNCH, //< Launch an unlaunched piece onto the board.
+        BOARD_MOVE, //< Move a piece already on the board along its route.
+        NEXT_TURN, //< End the turn.
+    };
+
+    /**
+     * @brief The kind of action.
+     * 
+     */
+    Type mType { Type::NONE };
+
+    /**
+     * @brief The piece moved, meaningful for launches and board moves.
+     * 
+     */
+    PieceIdentity mPiece {};
+
+    /**
+     * @brief The location the piece is moved to, meaningful for launches and board moves.
+     * 
+     */
+    glm::u8vec2 mLocation {};
+};
+
+inline bool operator==(const SearchAction& one, const SearchAction& two) {
+    if(one.mType != two.mType) return false;
+    // only moves name a piece and location
+    if(one.mType != SearchAction::Type::LAUNCH && one.mType != SearchAction::Type::BOARD_MOVE) return true;
+    return one.mPiece == two.mPiece && one.mLocation == two.mLocation;
+}
+
+inline bool operator!=(const SearchAction& one, const SearchAction& two) {
+    return !(one == two);
+}
+
+#endif
@@ -0,0 +1,345 @@
+#include <cassert>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+#include "solver.hpp"
+#include "dice.hpp"
+#include "model.hpp"
+#include "route.hpp"
+#include "ruleset.hpp"
+
+Solver::Solver(uint8_t maxPiecesLeft, double winWeight, uint8_t counterStep):
+    mIndex { maxPiecesLeft },
+    mWinWeight { winWeight },
+    mCounterStep { winWeight < 1.0? counterStep: kTotalCounters },
+    mNCounterLevels {
+        winWeight < 1.0?
+        (kTotalCounters / counterStep + 1u) * (kTotalCounters / counterStep + 2u) / 2u:
+        1u
+    },
+    mValues(mIndex.getSize() * mNCounterLevels),
+    mPlayOutcomes { getPlayOutcomes() }
+{
+    assert(winWeight >= 0.0 && winWeight <= 1.0 && "The win weight is a share of a game's value");
+    assert(counterStep > 0 && kTotalCounters % counterStep == 0 && "Counter levels must divide the counters in play evenly");
+}
+
+std::array<Solver::PrimaryOutcome, 4> Solver::getPlayOutcomes() {
+    const Dice dice { RandomEngine { 0 } };
+    const Dice::OutcomeList primaryOutcomes { dice.getOutcomes(GamePhase::PLAY) };
+    assert(primaryOutcomes.size() == 4 && "The primary die has 4 faces");
+
+    std::array<PrimaryOutcome, 4> playOutcomes {};
+    for(std::size_t face { 0 }; face < primaryOutcomes.size(); ++face) {
+        const Dice::Outcome& primaryOutcome { primaryOutcomes[face] };
+        Dice primaryRolled { dice };
+        primaryRolled.force(primaryOutcome);
+        const Dice::OutcomeList secondaryOutcomes { primaryRolled.getOutcomes(GamePhase::PLAY) };
+        assert(secondaryOutcomes.size() == 2 && "The secondary die has 2 faces");
+
+        playOutcomes[face] = {
+            .mOutcome { .mScore { primaryOutcome.mResultScore }, .mProbability { primaryOutcome.mProbability } },
+            .mSecondaryOutcomes {{
+                { .mScore { secondaryOutcomes[0].mResultScore }, .mProbability { secondaryOutcomes[0].mProbability } },
+                { .mScore { secondaryOutcomes[1].mResultScore }, .mProbability { secondaryOutcomes[1].mProbability } },
+            }},
+        };
+    }
+    return playOutcomes;
+}
+
+double Solver::getWinProbability(const GamePosition& position) const {
+    assert(!tracksCounters() && "The values of this table aren't probabilities of winning");
+    return getValue(position, 0, 0);
+}
+
+double Solver::getExpectedCounters(const GamePosition& position, uint8_t ownCounters, uint8_t otherCounters) const {
+    assert(mWinWeight == 0.0 && "The values of this table aren't shares of the counters in play");
+    return getValue(position, ownCounters, otherCounters) * kTotalCounters;
+}
+
+double Solver::getPositionValue(uint64_t position, uint8_t ownCounters, uint8_t otherCounters) const {
+    if(!tracksCounters()) return getTableValue(position);
+
+    const uint64_t entry { position * mNCounterLevels };
+    return interpolateCounterLevels(
+        mCounterStep, ownCounters, otherCounters, [this, entry](uint32_t level) { return getTableValue(entry + level); }
+    );
+}
+
+SolverResult Solver::solve(unsigned nThreads, double tolerance) {
+    SolverResult result {};
+    result.mNPositions = getTableSize();
+    result.mMemoryBytes = getMemoryBytes();
+    result.mConverged = true;
+    tolerance = std::max(tolerance, kMinTolerance);
+    const auto start { std::chrono::steady_clock::now() };
+
+    // every group depends on its mirror and on groups with one piece fewer,
+    // so groups are solved in order of the pieces left to both players
+    const uint8_t maxPiecesLeft { mIndex.getMaxPiecesLeft() };
+    for(uint8_t nPiecesLeft { 2 }; nPiecesLeft <= 2 * maxPiecesLeft; ++nPiecesLeft) {
+        for(uint8_t ownPiecesLeft { 1 }; ownPiecesLeft <= maxPiecesLeft; ++ownPiecesLeft) {
+            const uint8_t otherPiecesLeft { static_cast<uint8_t>(nPiecesLeft - ownPiecesLeft) };
+            if(otherPiecesLeft < ownPiecesLeft || otherPiecesLeft > maxPiecesLeft) continue;
+
+            std::vector<std::pair<uint64_t, uint64_t>> ranges {
+                { mIndex.getGroupBegin(ownPiecesLeft, otherPiecesLeft), mIndex.getGroupEnd(ownPiecesLeft, otherPiecesLeft) },
+            };
+            if(otherPiecesLeft != ownPiecesLeft) {
+                ranges.push_back({ mIndex.getGroupBegin(otherPiecesLeft, ownPiecesLeft), mIndex.getGroupEnd(otherPiecesLeft, ownPiecesLeft) });
+            }
+
+            double maxDelta { 0.0 };
+            uint32_t nGroupSweeps { 0 };
+            do {
+                maxDelta = sweep(ranges, nThreads);
+                ++result.mNSweeps;
+                for(const auto& [begin, end]: ranges) result.mNEvaluations += (end - begin) * mNCounterLevels;
+            } while(maxDelta > tolerance && ++nGroupSweeps < kMaxGroupSweeps);
+            result.mConverged = result.mConverged && maxDelta <= tolerance;
+            result.mMaxDelta = std::max(result.mMaxDelta, maxDelta);
+        }
+    }
+
+    result.mSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+double Solver::sweep(const std::vector<std::pair<uint64_t, uint64_t>>& ranges, unsigned nThreads) {
+    std::vector<uint64_t> nRangeChunks {};
+    uint64_t nChunks { 0 };
+    for(const auto& [begin, end]: ranges) {
+        nRangeChunks.push_back((end - begin + kChunkSize - 1) / kChunkSize);
+        nChunks += nRangeChunks.back();
+    }
+
+    // without counters, the single level of each position is the level at
+    // which neither player holds any
+    const uint8_t nLevels { static_cast<uint8_t>(tracksCounters()? kTotalCounters / mCounterStep + 1u: 1u) };
+    std::atomic<uint64_t> nextChunk { 0 };
+    std::vector<double> maxDeltas(std::max(nThreads, 1u), 0.0);
+    const auto evaluateChunks = [&](unsigned thread) {
+        for(uint64_t chunk { nextChunk++ }; chunk < nChunks; chunk = nextChunk++) {
+            std::size_t range { 0 };
+            uint64_t rangeChunk { chunk };
+            while(rangeChunk >= nRangeChunks[range]) rangeChunk -= nRangeChunks[range++];
+
+            const uint64_t begin { ranges[range].first + rangeChunk * kChunkSize };
+            const uint64_t end { std::min(begin + kChunkSize, ranges[range].second) };
+            for(uint64_t index { begin }; index < end; ++index) {
+                const EndgameIndex::Slots slots { mIndex.unrank(index) };
+                const EndgameIndex::Slots mirrorSlots { slots[1], slots[0] };
+                const uint64_t mirrorIndex { mIndex.rank(mirrorSlots) };
+                if(mirrorIndex < index) continue;
+
+                // a position allows the same moves at every level of
+                // counters, and only their values differ
+                const TurnMoves turnMoves { getTurnMoves(slots) };
+                const TurnMoves mirrorTurnMoves { mirrorIndex == index? turnMoves: getTurnMoves(mirrorSlots) };
+                for(uint8_t ownLevel { 0 }; ownLevel < nLevels; ++ownLevel) {
+                    for(uint8_t otherLevel { 0 }; ownLevel + otherLevel < nLevels; ++otherLevel) {
+                        const uint64_t entry { index * mNCounterLevels + getCounterLevel(mCounterStep, ownLevel, otherLevel) };
+                        const uint64_t mirrorEntry { mirrorIndex * mNCounterLevels + getCounterLevel(mCounterStep, otherLevel, ownLevel) };
+                        if(mirrorEntry < entry) continue;
+
+                        const uint8_t ownCounters { static_cast<uint8_t>(ownLevel * mCounterStep) };
+                        const uint8_t otherCounters { static_cast<uint8_t>(otherLevel * mCounterStep) };
+                        const TurnOutcomes turnOutcomes { getTurnOutcomes(turnMoves, ownCounters, otherCounters) };
+                        const TurnOutcomes mirrorTurnOutcomes {
+                            mirrorEntry == entry? turnOutcomes: getTurnOutcomes(mirrorTurnMoves, otherCounters, ownCounters)
+                        };
+                        const auto [value, mirrorValue] = solvePair(turnOutcomes, mirrorTurnOutcomes, getTableValue(entry));
+                        for(const auto& [updatedEntry, updatedValue]: { std::pair { entry, value }, std::pair { mirrorEntry, mirrorValue } }) {
+                            const float previousValue { mValues[updatedEntry].exchange(static_cast<float>(updatedValue), std::memory_order_relaxed) };
+                            maxDeltas[thread] = std::max(maxDeltas[thread], std::abs(static_cast<double>(static_cast<float>(updatedValue)) - previousValue));
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads {};
+    for(unsigned thread { 1 }; thread < maxDeltas.size(); ++thread) {
+        threads.emplace_back(evaluateChunks, thread);
+    }
+    evaluateChunks(0);
+    for(std::thread& thread: threads) {
+        thread.join();
+    }
+
+    return *std::max_element(maxDeltas.begin(), maxDeltas.end());
+}
+
+double Solver::TurnOutcomes::getValue(double passedTurnValue) const {
+    double value { 0.0 };
+    for(std::size_t face { 0 }; face < mProbabilities.size(); ++face) {
+        value += mProbabilities[face] * std::max(
+            mRollAgainValues[face] + mPassProbabilities[face] * passedTurnValue, mMoveValues[face]
+        );
+    }
+    return value;
+}
+
+double Solver::TurnOutcomes::getSlope(double passedTurnValue) const {
+    double slope { 0.0 };
+    for(std::size_t face { 0 }; face < mProbabilities.size(); ++face) {
+        if(mRollAgainValues[face] + mPassProbabilities[face] * passedTurnValue > mMoveValues[face]) {
+            slope += mProbabilities[face] * mPassProbabilities[face];
+        }
+    }
+    return slope;
+}
+
+std::pair<double, double> Solver::solvePair(const TurnOutcomes& turnOutcomes, const TurnOutcomes& mirrorTurnOutcomes, double value) {
+    // each value is a piecewise linear function of the other, and so Newton's
+    // method finds where they agree within a few steps, finishing with a step
+    // of plain iteration
+    const auto getMirrorValue = [&](double ownValue) { return mirrorTurnOutcomes.getValue(1.0 - ownValue); };
+    for(uint8_t step { 0 }; step < kMaxPairSteps; ++step) {
+        const double mirrorValue { getMirrorValue(value) };
+        const double residual { turnOutcomes.getValue(1.0 - mirrorValue) - value };
+        const double slope { turnOutcomes.getSlope(1.0 - mirrorValue) * mirrorTurnOutcomes.getSlope(1.0 - value) };
+        if(slope >= 1.0) break;
+        const double nextValue { std::clamp(value + residual / (1.0 - slope), 0.0, 1.0) };
+        if(std::abs(nextValue - value) < kPairTolerance) break;
+        value = nextValue;
+    }
+    value = turnOutcomes.getValue(1.0 - getMirrorValue(value));
+    return { value, getMirrorValue(value) };
+}
+
+Solver::TurnMoves Solver::getTurnMoves(const EndgameIndex::Slots& slots) const {
+    TurnMoves turnMoves {};
+    for(std::size_t face { 0 }; face < mPlayOutcomes.size(); ++face) {
+        const PrimaryOutcome& primaryOutcome { mPlayOutcomes[face] };
+        turnMoves.mPrimaryMoves[face] = getMoves(slots, primaryOutcome.mOutcome.mScore);
+        for(std::size_t secondaryFace { 0 }; secondaryFace < primaryOutcome.mSecondaryOutcomes.size(); ++secondaryFace) {
+            turnMoves.mSecondaryMoves[face][secondaryFace] = getMoves(slots, primaryOutcome.mSecondaryOutcomes[secondaryFace].mScore);
+        }
+    }
+    return turnMoves;
+}
+
+Solver::TurnOutcomes Solver::getTurnOutcomes(const TurnMoves& turnMoves, uint8_t ownCounters, uint8_t otherCounters) const {
+    TurnOutcomes turnOutcomes {};
+    for(std::size_t face { 0 }; face < mPlayOutcomes.size(); ++face) {
+        const PrimaryOutcome& primaryOutcome { mPlayOutcomes[face] };
+        turnOutcomes.mProbabilities[face] = primaryOutcome.mOutcome.mProbability;
+        turnOutcomes.mMoveValues[face] = getBestMoveValue(turnMoves.mPrimaryMoves[face], ownCounters, otherCounters);
+
+        // a turn ends without a move only once the secondary die has been
+        // rolled
+        for(std::size_t secondaryFace { 0 }; secondaryFace < primaryOutcome.mSecondaryOutcomes.size(); ++secondaryFace) {
+            const double probability { primaryOutcome.mSecondaryOutcomes[secondaryFace].mProbability };
+            const double moveValue { getBestMoveValue(turnMoves.mSecondaryMoves[face][secondaryFace], ownCounters, otherCounters) };
+            if(moveValue == kNoMove) {
+                turnOutcomes.mPassProbabilities[face] += probability;
+            } else {
+                turnOutcomes.mRollAgainValues[face] += probability * moveValue;
+            }
+        }
+    }
+    return turnOutcomes;
+}
+
+double Solver::getBestMoveValue(const SolverMoveList& moves, uint8_t ownCounters, uint8_t otherCounters) const {
+    const uint8_t poolCounters { static_cast<uint8_t>(kTotalCounters - ownCounters - otherCounters) };
+    double bestValue { kNoMove };
+    for(uint8_t move { 0 }; move < moves.mSize; ++move) {
+        const SolverMove& solverMove { moves.mMoves[move] };
+
+        // the winner takes the pool, leaving the loser only their own counters
+        if(solverMove.mFlags & MoveResultData::ENDS_GAME) {
+            bestValue = std::max(bestValue, mWinWeight + (1.0 - mWinWeight) * (kTotalCounters - otherCounters) / kTotalCounters);
+            continue;
+        }
+
+        // counters change hands as GameOfUrModel::makeMoveResult() describes
+        uint8_t nextCounters { ownCounters };
+        if(solverMove.mFlags & MoveResultData::LANDS_ON_ROSETTE) {
+            nextCounters += std::min(solverMove.mCost, poolCounters);
+        } else if(
+            (solverMove.mFlags & MoveResultData::PASSES_ROSETTE)
+            && !(solverMove.mFlags & MoveResultData::COMPLETES_ROUTE)
+        ) {
+            nextCounters -= std::min(solverMove.mCost, ownCounters);
+        }
+        bestValue = std::max(bestValue, 1.0 - getPositionValue(solverMove.mNextPosition, otherCounters, nextCounters));
+    }
+    return bestValue;
+}
+
+Solver::SolverMoveList Solver::getMoves(const EndgameIndex::Slots& slots, uint8_t score) const {
+    SolverMoveList moves {};
+    if(score == 0) return moves;
+
+    // route positions on the battlefield name the same house for both roles,
+    // and so the black route serves for the player to move, whatever its role
+    const RouteTable& route { kRouteTables[RoleID::BLACK] };
+    const std::array<uint8_t, PieceTypeID::TOTAL>& ownPieces { slots[0] };
+    const std::array<uint8_t, PieceTypeID::TOTAL>& otherPieces { slots[1] };
+
+    // houses the player may not move to, as Board::getDestinationMask()
+    // describes: those holding their own pieces, and battlefield rosettes
+    // sheltering an opponent's piece
+    uint32_t blockedPositions { 0 };
+    for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+        const uint8_t ownSlot { ownPieces[type] };
+        if(ownSlot != EndgameIndex::kUnlaunchedSlot && ownSlot != EndgameIndex::kFinishedSlot) {
+            blockedPositions |= 1u << (ownSlot - 1u);
+        }
+        const uint8_t otherSlot { otherPieces[type] };
+        if(
+            otherSlot != EndgameIndex::kUnlaunchedSlot && otherSlot != EndgameIndex::kFinishedSlot
+            && otherSlot > kUrRuleset.getRegionLength() && RouteTable::isRosettePosition(otherSlot - 1u)
+        ) {
+            blockedPositions |= 1u << (otherSlot - 1u);
+        }
+    }
+
+    const uint8_t ownPiecesLeft { EndgameIndex::countPiecesLeft(ownPieces) };
+    for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+        const uint8_t slot { ownPieces[type] };
+        uint32_t destinations { 0 };
+        uint8_t routeFlags { 0 };
+        if(slot == EndgameIndex::kUnlaunchedSlot) {
+            if(score == kGamePieceTypes[type].mLaunchRoll) destinations = route.getLaunchPositions(static_cast<PieceTypeID>(type));
+
+        } else if(slot != EndgameIndex::kFinishedSlot) {
+            const RouteTable::Step& step { route.getStep(slot - 1u, score) };
+            if(step.mFlags & RouteTable::Step::IS_POSSIBLE) destinations = 1u << step.mDestination;
+            routeFlags = step.mFlags & RouteTable::Step::PASSES_ROSETTE;
+        }
+        destinations &= ~blockedPositions;
+
+        for(; destinations; destinations &= destinations - 1u) {
+            const uint8_t destination { static_cast<uint8_t>(std::countr_zero(destinations)) };
+            const bool completesRoute { destination == RouteTable::kRouteEnd };
+            SolverMove& move { moves.mMoves[moves.mSize++] };
+            move.mCost = kGamePieceTypes[type].mCost;
+            move.mFlags = (
+                MoveResultData::IS_POSSIBLE | routeFlags
+                | (RouteTable::isRosettePosition(destination)? MoveResultData::LANDS_ON_ROSETTE: 0)
+                | (completesRoute? MoveResultData::COMPLETES_ROUTE: 0)
+                | (completesRoute && ownPiecesLeft == 1? MoveResultData::ENDS_GAME: 0)
+            );
+            if(move.mFlags & MoveResultData::ENDS_GAME) continue;
+
+            // the opponent rolls next, with any of their pieces the move lands
+            // on sent home
+            EndgameIndex::Slots nextSlots { otherPieces, ownPieces };
+            nextSlots[1][type] = completesRoute? EndgameIndex::kFinishedSlot: destination + 1u;
+            if(destination >= kUrRuleset.getRegionLength() && !completesRoute) {
+                for(uint8_t& otherSlot: nextSlots[0]) {
+                    if(otherSlot == destination + 1u) otherSlot = EndgameIndex::kUnlaunchedSlot;
+                }
+            }
+            move.mNextPosition = mIndex.rank(nextSlots);
+        }
+    }
+    return moves;
+}
@@ -0,0 +1,577 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/solver.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains an offline solver computing the exact value, to the player about to roll, of every position of an endgame, whether in games won or in counters held at the end.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPSOLVER_H
+#define ZOAPPSOLVER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "endgame_index.hpp"
+#include "move_list.hpp"
+#include "position_index.hpp"
+#include "ruleset.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The statistics gathered by a single run of Solver::solve().
+ * 
+ */
+struct SolverResult {
+    /**
+     * @brief The number of values in the table solved, one for each position and level of counters.
+     * 
+     */
+    uint64_t mNPositions;
+
+    /**
+     * @brief The number of sweeps made over the table, across every group of positions.
+     * 
+     */
+    uint32_t mNSweeps;
+
+    /**
+     * @brief The number of times a value was computed, across every sweep.
+     * 
+     */
+    uint64_t mNEvaluations;
+
+    /**
+     * @brief The largest change made to any value by the last sweep of any group, which is below the tolerance asked for if the run converged.
+     * 
+     */
+    double mMaxDelta;
+
+    /**
+     * @brief Whether every group settled within the tolerance before running out of sweeps.
+     * 
+     */
+    bool mConverged;
+
+    /**
+     * @brief The number of bytes held by the table and its index.
+     * 
+     */
+    std::size_t mMemoryBytes;
+
+    /**
+     * @brief The time taken by the run, in seconds.
+     * 
+     */
+    double mSeconds;
+
+    /**
+     * @brief Gets the rate at which values were computed.
+     * 
+     * @return double The number of values computed per second.
+     */
+    double getPositionsPerSecond() const { return mSeconds > 0.0? mNEvaluations / mSeconds: 0.0; }
+};
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief Computes, for every position of an endgame, the value of the game to the player about to roll when both players play perfectly.
+ * 
+ * The value of a game is a blend of winning it and of the counters held at its end: getWinWeight() for a win, and the rest of 1 in proportion to the player's share of every counter in play.  With a win weight of 1 the value is the probability of winning, and with a win weight of 0 it is the expected number of counters held at the end, over the total.  Either way the values of both players sum to 1, as the winner takes whatever remains in the common pool.
+ * 
+ * The value of a position follows from the dice of the play phase: the primary die is rolled, after which the player either makes one of the moves it allows or rolls the secondary die, and must then make one of the moves the new score allows, if any.  Since captured pieces return to their owner's hand, positions may recur, and values are found by value iteration in place of a single backward pass.
+ * 
+ * Unless the win weight is 1, counters change hands as in GameOfUrModel, and each position holds a value for every split of counters between the players, every getCounterStep() counters.  A split between those levels takes its value by interpolating between the three nearest levels, which is exact for a step of 1.  Each solver holds a single table, and so tables for different objectives are solved, and kept, separately.
+ * 
+ * Pieces that complete their route never return, so the table is solved a group at a time, in order of the number of pieces left to both players.  A group and its mirror, in which the players' piece counts are exchanged, depend only on each other and on groups already solved, and are swept together until no value changes by more than the tolerance.  A turn ending without a move leads from a position straight to its mirror, which happens often while pieces wait on their launch rolls, and so each position is updated together with its mirror, solving for the pair of values that agree with each other outright.  Each sweep is shared between threads in chunks, and values are updated in place, so that later positions of a sweep see the values computed earlier in it.
+ * 
+ * A piece carries its type back home when it is captured, and so no two pieces are interchangeable while they are in play.  The full game has some 4.4e11 positions at the start of a turn, and so only endgames are solved here, with getMaxPiecesLeft() bounding the pieces left to each player.  Without counters, the table takes 27 MB up to 2 pieces left, 5.3 GB up to 3, and 226 GB up to 4.  Tracking counters multiplies this by getNCounterLevels(), which is 1326 for a step of 1, 66 for a step of 5, and 21 for a step of 10.
+ * 
+ */
+class Solver {
+public:
+    /**
+     * @brief The largest number of pieces left to each player solved for, unless another is asked for.
+     * 
+     */
+    static constexpr uint8_t kDefaultMaxPiecesLeft { 2 };
+
+    /**
+     * @brief The largest change in any value a sweep may make before its group is considered solved, unless another is asked for.
+     * 
+     */
+    static constexpr double kDefaultTolerance { 1e-6 };
+
+    /**
+     * @brief The smallest tolerance a run settles within, values being stored as floats, whose rounding alone changes a value near 1 by about this much.
+     * 
+     */
+    static constexpr double kMinTolerance { std::numeric_limits<float>::epsilon() };
+
+    /**
+     * @brief The most sweeps made over any one group before it is given up on as not converging.
+     * 
+     */
+    static constexpr uint32_t kMaxGroupSweeps { 1000 };
+
+    /**
+     * @brief The number of consecutive positions a thread evaluates between looking for more work.
+     * 
+     */
+    static constexpr uint64_t kChunkSize { 4096 };
+
+    /**
+     * @brief The number of counters in play, between both players and the common pool.
+     * 
+     */
+    static constexpr uint8_t kTotalCounters { kUrRuleset.getTotalCounters() };
+
+    /**
+     * @brief Creates an unsolved table for every position with at most some number of pieces left to each player.
+     * 
+     * @param maxPiecesLeft The largest number of pieces left to either player, between 1 and PieceTypeID::TOTAL.
+     * @param winWeight The share of a game's value given to winning it, between 0 and 1, with the rest given to the counters held at its end.
+     * @param counterStep The number of counters between the levels tracked for each player, which must divide kTotalCounters.  Ignored when the win weight is 1.
+     */
+    explicit Solver(uint8_t maxPiecesLeft=kDefaultMaxPiecesLeft, double winWeight=1.0, uint8_t counterStep=1);
+
+    /**
+     * @brief Gets the index positions are looked up in.
+     * 
+     * @return const EndgameIndex& The index of the table.
+     */
+    const EndgameIndex& getIndex() const { return mIndex; }
+
+    /**
+     * @brief Gets the largest number of pieces left to either player in a solved position.
+     * 
+     * @return uint8_t The largest number of pieces left.
+     */
+    uint8_t getMaxPiecesLeft() const { return mIndex.getMaxPiecesLeft(); }
+
+    /**
+     * @brief Gets the share of a game's value given to winning it.
+     * 
+     * @return double The win weight, between 0 and 1.
+     */
+    double getWinWeight() const { return mWinWeight; }
+
+    /**
+     * @brief Tests whether the values of this table depend on the counters held by the players.
+     * 
+     * @retval true Values are held for every level of counters.
+     * @retval false Only winning matters, and each position holds a single value.
+     */
+    bool tracksCounters() const { return mWinWeight < 1.0; }
+
+    /**
+     * @brief Gets the number of counters between the levels tracked for each player.
+     * 
+     * @return uint8_t The counter step, or kTotalCounters when counters aren't tracked.
+     */
+    uint8_t getCounterStep() const { return mCounterStep; }
+
+    /**
+     * @brief Gets the number of splits of counters between the players each position holds a value for.
+     * 
+     * @return uint32_t The number of counter levels of each position.
+     */
+    uint32_t getNCounterLevels() const { return mNCounterLevels; }
+
+    /**
+     * @brief Gets the number of values in the table.
+     * 
+     * @return uint64_t The number of positions times the number of counter levels.
+     */
+    uint64_t getTableSize() const { return mValues.size(); }
+
+    /**
+     * @brief Gets the number of bytes held by the table and its index.
+     * 
+     * @return std::size_t The memory used by this solver.
+     */
+    std::size_t getMemoryBytes() const { return mValues.size() * sizeof(std::atomic<float>) + mIndex.getMemoryBytes(); }
+
+    /**
+     * @brief Solves every position of the table.
+     * 
+     * @param nThreads The number of threads each sweep is spread across.
+     * @param tolerance The largest change in any value a sweep may make before its group is considered solved, raised to kMinTolerance if below it, since float values can't settle any closer.
+     * @return SolverResult Statistics describing the run, including whether every group converged within kMaxGroupSweeps sweeps.
+     */
+    SolverResult solve(unsigned nThreads=std::thread::hardware_concurrency(), double tolerance=kDefaultTolerance);
+
+    /**
+     * @brief Tests whether a position lies within the table.
+     * 
+     * @param position The position, whose turn phase is ignored.
+     * @retval true Both players have between 1 and getMaxPiecesLeft() pieces left.
+     * @retval false The position isn't covered by this table.
+     */
+    bool covers(const GamePosition& position) const { return mIndex.contains(EndgameIndex::getSlots(position)); }
+
+    /**
+     * @brief Gets the value of a position to the player whose turn it is, from the start of their turn.
+     * 
+     * @param position A position covered by this table, whose turn phase is ignored.
+     * @param ownCounters The counters held by the player whose turn it is.
+     * @param otherCounters The counters held by their opponent.
+     * @return double The value of the game to the player.
+     */
+    double getValue(const GamePosition& position, uint8_t ownCounters, uint8_t otherCounters) const {
+        return getPositionValue(mIndex.rank(EndgameIndex::getSlots(position)), ownCounters, otherCounters);
+    }
+
+    /**
+     * @brief Gets the probability that the player whose turn it is wins, from the start of their turn, for a table that doesn't track counters.
+     * 
+     * @param position A position covered by this table, whose turn phase is ignored.
+     * @return double The player's probability of winning.
+     */
+    double getWinProbability(const GamePosition& position) const;
+
+    /**
+     * @brief Gets the number of counters the player whose turn it is can expect to hold at the end of the game, for a table with a win weight of 0.
+     * 
+     * @param position A position covered by this table, whose turn phase is ignored.
+     * @param ownCounters The counters held by the player whose turn it is.
+     * @param otherCounters The counters held by their opponent.
+     * @return double The player's expected final counters.
+     */
+    double getExpectedCounters(const GamePosition& position, uint8_t ownCounters, uint8_t otherCounters) const;
+
+    /**
+     * @brief Gets a single value of the table.
+     * 
+     * @param entry The number of the value, the index of its position times getNCounterLevels() plus its counter level.
+     * @return float The value of the game to the player about to roll.
+     */
+    float getTableValue(uint64_t entry) const { return mValues[entry].load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of a split of counters among the levels of a position.
+     * 
+     * @param counterStep The number of counters between levels.
+     * @param ownLevel The counters held by the player about to roll, in steps.
+     * @param otherLevel The counters held by their opponent, in steps.
+     * @return uint32_t The counter level, less than the number of levels of each position.
+     */
+    static uint32_t getCounterLevel(uint8_t counterStep, uint8_t ownLevel, uint8_t otherLevel) {
+        const uint32_t nLevels { static_cast<uint32_t>(kTotalCounters / counterStep) + 1u };
+        return ownLevel * nLevels - ownLevel * (ownLevel - 1u) / 2u + otherLevel;
+    }
+
+    /**
+     * @brief Gets the value of any split of counters from the values held for the levels of a position.
+     * 
+     * A split between levels lies in a triangle of three levels, whose values are weighted by how near the split lies to each.  Levels given no weight are never looked up.
+     * 
+     * @tparam TGetLevelValue A callable taking a counter level and returning the value held for it.
+     * @param counterStep The number of counters between levels.
+     * @param ownCounters The counters held by the player about to roll.
+     * @param otherCounters The counters held by their opponent.
+     * @param getLevelValue Looks up the value of a counter level of the position.
+     * @return double The value of the split.
+     */
+    template <typename TGetLevelValue>
+    static double interpolateCounterLevels(uint8_t counterStep, uint8_t ownCounters, uint8_t otherCounters, TGetLevelValue&& getLevelValue) {
+        assert(ownCounters + otherCounters <= kTotalCounters && "The players can't hold more counters than there are");
+        const uint8_t ownLevel { static_cast<uint8_t>(ownCounters / counterStep) };
+        const uint8_t otherLevel { static_cast<uint8_t>(otherCounters / counterStep) };
+        const uint8_t ownRemainder { static_cast<uint8_t>(ownCounters % counterStep) };
+        const uint8_t otherRemainder { static_cast<uint8_t>(otherCounters % counterStep) };
+        if(ownRemainder + otherRemainder <= counterStep) {
+            double value { (counterStep - ownRemainder - otherRemainder) * static_cast<double>(getLevelValue(getCounterLevel(counterStep, ownLevel, otherLevel))) };
+            if(ownRemainder) value += ownRemainder * static_cast<double>(getLevelValue(getCounterLevel(counterStep, ownLevel + 1u, otherLevel)));
+            if(otherRemainder) value += otherRemainder * static_cast<double>(getLevelValue(getCounterLevel(counterStep, ownLevel, otherLevel + 1u)));
+            return value / counterStep;
+        }
+        return (
+            (ownRemainder + otherRemainder - counterStep) * static_cast<double>(getLevelValue(getCounterLevel(counterStep, ownLevel + 1u, otherLevel + 1u)))
+            + (counterStep - otherRemainder) * static_cast<double>(getLevelValue(getCounterLevel(counterStep, ownLevel + 1u, otherLevel)))
+            + (counterStep - ownRemainder) * static_cast<double>(getLevelValue(getCounterLevel(counterStep, ownLevel, otherLevel + 1u)))
+        ) / counterStep;
+    }
+
+private:
+    /**
+     * @brief A single outcome of a roll of one of the dice during the play phase.
+     * 
+     */
+    struct RollOutcome {
+        /**
+         * @brief The score the dice show after the roll.
+         * 
+         */
+        uint8_t mScore;
+
+        /**
+         * @brief The probability of the outcome.
+         * 
+         */
+        double mProbability;
+    };
+
+    /**
+     * @brief An outcome of the primary die, along with the outcomes of the secondary die that may follow it.
+     * 
+     */
+    struct PrimaryOutcome {
+        /**
+         * @brief The outcome of the primary die.
+         * 
+         */
+        RollOutcome mOutcome;
+
+        /**
+         * @brief The outcomes of the secondary die when it is rolled afterwards.
+         * 
+         */
+        std::array<RollOutcome, 2> mSecondaryOutcomes;
+    };
+
+    /**
+     * @brief A move, described by what it leads to.
+     * 
+     */
+    struct SolverMove {
+        /**
+         * @brief The index of the position after the move, seen from the side of the opponent, meaningless if the move ends the game.
+         * 
+         */
+        uint64_t mNextPosition;
+
+        /**
+         * @brief The cost of the piece moved.
+         * 
+         */
+        uint8_t mCost;
+
+        /**
+         * @brief The flags of the move, as for MoveResultData::mFlags.
+         * 
+         */
+        uint8_t mFlags;
+    };
+
+    /**
+     * @brief The moves a single score allows.
+     * 
+     */
+    struct SolverMoveList {
+        /**
+         * @brief Storage for the moves, of which only the first mSize are meaningful.
+         * 
+         */
+        std::array<SolverMove, MoveList::kCapacity> mMoves;
+
+        /**
+         * @brief The number of moves in the list.
+         * 
+         */
+        uint8_t mSize;
+    };
+
+    /**
+     * @brief The moves allowed by every outcome of the dice from a position.
+     * 
+     */
+    struct TurnMoves {
+        /**
+         * @brief The moves allowed by each face of the primary die.
+         * 
+         */
+        std::array<SolverMoveList, 4> mPrimaryMoves;
+
+        /**
+         * @brief The moves allowed by each face of the secondary die, after each face of the primary die.
+         * 
+         */
+        std::array<std::array<SolverMoveList, 2>, 4> mSecondaryMoves;
+    };
+
+    /**
+     * @brief The value of a turn to the player about to roll, as a function of the value to them of the turn passing without a move.
+     * 
+     */
+    struct TurnOutcomes {
+        /**
+         * @brief The probability of each face of the primary die.
+         * 
+         */
+        std::array<double, 4> mProbabilities;
+
+        /**
+         * @brief The value of the best move allowed by each face of the primary die, or kNoMove.
+         * 
+         */
+        std::array<double, 4> mMoveValues;
+
+        /**
+         * @brief The value of rolling the secondary die after each face of the primary die, counting only the outcomes allowing a move.
+         * 
+         */
+        std::array<double, 4> mRollAgainValues;
+
+        /**
+         * @brief The probability of the secondary die allowing no move after each face of the primary die, ending the turn.
+         * 
+         */
+        std::array<double, 4> mPassProbabilities;
+
+        /**
+         * @brief Gets the value of the turn.
+         * 
+         * @param passedTurnValue The value to the player of their turn ending without a move.
+         * @return double The value of the game to the player.
+         */
+        double getValue(double passedTurnValue) const;
+
+        /**
+         * @brief Gets the rate at which the value of the turn grows with the value of passing it.
+         * 
+         * @param passedTurnValue The value to the player of their turn ending without a move.
+         * @return double The derivative of getValue().
+         */
+        double getSlope(double passedTurnValue) const;
+    };
+
+    /**
+     * @brief The largest number of steps of Newton's method taken by solvePair().
+     * 
+     */
+    static constexpr uint8_t kMaxPairSteps { 8 };
+
+    /**
+     * @brief The step of Newton's method below which solvePair() stops.
+     * 
+     */
+    static constexpr double kPairTolerance { 1e-12 };
+
+    /**
+     * @brief The value of a score for which no move exists.
+     * 
+     */
+    static constexpr double kNoMove { -1.0 };
+
+    /**
+     * @brief Gets every outcome of the dice in the play phase, as listed by Dice::getOutcomes().
+     * 
+     * @return std::array<PrimaryOutcome, 4> The outcomes of each face of the primary die.
+     */
+    static std::array<PrimaryOutcome, 4> getPlayOutcomes();
+
+    /**
+     * @brief Gets the value of a position to the player about to roll, interpolating between counter levels where needed.
+     * 
+     * @param position The index of the position.
+     * @param ownCounters The counters held by the player about to roll.
+     * @param otherCounters The counters held by their opponent.
+     * @return double The value of the game to the player.
+     */
+    double getPositionValue(uint64_t position, uint8_t ownCounters, uint8_t otherCounters) const;
+
+    /**
+     * @brief Gets every move allowed by every outcome of the dice from a position.
+     * 
+     * @param slots The position, seen from the side of the player about to roll.
+     * @return TurnMoves The moves of the player's turn.
+     */
+    TurnMoves getTurnMoves(const EndgameIndex::Slots& slots) const;
+
+    /**
+     * @brief Gets the moves allowed by a score from a position.
+     * 
+     * @param slots The position, seen from the side of the player about to roll.
+     * @param score The score shown by the dice.
+     * @return SolverMoveList The moves allowed.
+     */
+    SolverMoveList getMoves(const EndgameIndex::Slots& slots, uint8_t score) const;
+
+    /**
+     * @brief Gets the values of the choices open to the player about to roll, for every face of the primary die.
+     * 
+     * @param turnMoves The moves of the player's turn.
+     * @param ownCounters The counters held by the player.
+     * @param otherCounters The counters held by their opponent.
+     * @return TurnOutcomes The values of the player's turn.
+     */
+    TurnOutcomes getTurnOutcomes(const TurnMoves& turnMoves, uint8_t ownCounters, uint8_t otherCounters) const;
+
+    /**
+     * @brief Gets the value of the best of some moves.
+     * 
+     * @param moves The moves to choose between.
+     * @param ownCounters The counters held by the player moving.
+     * @param otherCounters The counters held by their opponent.
+     * @return double The value of the game to the player after their best move, or kNoMove if there are no moves.
+     */
+    double getBestMoveValue(const SolverMoveList& moves, uint8_t ownCounters, uint8_t otherCounters) const;
+
+    /**
+     * @brief Finds the values of a position and its mirror that agree with each other, given the values of every move from either.
+     * 
+     * @param turnOutcomes The values of the turn from the position.
+     * @param mirrorTurnOutcomes The values of the turn from its mirror.
+     * @param value The current value of the position, from which the search starts.
+     * @return std::pair<double, double> The values of the position and of its mirror.
+     */
+    static std::pair<double, double> solvePair(const TurnOutcomes& turnOutcomes, const TurnOutcomes& mirrorTurnOutcomes, double value);
+
+    /**
+     * @brief Evaluates every position in some ranges of the table once, updating their values in place.
+     * 
+     * @param ranges The ranges of position indices evaluated.
+     * @param nThreads The number of threads the ranges are spread across.
+     * @return double The largest change made to any value.
+     */
+    double sweep(const std::vector<std::pair<uint64_t, uint64_t>>& ranges, unsigned nThreads);
+
+    /**
+     * @brief The index of the positions in the table.
+     * 
+     */
+    EndgameIndex mIndex;
+
+    /**
+     * @brief The share of a game's value given to winning it.
+     * 
+     */
+    double mWinWeight;
+
+    /**
+     * @brief The number of counters between the levels tracked for each player.
+     * 
+     */
+    uint8_t mCounterStep;
+
+    /**
+     * @brief The number of counter levels of each position.
+     * 
+     */
+    uint32_t mNCounterLevels;
+
+    /**
+     * @brief The value of the game to the player about to roll, for every position and counter level.
+     * 
+     */
+    std::vector<std::atomic<float>> mValues;
+
+    /**
+     * @brief Every outcome of the dice in the play phase.
+     * 
+     */
+    std::array<PrimaryOutcome, 4> mPlayOutcomes;
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include <cassert>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "tablebase.hpp"
+
+static_assert(std::is_trivially_copyable_v<Tablebase::Header> && sizeof(Tablebase::Header) % sizeof(uint64_t) == 0, "The header is stored as is, and keeps the block offsets after it aligned");
+
+int32_t Tablebase::predict(Predictor predictor, const uint16_t* values, uint32_t nValues) {
+    assert(predictor != STORED && "Stored values aren't predicted");
+    if(nValues == 0) return 0;
+    if(nValues == 1 || predictor == PREVIOUS) return values[nValues - 1];
+    return 2 * static_cast<int32_t>(values[nValues - 1]) - values[nValues - 2];
+}
+
+Tablebase::~Tablebase() {
+    close();
+}
+
+bool Tablebase::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    const HANDLE file { CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if(file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileBytes {};
+    const HANDLE mapping { GetFileSizeEx(file, &fileBytes) && fileBytes.QuadPart > 0? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr): nullptr };
+    CloseHandle(file);
+    if(mapping == nullptr) return false;
+    // the view keeps the mapping alive once its handle is closed
+    const void* view { MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) };
+    CloseHandle(mapping);
+    if(view == nullptr) return false;
+    mFile = static_cast<const uint8_t*>(view);
+    mFileBytes = static_cast<std::size_t>(fileBytes.QuadPart);
+#else
+    const int file { ::open(path.c_str(), O_RDONLY) };
+    if(file < 0) return false;
+    struct stat fileStatus {};
+    void* view { MAP_FAILED };
+    if(fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0) {
+        view = mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    // the mapping keeps the file alive once its descriptor is closed
+    ::close(file);
+    if(view == MAP_FAILED) return false;
+    mFile = static_cast<const uint8_t*>(view);
+    mFileBytes = static_cast<std::size_t>(fileStatus.st_size);
+#endif
+
+    // only the header and the last block offset are read; the offsets of
+    // every other block are checked by the lookups that use them
+    if(mFileBytes < sizeof(Header)) {
+        close();
+        return false;
+    }
+    const Header& header { getHeader() };
+    const bool tracksCounters { header.mWinWeight < 1.0 };
+    const uint32_t nLevels { tracksCounters && header.mCounterStep > 0? Solver::kTotalCounters / header.mCounterStep + 1u: 1u };
+    if(
+        header.mMagic != kMagic || header.mFormatVersion != kFormatVersion || header.mByteOrderMark != kByteOrderMark
+        || !(header.mWinWeight >= 0.0 && header.mWinWeight <= 1.0)
+        || header.mMaxPiecesLeft < 1 || header.mMaxPiecesLeft > PieceTypeID::TOTAL
+        || (tracksCounters && (header.mCounterStep == 0 || Solver::kTotalCounters % header.mCounterStep != 0))
+        || header.mNCounterLevels != nLevels * (nLevels + 1u) / 2u
+        || header.mBlockSize != kBlockSize
+        || (header.mLayout != RAW && header.mLayout != BLOCKS)
+    ) {
+        close();
+        return false;
+    }
+
+    mIndex.emplace(header.mMaxPiecesLeft);
+    const uint64_t nBlocks { (header.mTableSize + kBlockSize - 1) / kBlockSize };
+    const uint64_t nOffsets { header.mLayout == BLOCKS? nBlocks + 1: 0 };
+    mBlockOffsets = header.mLayout == BLOCKS? reinterpret_cast<const uint64_t*>(mFile + sizeof(Header)): nullptr;
+    mBlocks = mFile + sizeof(Header) + nOffsets * sizeof(uint64_t);
+    if(
+        header.mTableSize != mIndex->getSize() * header.mNCounterLevels
+        || mFileBytes != sizeof(Header) + nOffsets * sizeof(uint64_t) + header.mDataBytes
+        || (header.mLayout == RAW && header.mDataBytes != 2 * header.mTableSize)
+        || (header.mLayout == BLOCKS && mBlockOffsets[nBlocks] != header.mDataBytes)
+    ) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Tablebase::close() {
+    if(mFile != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(mFile);
+#else
+        munmap(const_cast<uint8_t*>(mFile), mFileBytes);
+#endif
+    }
+    mFile = nullptr;
+    mFileBytes = 0;
+    mBlockOffsets = nullptr;
+    mBlocks = nullptr;
+    mIndex.reset();
+}
+
+std::optional<double> Tablebase::getValue(const GamePosition& position, uint8_t ownCounters, uint8_t otherCounters) const {
+    assert(covers(position) && "Only positions within the open table have a value");
+
+    const Header& header { getHeader() };
+    const uint64_t entry { mIndex->rank(EndgameIndex::getSlots(position)) * header.mNCounterLevels };
+    if(header.mWinWeight >= 1.0) return getTableValue(entry);
+
+    // a single damaged level leaves the whole split without a value
+    bool isIntact { true };
+    const double value { Solver::interpolateCounterLevels(
+        header.mCounterStep, ownCounters, otherCounters, [this, entry, &isIntact](uint32_t level) {
+            const std::optional<double> levelValue { getTableValue(entry + level) };
+            isIntact = isIntact && levelValue.has_value();
+            return levelValue.value_or(0.0);
+        }
+    ) };
+    if(!isIntact) return std::nullopt;
+    return value;
+}
+
+std::optional<double> Tablebase::getValue(const GameOfUrModel& model) const {
+    const PlayerID player { model.getCurrentPhase().mTurn };
+    const PlayerID opponent { player == PlayerID::PLAYER_A? PlayerID::PLAYER_B: PlayerID::PLAYER_A };
+    return getValue(model.getPosition(), model.getPlayerData(player).mCounters, model.getPlayerData(opponent).mCounters);
+}
+
+std::optional<double> Tablebase::getTableValue(uint64_t entry) const {
+    assert(entry < getHeader().mTableSize && "Entry must lie within the table");
+
+    if(mBlockOffsets == nullptr) {
+        const uint8_t* byte { mBlocks + 2 * entry };
+        return static_cast<double>(byte[0] | (byte[1] << 8)) / kQuantizedOne;
+    }
+
+    // the offsets of a block are only trusted once they lie in order within
+    // the block data, and decoding never reads past the end of the block
+    const uint64_t block { entry / kBlockSize };
+    const uint64_t blockBegin { mBlockOffsets[block] };
+    const uint64_t blockEnd { mBlockOffsets[block + 1] };
+    if(!(blockBegin < blockEnd && blockEnd <= getHeader().mDataBytes)) return std::nullopt;
+    const uint8_t* byte { mBlocks + blockBegin };
+    const uint8_t* const end { mBlocks + blockEnd };
+    const uint8_t predictor { *byte++ };
+    if(predictor >= Predictor::TOTAL) return std::nullopt;
+
+    const uint32_t nValues { static_cast<uint32_t>(entry % kBlockSize) + 1u };
+    if(predictor == STORED) {
+        if(static_cast<uint64_t>(end - byte) < 2 * nValues) return std::nullopt;
+        byte += 2 * (nValues - 1u);
+        return static_cast<double>(byte[0] | (byte[1] << 8)) / kQuantizedOne;
+    }
+
+    // a residual of a 16-bit value takes at most 17 bits once interleaved by
+    // sign, and so at most 3 bytes
+    constexpr uint8_t kMaxResidualShift { 14 };
+    std::array<uint16_t, kBlockSize> values;
+    for(uint32_t value { 0 }; value < nValues; ++value) {
+        uint32_t zigzag { 0 };
+        for(uint8_t shift { 0 };; shift += 7) {
+            if(byte == end || shift > kMaxResidualShift) return std::nullopt;
+            zigzag |= static_cast<uint32_t>(*byte & 0x7Fu) << shift;
+            if(!(*byte++ & 0x80u)) break;
+        }
+        const int32_t residual { (zigzag & 1u)? -static_cast<int32_t>((zigzag + 1u) >> 1): static_cast<int32_t>(zigzag >> 1) };
+        values[value] = static_cast<uint16_t>(predict(static_cast<Predictor>(predictor), values.data(), value) + residual);
+    }
+    return static_cast<double>(values[nValues - 1]) / kQuantizedOne;
+}
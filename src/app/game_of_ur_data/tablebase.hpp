@@ -0,0 +1,331 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/tablebase.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the on-disk format of a solved endgame table, and a reader mapping such a file into memory for lookups during play.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPTABLEBASE_H
+#define ZOAPPTABLEBASE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <optional>
+#include <string>
+
+#include "endgame_index.hpp"
+#include "model.hpp"
+#include "solver.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A read-only view of a table solved by Solver, stored in a file that is mapped into memory rather than read.
+ * 
+ * A tablebase file begins with a Header describing the table, including the objective it was solved for, followed by its values in one of two layouts.  Each value is quantized to 16 bits.  In the BLOCKS layout, the header is followed by the byte offset of every block of values, and then by the blocks themselves, each block of kBlockSize consecutive values being compressed on its own, by storing how far each value lies from a prediction made from the values before it, in as few bytes as that distance allows.  A block that doesn't shrink this way is stored as is.  Tables whose values can't be predicted from their neighbours, as those solved for winning alone mostly can't, would then take more than the values themselves once the offsets are counted, and are instead written in the RAW layout, as every value stored as is with nothing else.  A table thus never takes more than 2 bytes a value.
+ * 
+ * Opening a tablebase checks its header and sizes, and does nothing else: nothing is read into memory, and the pages of the file are brought in by the operating system as lookups first touch them.  A lookup decodes at most one block, and so costs the same no matter the size of the table, while the memory it takes scales with the positions a game actually visits.  Since blocks aren't checked when the file is opened, a lookup checks the offsets of the block it decodes, and never reads past the end of that block, so that a damaged file gives no value rather than reading outside the file.
+ * 
+ * Files are written in the byte order of the machine writing them, and are checked against the byte order of the machine reading them.
+ * 
+ */
+class Tablebase {
+public:
+    /**
+     * @brief The version of the layout of a tablebase file, bumped whenever the layout changes.
+     * 
+     */
+    static constexpr uint16_t kFormatVersion { 2 };
+
+    /**
+     * @brief The bytes every tablebase file begins with.
+     * 
+     */
+    static constexpr std::array<char, 4> kMagic { 'Z', 'U', 'T', 'B' };
+
+    /**
+     * @brief The number of values compressed together, and so the largest number of values decoded by a lookup.
+     * 
+     */
+    static constexpr uint32_t kBlockSize { 256 };
+
+    /**
+     * @brief The quantized value standing for a value of 1.
+     * 
+     */
+    static constexpr uint16_t kQuantizedOne { UINT16_MAX };
+
+    /**
+     * @brief The ways the values of a table may be laid out in a file.
+     * 
+     */
+    enum Layout: uint8_t {
+        RAW, //< Every value is stored as is, in 2 bytes, least significant first.
+        BLOCKS, //< Values are compressed in blocks of kBlockSize, found through a table of block offsets.
+    };
+
+    /**
+     * @brief The description of the table stored at the start of a tablebase file.
+     * 
+     */
+    struct Header {
+        /**
+         * @brief kMagic.
+         * 
+         */
+        std::array<char, 4> mMagic;
+
+        /**
+         * @brief kFormatVersion.
+         * 
+         */
+        uint16_t mFormatVersion;
+
+        /**
+         * @brief A known value in the byte order of the machine that wrote the file, kByteOrderMark.
+         * 
+         */
+        uint16_t mByteOrderMark;
+
+        /**
+         * @brief The share of a game's value given to winning it, as for Solver::getWinWeight().
+         * 
+         */
+        double mWinWeight;
+
+        /**
+         * @brief The largest number of pieces left to either player, as for Solver::getMaxPiecesLeft().
+         * 
+         */
+        uint8_t mMaxPiecesLeft;
+
+        /**
+         * @brief The number of counters between the levels held for each position, as for Solver::getCounterStep().
+         * 
+         */
+        uint8_t mCounterStep;
+
+        /**
+         * @brief The number of values compressed together, kBlockSize.
+         * 
+         */
+        uint16_t mBlockSize;
+
+        /**
+         * @brief The number of counter levels of each position, as for Solver::getNCounterLevels().
+         * 
+         */
+        uint32_t mNCounterLevels;
+
+        /**
+         * @brief The number of values in the table.
+         * 
+         */
+        uint64_t mTableSize;
+
+        /**
+         * @brief The number of bytes taken by the values, which end the file.
+         * 
+         */
+        uint64_t mDataBytes;
+
+        /**
+         * @brief The layout of the values.
+         * 
+         */
+        Layout mLayout;
+
+        /**
+         * @brief Unused, and written as zeros, keeping the size of the header a multiple of 8 bytes.
+         * 
+         */
+        std::array<uint8_t, 7> mReserved;
+    };
+
+    /**
+     * @brief The value Header::mByteOrderMark takes when read on a machine of the same byte order as the writer.
+     * 
+     */
+    static constexpr uint16_t kByteOrderMark { 0xFEFF };
+
+    /**
+     * @brief Writes the table of a solver to a tablebase file.
+     * 
+     * Defined in tablebase_writer.cpp, and so only available to the offline tools, the game being limited to reading files.
+     * 
+     * @param solver A solver whose table has been solved.
+     * @param path The path of the file written, which is replaced if it exists.
+     * @retval true The file was written in full.
+     * @retval false The file couldn't be written.
+     */
+    static bool write(const Solver& solver, const std::string& path);
+
+    /**
+     * @brief Creates a tablebase with no file open.
+     * 
+     */
+    Tablebase()=default;
+
+    /**
+     * @brief Unmaps the open file, if any.
+     * 
+     */
+    ~Tablebase();
+
+    Tablebase(const Tablebase& other)=delete;
+    Tablebase& operator=(const Tablebase& other)=delete;
+
+    /**
+     * @brief Maps a tablebase file into memory, closing any file already open.
+     * 
+     * @param path The path of the tablebase file.
+     * @retval true The file was mapped, and its header and sizes agree with this build.
+     * @retval false The file is missing, couldn't be mapped, or isn't a tablebase this build can read, and no file is open.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the open file, if any.
+     * 
+     */
+    void close();
+
+    /**
+     * @brief Tests whether a file is open.
+     * 
+     * @retval true Lookups may be made.
+     * @retval false No file is open.
+     */
+    bool isOpen() const { return mFile != nullptr; }
+
+    /**
+     * @brief Gets the description of the open file's table.
+     * 
+     * @return const Header& The header of the open file.
+     */
+    const Header& getHeader() const { return *reinterpret_cast<const Header*>(mFile); }
+
+    /**
+     * @brief Gets the share of a game's value given to winning it by the open table.
+     * 
+     * @return double The win weight, between 0 and 1.
+     */
+    double getWinWeight() const { return getHeader().mWinWeight; }
+
+    /**
+     * @brief Gets the largest number of pieces left to either player in a position of the open table.
+     * 
+     * @return uint8_t The largest number of pieces left.
+     */
+    uint8_t getMaxPiecesLeft() const { return getHeader().mMaxPiecesLeft; }
+
+    /**
+     * @brief Tests whether a position lies within the open table.
+     * 
+     * @param position The position, whose turn phase is ignored.
+     * @retval true A file is open, and both players have between 1 and getMaxPiecesLeft() pieces left.
+     * @retval false The position has no value here.
+     */
+    bool covers(const GamePosition& position) const { return isOpen() && mIndex->contains(EndgameIndex::getSlots(position)); }
+
+    /**
+     * @brief Gets the value of a position to the player whose turn it is, from the start of their turn.
+     * 
+     * @param position A position covered by the open table, whose turn phase is ignored.
+     * @param ownCounters The counters held by the player whose turn it is.
+     * @param otherCounters The counters held by their opponent.
+     * @return std::optional<double> The value of the game to the player, as Solver::getValue() would give it, or no value if the file is damaged where it is stored.
+     */
+    std::optional<double> getValue(const GamePosition& position, uint8_t ownCounters, uint8_t otherCounters) const;
+
+    /**
+     * @brief Gets the value of a game to the player whose turn it is, from the start of their turn.
+     * 
+     * @param model A game whose position is covered by the open table.
+     * @return std::optional<double> The value of the game to the player, counting the counters each player holds, or no value if the file is damaged where it is stored.
+     */
+    std::optional<double> getValue(const GameOfUrModel& model) const;
+
+    /**
+     * @brief Gets the number of bytes mapped, which is the most that lookups may bring into memory.
+     * 
+     * @return std::size_t The size of the open file.
+     */
+    std::size_t getFileBytes() const { return mFileBytes; }
+
+private:
+    /**
+     * @brief The ways the values of a block may be stored, named by the prediction each value is stored relative to, held in the first byte of the block.
+     * 
+     */
+    enum Predictor: uint8_t {
+        STORED, //< Every value is stored as is, in 2 bytes, least significant first.
+        PREVIOUS, //< Each value is predicted to equal the one before it.
+        LINEAR, //< Each value is predicted to continue the line through the two before it.
+        TOTAL, //< The number of predictors.
+    };
+
+    /**
+     * @brief Gets the prediction of a value of a block.
+     * 
+     * @param predictor The predictor of the block, other than STORED.
+     * @param values The values of the block decoded so far.
+     * @param nValues The number of values decoded so far.
+     * @return int32_t The predicted value.
+     */
+    static int32_t predict(Predictor predictor, const uint16_t* values, uint32_t nValues);
+
+    /**
+     * @brief Compresses some values into a block.
+     * 
+     * @param values The values of the block.
+     * @param nValues The number of values, at most kBlockSize.
+     * @param predictor The predictor used.
+     * @param block The buffer the block is appended to.
+     */
+    static void encodeBlock(const uint16_t* values, uint32_t nValues, Predictor predictor, std::string& block);
+
+    /**
+     * @brief Gets a single value of the open table.
+     * 
+     * @param entry The number of the value, as for Solver::getTableValue().
+     * @return std::optional<double> The value, no longer quantized, or no value if the block holding it is damaged.
+     */
+    std::optional<double> getTableValue(uint64_t entry) const;
+
+    /**
+     * @brief The bytes of the open file, or nullptr if none is open.
+     * 
+     */
+    const uint8_t* mFile { nullptr };
+
+    /**
+     * @brief The size of the open file.
+     * 
+     */
+    std::size_t mFileBytes { 0 };
+
+    /**
+     * @brief The offset of every block within the block data, followed by the size of the block data, or nullptr for a table in the RAW layout.
+     * 
+     */
+    const uint64_t* mBlockOffsets { nullptr };
+
+    /**
+     * @brief The start of the values, which is the first block for a table in the BLOCKS layout.
+     * 
+     */
+    const uint8_t* mBlocks { nullptr };
+
+    /**
+     * @brief The index of the positions of the open table.
+     * 
+     */
+    std::optional<EndgameIndex> mIndex {};
+};
+
+#endif
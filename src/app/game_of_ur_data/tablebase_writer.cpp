@@ -0,0 +1,87 @@
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "tablebase.hpp"
+
+void Tablebase::encodeBlock(const uint16_t* values, uint32_t nValues, Predictor predictor, std::string& block) {
+    block.push_back(static_cast<char>(predictor));
+    if(predictor == STORED) {
+        for(uint32_t value { 0 }; value < nValues; ++value) {
+            block.push_back(static_cast<char>(values[value] & 0xFFu));
+            block.push_back(static_cast<char>(values[value] >> 8));
+        }
+        return;
+    }
+
+    for(uint32_t value { 0 }; value < nValues; ++value) {
+        // distances from the prediction are interleaved by sign, so that
+        // small distances either way take few bytes
+        const int32_t residual { values[value] - predict(predictor, values, value) };
+        uint32_t zigzag { residual < 0? (static_cast<uint32_t>(-residual) << 1) - 1u: static_cast<uint32_t>(residual) << 1 };
+        for(; zigzag >= 0x80u; zigzag >>= 7) block.push_back(static_cast<char>(zigzag | 0x80u));
+        block.push_back(static_cast<char>(zigzag));
+    }
+}
+
+bool Tablebase::write(const Solver& solver, const std::string& path) {
+    const uint64_t tableSize { solver.getTableSize() };
+    const uint64_t nBlocks { (tableSize + kBlockSize - 1) / kBlockSize };
+
+    std::vector<uint64_t> blockOffsets {};
+    blockOffsets.reserve(nBlocks + 1);
+    std::string blocks {};
+    std::string raw {};
+    raw.reserve(2 * tableSize);
+    std::array<uint16_t, kBlockSize> values {};
+    std::array<std::string, Predictor::TOTAL> encodings {};
+    for(uint64_t begin { 0 }; begin < tableSize; begin += kBlockSize) {
+        const uint32_t nValues { static_cast<uint32_t>(std::min<uint64_t>(kBlockSize, tableSize - begin)) };
+        for(uint32_t value { 0 }; value < nValues; ++value) {
+            values[value] = static_cast<uint16_t>(std::lround(std::clamp(solver.getTableValue(begin + value), 0.f, 1.f) * kQuantizedOne));
+            raw.push_back(static_cast<char>(values[value] & 0xFFu));
+            raw.push_back(static_cast<char>(values[value] >> 8));
+        }
+
+        // whichever predictor suits the block best is kept
+        for(uint8_t predictor { 0 }; predictor < Predictor::TOTAL; ++predictor) {
+            encodings[predictor].clear();
+            encodeBlock(values.data(), nValues, static_cast<Predictor>(predictor), encodings[predictor]);
+        }
+        blockOffsets.push_back(blocks.size());
+        blocks += *std::min_element(
+            encodings.begin(), encodings.end(), [](const std::string& one, const std::string& other) { return one.size() < other.size(); }
+        );
+    }
+    blockOffsets.push_back(blocks.size());
+
+    // blocks only pay for their offsets when enough of them compress
+    const Layout layout { blockOffsets.size() * sizeof(uint64_t) + blocks.size() < raw.size()? BLOCKS: RAW };
+    if(layout == RAW) {
+        blockOffsets.clear();
+        blocks.swap(raw);
+    }
+
+    Header header {};
+    header.mMagic = kMagic;
+    header.mFormatVersion = kFormatVersion;
+    header.mByteOrderMark = kByteOrderMark;
+    header.mWinWeight = solver.getWinWeight();
+    header.mMaxPiecesLeft = solver.getMaxPiecesLeft();
+    header.mCounterStep = solver.getCounterStep();
+    header.mBlockSize = kBlockSize;
+    header.mNCounterLevels = solver.getNCounterLevels();
+    header.mTableSize = tableSize;
+    header.mDataBytes = blocks.size();
+    header.mLayout = layout;
+    header.mReserved = {};
+
+    std::ofstream fileStream { path, std::ios::binary | std::ios::trunc };
+    fileStream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    fileStream.write(reinterpret_cast<const char*>(blockOffsets.data()), blockOffsets.size() * sizeof(uint64_t));
+    fileStream.write(blocks.data(), blocks.size());
+    fileStream.close();
+    return !fileStream.fail();
+}
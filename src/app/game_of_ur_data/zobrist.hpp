@@ -0,0 +1,246 @@
+/**
+ * @ingroup UrGameDataModel
+ * @file game_of_ur_data/zobrist.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the table of random keys, generated at compile time, from which GameOfUrModel builds its position hash.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPZOBRIST_H
+#define ZOAPPZOBRIST_H
+
+#include <cstdint>
+#include <cassert>
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "role_id.hpp"
+#include "phase.hpp"
+#include "piece.hpp"
+#include "dice.hpp"
+#include "board.hpp"
+#include "ruleset.hpp"
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief A table of 64-bit keys, one for every value each part of a game's state may take, such that a game's hash is the XOR of the keys for its current values.
+ * 
+ * Since XOR is its own inverse, changing one part of the state updates the hash by XOR-ing out the key for its old value and XOR-ing in the key for its new one.
+ * 
+ * @see kZobristKeys
+ */
+class ZobristTable {
+public:
+    /**
+     * @brief The number of distinct places a piece may be in: unlaunched, on any one of the board's houses, or finished.
+     * 
+     */
+    static constexpr uint8_t kNPieceSlots { Board::kNHouses + 2 };
+
+    /**
+     * @brief The largest number of counters that can be held by a player or by the common pool.
+     * 
+     */
+    static constexpr uint8_t kMaxCounters { kUrRuleset.getTotalCounters() };
+
+    /**
+     * @brief Generates every key in the table from a fixed seed, so that hashes agree across runs and builds.
+     * 
+     */
+    constexpr ZobristTable();
+
+    /**
+     * @brief Gets the key for a piece belonging to a player being in some state at some location.
+     * 
+     * @param player The index of the player owning the piece.
+     * @param pieceType The type of the piece.
+     * @param state The state of the piece.
+     * @param location The location of the piece, considered only when it is on the board.
+     * @return uint64_t The key for this piece.
+     */
+    uint64_t getPieceKey(uint8_t player, PieceTypeID pieceType, Piece::State state, glm::u8vec2 location) const {
+        assert(player < mPieceKeys.size() && "There are only two players in a game");
+        uint8_t slot { 0 };
+        switch(state) {
+            case Piece::State::UNLAUNCHED: slot = 0; break;
+            case Piece::State::ON_BOARD: slot = 1 + Board::getHouseIndex(location); break;
+            case Piece::State::FINISHED: slot = kNPieceSlots - 1; break;
+        }
+        return mPieceKeys[player][pieceType][slot];
+    }
+
+    /**
+     * @brief Gets the key for the number of counters held by the common pool.
+     * 
+     * @param counters The number of counters in the common pool.
+     * @return uint64_t The key for this number of counters.
+     */
+    uint64_t getPoolCounterKey(uint8_t counters) const {
+        assert(counters <= kMaxCounters && "There are no more counters than this in a game");
+        return mPoolCounterKeys[counters];
+    }
+
+    /**
+     * @brief Gets the key for the number of counters held by a player.
+     * 
+     * @param player The index of the player.
+     * @param counters The number of counters held by the player.
+     * @return uint64_t The key for this number of counters.
+     */
+    uint64_t getPlayerCounterKey(uint8_t player, uint8_t counters) const {
+        assert(player < mPlayerCounterKeys.size() && counters <= kMaxCounters && "Invalid player or counter count");
+        return mPlayerCounterKeys[player][counters];
+    }
+
+    /**
+     * @brief Gets the key for the dice being in some state with some rolls showing.
+     * 
+     * @param state The state of the dice.
+     * @param primaryRoll The value shown by the primary die.
+     * @param secondaryRoll The value shown by the secondary die.
+     * @return uint64_t The key for these dice.
+     */
+    uint64_t getDiceKey(Dice::State state, uint8_t primaryRoll, bool secondaryRoll) const {
+        assert(primaryRoll <= 4 && "The primary die only has values up to 4");
+        return mDiceKeys[state][primaryRoll][secondaryRoll];
+    }
+
+    /**
+     * @brief Gets the key for the previous turn's dice roll.
+     * 
+     * @param previousRoll The result of the previous turn's dice roll.
+     * @return uint64_t The key for this roll.
+     */
+    uint64_t getPreviousRollKey(uint8_t previousRoll) const {
+        assert(previousRoll < mPreviousRollKeys.size() && "No roll can score more than 10");
+        return mPreviousRollKeys[previousRoll];
+    }
+
+    /**
+     * @brief Gets the key for the combination of the game's, the turn's, and the round's phases.
+     * 
+     * @param gamePhase The phase of the game.
+     * @param turnPhase The phase of the turn.
+     * @param roundPhase The phase of the round.
+     * @return uint64_t The key for these phases.
+     */
+    uint64_t getPhaseKey(GamePhase gamePhase, TurnPhase turnPhase, RoundPhase roundPhase) const {
+        return (
+            mGamePhaseKeys[static_cast<uint8_t>(gamePhase)]
+            ^ mTurnPhaseKeys[static_cast<uint8_t>(turnPhase)]
+            ^ mRoundPhaseKeys[static_cast<uint8_t>(roundPhase)]
+        );
+    }
+
+    /**
+     * @brief Gets the key for the player whose turn it is.
+     * 
+     * @param player The index of the current player.
+     * @return uint64_t The key for this player.
+     */
+    uint64_t getCurrentPlayerKey(uint8_t player) const { return mCurrentPlayerKeys[player]; }
+
+    /**
+     * @brief Gets the key for the role assigned to the first player, which also determines the role of the second.
+     * 
+     * @param role The role of the first player.
+     * @return uint64_t The key for this role.
+     */
+    uint64_t getRoleKey(RoleID role) const { return mRoleKeys[role]; }
+
+private:
+    /**
+     * @brief Keys for every piece, indexed by the owning player, the piece's type, and the slot it occupies.
+     * 
+     */
+    std::array<std::array<std::array<uint64_t, kNPieceSlots>, PieceTypeID::TOTAL>, 2> mPieceKeys {};
+
+    /**
+     * @brief Keys for every number of counters the common pool may hold.
+     * 
+     */
+    std::array<uint64_t, kMaxCounters + 1> mPoolCounterKeys {};
+
+    /**
+     * @brief Keys for every number of counters each player may hold.
+     * 
+     */
+    std::array<std::array<uint64_t, kMaxCounters + 1>, 2> mPlayerCounterKeys {};
+
+    /**
+     * @brief Keys for the dice, indexed by their state, the primary die's value, and the secondary die's value.
+     * 
+     */
+    std::array<std::array<std::array<uint64_t, 2>, 5>, 3> mDiceKeys {};
+
+    /**
+     * @brief Keys for every possible result of the previous turn's dice roll.
+     * 
+     */
+    std::array<uint64_t, 11> mPreviousRollKeys {};
+
+    /**
+     * @brief Keys for each GamePhase.
+     * 
+     */
+    std::array<uint64_t, 3> mGamePhaseKeys {};
+
+    /**
+     * @brief Keys for each TurnPhase.
+     * 
+     */
+    std::array<uint64_t, 3> mTurnPhaseKeys {};
+
+    /**
+     * @brief Keys for each RoundPhase.
+     * 
+     */
+    std::array<uint64_t, 2> mRoundPhaseKeys {};
+
+    /**
+     * @brief Keys for each player whose turn it may be.
+     * 
+     */
+    std::array<uint64_t, 2> mCurrentPlayerKeys {};
+
+    /**
+     * @brief Keys for each role the first player may have, indexed by RoleID.
+     * 
+     */
+    std::array<uint64_t, 3> mRoleKeys {};
+};
+
+constexpr ZobristTable::ZobristTable() {
+    // splitmix64, which produces well distributed keys from a simple counter
+    uint64_t state { 0x5552u };
+    const auto nextKey = [&state]() {
+        uint64_t key { state += 0x9E3779B97F4A7C15ull };
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+        return key ^ (key >> 31);
+    };
+
+    for(auto& playerKeys: mPieceKeys) for(auto& typeKeys: playerKeys) for(uint64_t& key: typeKeys) key = nextKey();
+    for(uint64_t& key: mPoolCounterKeys) key = nextKey();
+    for(auto& playerKeys: mPlayerCounterKeys) for(uint64_t& key: playerKeys) key = nextKey();
+    for(auto& stateKeys: mDiceKeys) for(auto& primaryKeys: stateKeys) for(uint64_t& key: primaryKeys) key = nextKey();
+    for(uint64_t& key: mPreviousRollKeys) key = nextKey();
+    for(uint64_t& key: mGamePhaseKeys) key = nextKey();
+    for(uint64_t& key: mTurnPhaseKeys) key = nextKey();
+    for(uint64_t& key: mRoundPhaseKeys) key = nextKey();
+    for(uint64_t& key: mCurrentPlayerKeys) key = nextKey();
+    for(uint64_t& key: mRoleKeys) key = nextKey();
+}
+
+/**
+ * @ingroup UrGameDataModel
+ * @brief The keys used to hash every GameOfUrModel.
+ * 
+ */
+inline constexpr ZobristTable kZobristKeys {};
+
+#endif
@@ -25,6 +25,30 @@ bool UrController::viewUpdatesComplete() const {
     return true;
 }
 
+void UrController::emitStateChanges(const StateDelta& stateDelta) {
+    // a player's data covers their role, counters, pieces and whether they won
+    const bool everyPlayerChanged { stateDelta.hasChanged(StateDelta::ROLES | StateDelta::WINNER) };
+    std::array<bool, 2> playerChanged { everyPlayerChanged, everyPlayerChanged };
+    bool scoreChanged { stateDelta.hasChanged(StateDelta::ROLES) || stateDelta.mCommonPoolCountersChange != 0 };
+    for(uint8_t player { PlayerID::PLAYER_A }; player <= PlayerID::PLAYER_B; ++player) {
+        if(stateDelta.mPlayerCountersChanges[player]) playerChanged[player] = true;
+    }
+    for(uint8_t change { 0 }; change < stateDelta.mNPieceChanges; ++change) {
+        const StateDelta::PieceChange& pieceChange { stateDelta.mPieceChanges[change] };
+        playerChanged[mModel.getPlayerData(pieceChange.mPiece.mOwner).mPlayer] = true;
+        if(
+            pieceChange.mFromState == Piece::State::FINISHED
+            || pieceChange.mToState == Piece::State::FINISHED
+        ) scoreChanged = true;
+    }
+
+    if(scoreChanged) { mSigScoreUpdated.emit(mModel.getScore()); }
+    for(uint8_t player { PlayerID::PLAYER_A }; player <= PlayerID::PLAYER_B; ++player) {
+        if(playerChanged[player]) { mSigPlayerUpdated.emit(mModel.getPlayerData(static_cast<PlayerID>(player))); }
+    }
+    if(stateDelta.hasChanged(StateDelta::DICE)) { mSigDiceUpdated.emit(mModel.getDiceData()); }
+}
+
 void UrController::onViewSubscribed(const std::string& subscriber) {
     mViewUpdated[subscriber] = false;
 }
@@ -69,17 +93,13 @@ std::unique_ptr<UrPlayerControls> UrController::createControls() {
 }
 
 void UrController::onLaunchPieceAttempted(PlayerID player, PieceIdentity piece, glm::u8vec2 launchLocation) {
+    const MoveToken moveToken { mModel.validateLaunch(piece, launchLocation, player) };
+    if(!moveToken.isValid()) return;
 
-    if(!mModel.canLaunchPieceTo(piece, launchLocation, player)) return;
-
-    const MoveResultData moveResults { mModel.getLaunchMoveData(piece, launchLocation) };
-    mModel.movePiece(piece, launchLocation, player);
-
-    if(moveResults.mDisplacedPiece.mIdentity.mOwner != RoleID::NA) {
-        mSigPlayerUpdated.emit(mModel.getPlayerData(moveResults.mDisplacedPiece.mIdentity.mOwner));
-    }
-
-    mSigPlayerUpdated.emit(mModel.getPlayerData(moveResults.mMovedPiece.mIdentity.mOwner));
+    const MoveResultData& moveResults { moveToken.mMoveResult };
+    const StateDelta stateDelta { mModel.movePiece(moveToken) };
+    mGameLog.recordMove(GameEvent::Type::LAUNCH, player, moveResults, mModel);
+    emitStateChanges(stateDelta);
     mSigMoveMade.emit(moveResults);
     mSigPhaseUpdated.emit(mModel.getCurrentPhase());
 
@@ -90,18 +110,13 @@ void UrController::onLaunchPieceAttempted(PlayerID player, PieceIdentity piece,
 }
 
 void UrController::onMoveBoardPieceAttempted(PlayerID player, PieceIdentity piece) {
-    if(!mModel.canMoveBoardPiece(piece, player)) return;
+    const MoveToken moveToken { mModel.validateBoardMove(piece, player) };
+    if(!moveToken.isValid()) return;
 
-    const MoveResultData moveResults { mModel.getBoardMoveData(piece) };
-    mModel.movePiece(piece, moveResults.mMovedPiece.mLocation, player);
-
-    if(moveResults.mDisplacedPiece.mIdentity.mOwner != RoleID::NA) {
-        mSigPlayerUpdated.emit(mModel.getPlayerData(moveResults.mDisplacedPiece.mIdentity.mOwner));
-    }
-    if(moveResults.mCountersLost || moveResults.mCountersWon) {
-        mSigScoreUpdated.emit(mModel.getScore());
-        mSigPlayerUpdated.emit(mModel.getPlayerData(moveResults.mMovedPiece.mIdentity.mOwner));
-    }
+    const MoveResultData& moveResults { moveToken.mMoveResult };
+    const StateDelta stateDelta { mModel.movePiece(moveToken) };
+    mGameLog.recordMove(GameEvent::Type::BOARD_MOVE, player, moveResults, mModel);
+    emitStateChanges(stateDelta);
     mSigMoveMade.emit(moveResults);
     mSigPhaseUpdated.emit(mModel.getCurrentPhase());
 
@@ -130,19 +145,15 @@ void UrController::onNextTurnAttempted(PlayerID player) {
         return;
     }
 
-    const bool canAdvanceOneTurn { mModel.canAdvanceOneTurn(player) };
-    if(canAdvanceOneTurn) { mModel.advanceOneTurn(player); }
-    else { mModel.startPhasePlay(); }
+    // starting the play phase assigns roles and collects stakes, which the
+    // state delta reports alongside the reset dice
+    const StateDelta stateDelta {
+        mModel.canAdvanceOneTurn(player)? mModel.advanceOneTurn(player): mModel.startPhasePlay()
+    };
+    mGameLog.recordNextTurn(player, mModel);
 
     mSigPhaseUpdated.emit(mModel.getCurrentPhase());
-    mSigDiceUpdated.emit(mModel.getDiceData());
-
-    // We've started the play phase; scores and player data must be updated
-    if(!canAdvanceOneTurn) {
-        mSigPlayerUpdated.emit(mModel.getPlayerData(PlayerID::PLAYER_A));
-        mSigPlayerUpdated.emit(mModel.getPlayerData(PlayerID::PLAYER_B));
-        mSigScoreUpdated.emit(mModel.getScore());
-    }
+    emitStateChanges(stateDelta);
 
     for(const auto& view: mViewUpdated) {
         mViewUpdated[view.first] = false;
@@ -153,8 +164,9 @@ void UrController::onNextTurnAttempted(PlayerID player) {
 void UrController::onDiceRollAttempted(PlayerID player) {
     if(!mModel.canRollDice(player)) { return; }
 
-    mModel.rollDice(player);
-    mSigDiceUpdated.emit(mModel.getDiceData());
+    const StateDelta stateDelta { mModel.rollDice(player) };
+    mGameLog.recordDiceRoll(player, mModel);
+    emitStateChanges(stateDelta);
     mSigPhaseUpdated.emit(mModel.getCurrentPhase());
 
     for(const auto& view: mViewUpdated) {
@@ -176,3 +188,22 @@ void UrPlayerControls::attemptMoveBoardPiece(PieceIdentity piece) {
 void UrPlayerControls::attemptNextTurn() {
     mUrController.onNextTurnAttempted(mPlayer);
 }
+void UrPlayerControls::attemptAction(const SearchAction& action) {
+    switch(action.mType) {
+        case SearchAction::Type::DICE_ROLL:
+            attemptDiceRoll();
+            return;
+        case SearchAction::Type::LAUNCH:
+            attemptLaunchPiece(action.mPiece.mType, action.mLocation);
+            return;
+        case SearchAction::Type::BOARD_MOVE:
+            attemptMoveBoardPiece(action.mPiece);
+            return;
+        case SearchAction::Type::NEXT_TURN:
+            attemptNextTurn();
+            return;
+        case SearchAction::Type::NONE:
+            break;
+    }
+    assert(false && "Only actual actions may be attempted");
+}
@@ -23,6 +23,8 @@
 #include <toymaker/engine/sim_system.hpp>
 
 #include "game_of_ur_data/model.hpp"
+#include "game_of_ur_data/game_log.hpp"
+#include "game_of_ur_data/search_action.hpp"
 
 class UrPlayerControls;
 
@@ -68,6 +70,13 @@ public:
      */
     inline const GameOfUrModel& getModel() const { return mModel; }
 
+    /**
+     * @brief Gets a const reference to the log of every action accepted by this object, from which earlier states of the game may be rebuilt.
+     * 
+     * @return const GameLog& A const reference to the game's log.
+     */
+    inline const GameLog& getGameLog() const { return mGameLog; }
+
     /**
      * @brief Creates an instance of UrPlayerControls, which exposes methods which allow (controlled) interaction with this aspect, corresponding with an ID known by the underlying data model.
      * 
@@ -85,6 +94,14 @@ private:
      */
     GameOfUrModel mModel {};
 
+    /**
+     * @brief The log of every action accepted by this object, starting from the model's initial state.
+     * 
+     * @warning Must be declared after mModel, from which it takes its first snapshot.
+     * 
+     */
+    GameLog mGameLog { mModel };
+
     /**
      * @brief The number of controls connected with this object created over its lifetime.
      * 
@@ -115,6 +132,14 @@ private:
      */
     bool viewUpdatesComplete() const;
 
+    /**
+     * @brief Broadcasts the score, player, and dice data touched by an action, as described by the state delta the model returned for it.
+     * 
+     * Data left untouched by the action is not broadcast again.
+     * 
+     * @param stateDelta The changes made by the action.
+     */
+    void emitStateChanges(const StateDelta& stateDelta);
 
     /**
      * @brief Adds a view which is interested in receiving information about events regarding changes in the state of the game.
@@ -279,6 +304,13 @@ public:
      */
     void attemptDiceRoll();
 
+    /**
+     * @brief Attempts an action chosen by a search, through whichever of the other attempt methods takes it.
+     * 
+     * @param action The action attempted, other than SearchAction::Type::NONE.
+     */
+    void attemptAction(const SearchAction& action);
+
     /**
      * @brief Gets a constant reference to the underlying data model used by UrController.
      * 
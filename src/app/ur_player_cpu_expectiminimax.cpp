@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#include "ur_player_cpu_expectiminimax.hpp"
+
+std::shared_ptr<ToyMaker::BaseSimObjectAspect> PlayerCPUExpectiminimax::create(const nlohmann::json& jsonAspectProperties) {
+    std::shared_ptr<PlayerCPUExpectiminimax> player { new PlayerCPUExpectiminimax{} };
+    player->mControllerPath = jsonAspectProperties.at("controller_path").get<std::string>();
+    double softSeconds { IterativeDeepening::kDefaultSoftSeconds };
+    if(jsonAspectProperties.contains("soft_ms")) {
+        softSeconds = jsonAspectProperties.at("soft_ms").get<double>() / 1000.0;
+        if(!std::isfinite(softSeconds) || softSeconds < 0.0) {
+            throw std::invalid_argument("The soft_ms of a CPU expectiminimax player must be a finite number no less than 0");
+        }
+    }
+    double hardSeconds { std::max(IterativeDeepening::kDefaultHardSeconds, softSeconds) };
+    if(jsonAspectProperties.contains("hard_ms")) {
+        hardSeconds = jsonAspectProperties.at("hard_ms").get<double>() / 1000.0;
+        if(!std::isfinite(hardSeconds) || hardSeconds < 0.0) {
+            throw std::invalid_argument("The hard_ms of a CPU expectiminimax player must be a finite number no less than 0");
+        }
+    }
+    if(hardSeconds < softSeconds) {
+        throw std::invalid_argument(
+            "The hard_ms of a CPU expectiminimax player must be no less than its soft_ms, here " + std::to_string(softSeconds * 1000.0)
+        );
+    }
+    uint8_t maxDepth { IterativeDeepening::kDefaultMaxDepth };
+    if(jsonAspectProperties.contains("max_depth")) {
+        // read wide, so that a depth out of range is refused rather than
+        // wrapped around
+        const nlohmann::json& maxDepthProperty { jsonAspectProperties.at("max_depth") };
+        if(!maxDepthProperty.is_number_integer() || maxDepthProperty.get<int64_t>() < 1 || maxDepthProperty.get<int64_t>() > UINT8_MAX) {
+            throw std::invalid_argument("The max_depth of a CPU expectiminimax player must be an integer from 1 to 255");
+        }
+        maxDepth = static_cast<uint8_t>(maxDepthProperty.get<int64_t>());
+    }
+    player->mDeepening = IterativeDeepening { softSeconds, hardSeconds, maxDepth };
+
+    double winWeight { Expectiminimax::kDefaultWinWeight };
+    if(jsonAspectProperties.contains("win_weight")) {
+        winWeight = jsonAspectProperties.at("win_weight").get<double>();
+        if(!(winWeight >= 0.0 && winWeight <= 1.0)) {
+            throw std::invalid_argument("The win_weight of a CPU expectiminimax player must lie between 0 and 1");
+        }
+    }
+    Expectiminimax::Pruning pruning { Expectiminimax::STAR2 };
+    if(jsonAspectProperties.contains("pruning")) {
+        const std::string pruningName { jsonAspectProperties.at("pruning").get<std::string>() };
+        if(pruningName == "none") {
+            pruning = Expectiminimax::NONE;
+        } else if(pruningName == "star1") {
+            pruning = Expectiminimax::STAR1;
+        } else if(pruningName != "star2") {
+            throw std::invalid_argument("Unknown chance node pruning algorithm \"" + pruningName + "\", expected one of \"none\", \"star1\", or \"star2\"");
+        }
+    }
+    player->mSearch = Expectiminimax { winWeight, pruning };
+    return player;
+}
+std::shared_ptr<ToyMaker::BaseSimObjectAspect> PlayerCPUExpectiminimax::clone() const  {
+    std::shared_ptr<PlayerCPUExpectiminimax> player { new PlayerCPUExpectiminimax{} };
+    player->mControllerPath = mControllerPath;
+    player->mSearch = Expectiminimax { mSearch.getWinWeight(), mSearch.getPruning() };
+    player->mDeepening = mDeepening;
+    return player;
+}
+
+void PlayerCPUExpectiminimax::onActivated() {
+    assert(!mControls && "We shouldn't have controls assigned yet");
+    mControls = (
+        ToyMaker::ECSWorld::getSingletonSystem<ToyMaker::SceneSystem>()
+            ->getByPath<UrController&>(mControllerPath + "@" + UrController::getSimObjectAspectTypeName()).createControls()
+    );
+    assert(mControls && "We should have controls assigned now");
+}
+
+void PlayerCPUExpectiminimax::onMovePrompted(GamePhaseData phaseData) {
+    // If it isn't our turn to take an action, do nothing
+    if(
+        phaseData.mGamePhase == GamePhase::END
+        || phaseData.mTurn != mControls->getPlayer()
+    ) {
+        return;
+    }
+
+    // We've reached the end of our turn, but the game continues.  Advance
+    // to the next turn
+    if(phaseData.mTurnPhase == TurnPhase::END) {
+        std::cout << "CPU: ends turn\n" << std::endl;
+        mControls->attemptNextTurn();
+        return;
+    }
+
+    const GameOfUrModel& urModel { mControls->getModel() };
+
+    // Before roles are assigned, and whenever there's only one thing we can
+    // do, there's nothing to search
+    const std::size_t nPossibleActions {
+        (urModel.canRollDice(mControls->getPlayer())? 1: 0)
+        + urModel.getAllPossibleMoves().size()
+        + (urModel.canAdvanceOneTurn(mControls->getPlayer())? 1: 0)
+    };
+    if(phaseData.mGamePhase == GamePhase::INITIATIVE || nPossibleActions <= 1) {
+        if(urModel.canRollDice(mControls->getPlayer())) {
+            std::cout << "CPU: rolls dice\n";
+            mControls->attemptDiceRoll();
+            return;
+        }
+        if(urModel.canAdvanceOneTurn(mControls->getPlayer())) {
+            std::cout << "CPU: ends turn\n" << std::endl;
+            mControls->attemptNextTurn();
+            return;
+        }
+        const MoveList possibleMoves { urModel.getAllPossibleMoves() };
+        assert(!possibleMoves.empty() && "We must have some action to take when prompted");
+        const bool isLaunch { urModel.getPieceData(possibleMoves[0].first).mState == Piece::State::UNLAUNCHED };
+        std::cout << "CPU: makes its only move\n";
+        mControls->attemptAction({
+            .mType { isLaunch? SearchAction::Type::LAUNCH: SearchAction::Type::BOARD_MOVE },
+            .mPiece { possibleMoves[0].first },
+            .mLocation { possibleMoves[0].second },
+        });
+        return;
+    }
+
+    const IterativeDeepeningResult result { mDeepening.search(mSearch, urModel) };
+    std::cout << "CPU: searched to depth " << static_cast<int>(result.mDepth) << ", " << result.mNodes << " nodes in "
+        << result.mSeconds * 1000.0 << "ms (" << result.getNodesPerSecond() << " nodes/s"
+        << (result.mExtended? ", extended": "") << (result.mAbandoned? ", last depth abandoned": "")
+        << "), valuing its choice at " << result.mValue << "\n";
+    mControls->attemptAction(result.mAction);
+}
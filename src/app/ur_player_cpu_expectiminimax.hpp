@@ -0,0 +1,83 @@
+/**
+ * @ingroup UrGameControlLayer
+ * @file ur_player_cpu_expectiminimax.hpp
+ * @author Zoheb Shujauddin (zoheb2424@gmail.com)
+ * @brief Contains the class definition of the CPU player controller that chooses its actions by expectiminimax search.
+ * @version 0.3.10
+ * @date 2026-10-16
+ * 
+ * 
+ */
+
+#ifndef ZOAPPPLAYERCPUEXPECTIMINIMAX_H
+#define ZOAPPPLAYERCPUEXPECTIMINIMAX_H
+
+#include <toymaker/engine/sim_system.hpp>
+
+#include "game_of_ur_data/expectiminimax.hpp"
+#include "game_of_ur_data/iterative_deepening.hpp"
+#include "ur_controller.hpp"
+
+/**
+ * @ingroup UrGameControlLayer
+ * @brief An aspect representing a computer controlled player of the game of ur, which makes its decisions by searching the game with Expectiminimax, as deeply as IterativeDeepening allows within a time budget.
+ * 
+ * Decisions are made within the frame that prompts them, and so the budget is kept well under a frame.  The search may be configured among its aspect properties: "soft_ms" and "hard_ms" set the soft and hard budgets of each decision in milliseconds, "max_depth" the most rolls of the dice looked ahead, "win_weight" the share of a game's value given to winning it over the counters held at its end, and "pruning" the chance node pruning algorithm, one of "none", "star1", or "star2".  A value out of range, a hard budget below the soft budget (each taken as its default when not given), or a pruning algorithm not listed, is refused with std::invalid_argument when the aspect is created.
+ * 
+ */
+class PlayerCPUExpectiminimax: public ToyMaker::SimObjectAspect<PlayerCPUExpectiminimax> {
+public:
+    PlayerCPUExpectiminimax(): SimObjectAspect<PlayerCPUExpectiminimax>{0} {}
+    inline static std::string getSimObjectAspectTypeName() { return "UrPlayerCPUExpectiminimax"; }
+    static std::shared_ptr<BaseSimObjectAspect> create(const nlohmann::json& jsonAspectProperties);
+    std::shared_ptr<BaseSimObjectAspect> clone() const override;
+
+private:
+    /**
+     * @brief The path to the game controller this player interfaces with.
+     * 
+     */
+    std::string mControllerPath {};
+
+    /**
+     * @brief The controls object created by the game controller.
+     * 
+     * Provides the interface through which this player is able to interact with the (data model representation of the) game.
+     * 
+     */
+    std::unique_ptr<UrPlayerControls> mControls {};
+
+    /**
+     * @brief The search choosing this player's actions.
+     * 
+     */
+    Expectiminimax mSearch {};
+
+    /**
+     * @brief The driver deepening the search until the budget of each decision runs out.
+     * 
+     */
+    IterativeDeepening mDeepening {};
+
+    /**
+     * @brief Broadcasts its existence to UrController and receives in exchange an instance of UrPlayerControls.
+     * 
+     */
+    void onActivated() override;
+
+    /**
+     * @brief Callback for an event from GameOfUrController, prompting this player for a new game-related action.
+     * 
+     * @param phaseData
+     */
+    void onMovePrompted(GamePhaseData phaseData);
+
+    /**
+     * @brief The observer connected with this aspect, responsible for receiving and responding to move prompt events.
+     * 
+     */
+    ToyMaker::SignalObserver<GamePhaseData> mObserveMovePrompted { *this, "MovePromptedObserved", [this](GamePhaseData phaseData) { this->onMovePrompted(phaseData); }};
+public:
+};
+
+#endif
@@ -5,11 +5,15 @@
 std::shared_ptr<ToyMaker::BaseSimObjectAspect> PlayerCPURandom::create(const nlohmann::json& jsonAspectProperties) {
     std::shared_ptr<PlayerCPURandom> player { new PlayerCPURandom{} };
     player->mControllerPath = jsonAspectProperties.at("controller_path").get<std::string>();
+    if(jsonAspectProperties.contains("seed")) {
+        player->mRandomEngine = RandomEngine { jsonAspectProperties.at("seed").get<uint64_t>() };
+    }
     return player;
 }
 std::shared_ptr<ToyMaker::BaseSimObjectAspect> PlayerCPURandom::clone() const  {
     std::shared_ptr<PlayerCPURandom> player { new PlayerCPURandom{} };
     player->mControllerPath = mControllerPath;
+    player->mRandomEngine = mRandomEngine;
     return player;
 }
 
@@ -46,13 +50,13 @@ void PlayerCPURandom::onMovePrompted(GamePhaseData phaseData) {
         urModel.canRollDice(mControls->getPlayer())
     };
     // can we move any of our pieces
-    const std::vector<std::pair<PieceIdentity, glm::u8vec2>> possibleMoves {
+    const MoveList possibleMoves {
         urModel.getAllPossibleMoves()
     };
 
     // select an action among all the actions available to us
     const std::size_t nPossibleActions { (canRollDice?1:0) + possibleMoves.size() };
-    const std::size_t selectedMoveIndex { std::uniform_int_distribution<std::size_t>{0, nPossibleActions - 1}(mRandomEngine) };
+    const std::size_t selectedMoveIndex { mRandomEngine.drawBelow(static_cast<uint32_t>(nPossibleActions)) };
 
     // We've decided to roll the dice
     if(selectedMoveIndex == 0 && canRollDice) {
@@ -62,7 +66,7 @@ void PlayerCPURandom::onMovePrompted(GamePhaseData phaseData) {
     }
 
     // We've opted to launch or move one of our pieces
-    const std::pair<PieceIdentity, glm::u8vec2>& selectedMove {
+    const MoveList::value_type& selectedMove {
         possibleMoves[selectedMoveIndex - (canRollDice? 1: 0)]
     };
     if(urModel.canLaunchPieceTo(selectedMove.first, selectedMove.second, mControls->getPlayer())) {
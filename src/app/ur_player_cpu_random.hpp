@@ -12,16 +12,17 @@
 #ifndef ZOAPPPLAYERCPURANDOM_H
 #define ZOAPPPLAYERCPURANDOM_H
 
-#include <random>
-
 #include <toymaker/engine/sim_system.hpp>
 
+#include "game_of_ur_data/random_engine.hpp"
 #include "ur_controller.hpp"
 
 /**
  * @ingroup UrGameControlLayer
  * @brief An aspect representing a computer controlled player of the game of ur, which makes its decisions completely randomly.
  * 
+ * Its decisions may be made reproducible by specifying a "seed" among its aspect properties.
+ * 
  */
 class PlayerCPURandom: public ToyMaker::SimObjectAspect<PlayerCPURandom> {
 public:
@@ -46,16 +47,10 @@ private:
     std::unique_ptr<UrPlayerControls> mControls {};
 
     /**
-     * @brief The device responsible for providing this class with random numbers.
-     * 
-     */
-    std::random_device mRandomDevice {};
-
-    /**
-     * @brief An engine using the random device.
+     * @brief The engine providing this class with random numbers.
      * 
      */
-    std::default_random_engine mRandomEngine { mRandomDevice() };
+    RandomEngine mRandomEngine { RandomEngine::fromProcessSeed() };
 
     /**
      * @brief Broadcasts its existence to UrController and receives in exchange an instance of UrPlayerControls.
@@ -0,0 +1,118 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "game_of_ur_data/differential_check.hpp"
+
+namespace {
+
+/**
+ * @brief A candidate engine which passes the whole of its state through a GameSnapshot after every action, so that anything the snapshot loses or garbles shows up as a divergence.
+ * 
+ */
+class SnapshotRoundTrip: public GameOfUrModel {
+public:
+    UndoRecord applyDiceOutcome(const Dice::Outcome& outcome) {
+        const UndoRecord undoRecord { GameOfUrModel::applyDiceOutcome(outcome) };
+        roundTrip();
+        return undoRecord;
+    }
+
+    UndoRecord applyMove(PieceIdentity piece, glm::u8vec2 toLocation) {
+        const UndoRecord undoRecord { GameOfUrModel::applyMove(piece, toLocation) };
+        roundTrip();
+        return undoRecord;
+    }
+
+    UndoRecord applyTurnAdvance() {
+        const UndoRecord undoRecord { GameOfUrModel::applyTurnAdvance() };
+        roundTrip();
+        return undoRecord;
+    }
+
+    StateDelta startPhasePlay() {
+        const StateDelta delta { GameOfUrModel::startPhasePlay() };
+        roundTrip();
+        return delta;
+    }
+
+private:
+    /**
+     * @brief Replaces this game with a new one restored from its snapshot, which is left at the start of a game should the snapshot be refused.
+     * 
+     */
+    void roundTrip() {
+        GameOfUrModel restored {};
+        restored.restoreSnapshot(getSnapshot());
+        static_cast<GameOfUrModel&>(*this) = restored;
+    }
+};
+
+/**
+ * @brief Prints the outcome of a run, returning whether the engines agreed throughout.
+ * 
+ */
+bool printReport(const std::string& name, const DifferentialReport& report) {
+    std::cout << name << ": " << report.mNGames << " games, " << report.mNActions << " actions\n";
+    if(!report.mDivergence) return true;
+
+    const GameDivergence& divergence { *report.mDivergence };
+    std::cerr << name << " diverges in game " << divergence.mSeed << " after " << divergence.mActions.size() << " actions: "
+        << divergence.mDescription << "\n";
+    for(const GameEvent& action: divergence.mActions) {
+        std::cerr << "    player " << static_cast<int>(action.mPlayer) << ": ";
+        switch(action.mType) {
+            case GameEvent::Type::DICE_ROLL:
+                std::cerr << "rolls " << static_cast<int>(action.mPrimaryRoll) << (action.mSecondaryRoll? "+": "-")
+                    << " for " << static_cast<int>(action.mResultScore) << "\n";
+                break;
+            case GameEvent::Type::LAUNCH:
+            case GameEvent::Type::BOARD_MOVE:
+                std::cerr << (action.mType == GameEvent::Type::LAUNCH? "launches ": "moves ") << kGamePieceTypes[action.mPiece.mType].mName
+                    << " to (" << static_cast<int>(action.mLocation.x) << ", " << static_cast<int>(action.mLocation.y) << ")\n";
+                break;
+            case GameEvent::Type::NEXT_TURN:
+                std::cerr << "ends the turn\n";
+                break;
+        }
+    }
+    return false;
+}
+
+}
+
+/**
+ * @brief Checks GameSnapshot, and every kernel of GameBatch the processor supports, against GameOfUrModel over a number of random games.
+ * 
+ * Usage: ur_differential_check [games] [first seed] [threads]
+ * 
+ */
+int main(int argc, char* argv[]) {
+    if(argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " [games] [first seed] [threads]\n";
+        return EXIT_FAILURE;
+    }
+    const long long nGames { argc > 1? std::atoll(argv[1]): 1000 };
+    const long long firstSeed { argc > 2? std::atoll(argv[2]): 0 };
+    const int nThreads { argc > 3? std::atoi(argv[3]): static_cast<int>(std::thread::hardware_concurrency()) };
+    if(nGames < 1 || firstSeed < 0 || nThreads < 1) {
+        std::cerr << "At least one game must be played, from a seed no less than 0, on at least one thread\n";
+        return EXIT_FAILURE;
+    }
+
+    bool agrees {
+        printReport("Snapshot round trip", DifferentialCheck::run<SnapshotRoundTrip>(nGames, firstSeed, static_cast<unsigned>(nThreads)))
+    };
+    const GameBatch::Kernel bestKernel { GameBatch::getBestKernel() };
+    for(const GameBatch::Kernel kernel: { GameBatch::Kernel::SCALAR, GameBatch::Kernel::SSE, GameBatch::Kernel::AVX2 }) {
+        if(kernel > bestKernel) break;
+        const std::string name {
+            kernel == GameBatch::Kernel::SCALAR? "Scalar batch":
+            kernel == GameBatch::Kernel::SSE? "SSE batch":
+            "AVX2 batch"
+        };
+        agrees = printReport(name, DifferentialCheck::runBatch(nGames, firstSeed, kernel)) && agrees;
+    }
+    return agrees? EXIT_SUCCESS: EXIT_FAILURE;
+}
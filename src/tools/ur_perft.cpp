@@ -0,0 +1,41 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "game_of_ur_data/perft.hpp"
+
+/**
+ * @brief Checks the counts from every standard position against the reference counts up to some depth, and times the deepest count.
+ * 
+ * Usage: ur_perft [depth]
+ * 
+ */
+int main(int argc, char* argv[]) {
+    if(argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [depth]\n";
+        return EXIT_FAILURE;
+    }
+    const int depth { argc > 1? std::atoi(argv[1]): 14 };
+    if(depth < 0 || depth > Perft::kMaxReferenceDepth) {
+        std::cerr << "The depth must lie between 0 and " << static_cast<int>(Perft::kMaxReferenceDepth) << "\n";
+        return EXIT_FAILURE;
+    }
+
+    bool matches { true };
+    for(uint8_t startPosition { 0 }; startPosition < Perft::StartPosition::TOTAL; ++startPosition) {
+        const char* const name { startPosition == Perft::GAME_START? "game start": "play start" };
+        for(uint8_t checkedDepth { 0 }; checkedDepth <= depth; ++checkedDepth) {
+            if(!Perft::matchesReference(static_cast<Perft::StartPosition>(startPosition), checkedDepth)) {
+                std::cerr << "From the " << name << ", the count at depth " << static_cast<int>(checkedDepth) << " differs from "
+                    << Perft::kReferenceCounts[startPosition][checkedDepth] << "\n";
+                matches = false;
+            }
+        }
+
+        const PerftResult result {
+            Perft::run(Perft::makeStartPosition(static_cast<Perft::StartPosition>(startPosition)), static_cast<uint8_t>(depth))
+        };
+        std::cout << "From the " << name << ", depth " << depth << ": " << result.mNodes << " leaves, " << result.mNodesVisited
+            << " states visited in " << result.mSeconds * 1000.0 << "ms (" << result.getNodesPerSecond() << " nodes/s)\n";
+    }
+    return matches? EXIT_SUCCESS: EXIT_FAILURE;
+}
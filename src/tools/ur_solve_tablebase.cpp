@@ -0,0 +1,108 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "game_of_ur_data/endgame_index.hpp"
+#include "game_of_ur_data/position_index.hpp"
+#include "game_of_ur_data/solver.hpp"
+#include "game_of_ur_data/tablebase.hpp"
+
+namespace {
+
+/**
+ * @brief Gets the position, with black to move, whose slots are those given.
+ * 
+ */
+GamePosition getPosition(const EndgameIndex::Slots& slots) {
+    GamePosition position {};
+    for(uint8_t side { 0 }; side < 2; ++side) {
+        for(uint8_t type { 0 }; type < PieceTypeID::TOTAL; ++type) {
+            const uint8_t slot { slots[side][type] };
+            position.mPieces[side][type] = {
+                .mState {
+                    slot == EndgameIndex::kUnlaunchedSlot? Piece::State::UNLAUNCHED:
+                    slot == EndgameIndex::kFinishedSlot? Piece::State::FINISHED:
+                    Piece::State::ON_BOARD
+                },
+                .mRoutePosition { static_cast<uint8_t>(slot == EndgameIndex::kUnlaunchedSlot || slot == EndgameIndex::kFinishedSlot? 0: slot - 1u) },
+            };
+        }
+    }
+    return position;
+}
+
+}
+
+/**
+ * @brief Solves the endgame table, writes it to a tablebase file, and checks that the file reads back every position's value.
+ * 
+ * Usage: ur_solve_tablebase <path> [max pieces left] [win weight] [counter step] [threads]
+ * 
+ */
+int main(int argc, char* argv[]) {
+    if(argc < 2 || argc > 6) {
+        std::cerr << "Usage: " << argv[0] << " <path> [max pieces left] [win weight] [counter step] [threads]\n";
+        return EXIT_FAILURE;
+    }
+    const std::string path { argv[1] };
+    const int maxPiecesLeft { argc > 2? std::atoi(argv[2]): Solver::kDefaultMaxPiecesLeft };
+    const double winWeight { argc > 3? std::atof(argv[3]): 1.0 };
+    const int counterStep { argc > 4? std::atoi(argv[4]): 1 };
+    const int nThreads { argc > 5? std::atoi(argv[5]): static_cast<int>(std::thread::hardware_concurrency()) };
+    if(
+        maxPiecesLeft < 1 || maxPiecesLeft > PieceTypeID::TOTAL
+        || !(winWeight >= 0.0 && winWeight <= 1.0)
+        || counterStep < 1 || counterStep > Solver::kTotalCounters || Solver::kTotalCounters % counterStep != 0
+        || nThreads < 1
+    ) {
+        std::cerr << "Pieces left must lie between 1 and " << static_cast<int>(PieceTypeID::TOTAL)
+            << ", the win weight between 0 and 1, the counter step must divide " << static_cast<int>(Solver::kTotalCounters)
+            << ", and at least one thread must run\n";
+        return EXIT_FAILURE;
+    }
+
+    Solver solver { static_cast<uint8_t>(maxPiecesLeft), winWeight, static_cast<uint8_t>(counterStep) };
+    const SolverResult result { solver.solve(static_cast<unsigned>(nThreads)) };
+    std::cout << "Solved " << result.mNPositions << " values in " << result.mNSweeps << " sweeps and " << result.mSeconds << "s ("
+        << result.getPositionsPerSecond() << " positions/s), holding " << result.mMemoryBytes << " bytes\n";
+    if(!result.mConverged) {
+        std::cerr << "The table didn't converge, its values still changing by up to " << result.mMaxDelta << " a sweep\n";
+        return EXIT_FAILURE;
+    }
+
+    if(!Tablebase::write(solver, path)) {
+        std::cerr << "Couldn't write " << path << "\n";
+        return EXIT_FAILURE;
+    }
+    Tablebase tablebase {};
+    if(!tablebase.open(path)) {
+        std::cerr << "Couldn't read back " << path << "\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << tablebase.getFileBytes() << " bytes to " << path << "\n";
+
+    // values are rounded to the nearest step of the quantization when stored,
+    // and counter levels are blended alike on either side
+    const double tolerance { 1.0 / Tablebase::kQuantizedOne };
+    const EndgameIndex& index { solver.getIndex() };
+    uint64_t nMismatches { 0 };
+    for(uint64_t entry { 0 }; entry < index.getSize(); ++entry) {
+        const GamePosition position { getPosition(index.unrank(entry)) };
+        for(uint8_t ownCounters { 0 }; ownCounters <= (solver.tracksCounters()? Solver::kTotalCounters: 0); ownCounters += counterStep) {
+            const uint8_t otherCounters { static_cast<uint8_t>(solver.tracksCounters()? Solver::kTotalCounters - ownCounters: 0) };
+            const std::optional<double> stored { tablebase.getValue(position, ownCounters, otherCounters) };
+            if(!stored || std::abs(*stored - solver.getValue(position, ownCounters, otherCounters)) > tolerance) {
+                ++nMismatches;
+            }
+        }
+    }
+    if(nMismatches > 0) {
+        std::cerr << nMismatches << " values read back differ from those solved\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "Every value read back matches the solver's\n";
+    return EXIT_SUCCESS;
+}